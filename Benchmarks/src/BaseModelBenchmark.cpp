@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include "GLContext.h"
+#include "PlaneModel.h"
+
+namespace
+{
+	//Spread the models out with different rotations, so no two model matrices are the same
+	void PlaceModel(BaseModel& model, int64_t index)
+	{
+		float offset = static_cast<float>(index);
+		model.setPosition(glm::vec3(offset, 0.0f, -offset));
+		model.setRotation(glm::vec3(offset * 7.0f, offset * 13.0f, offset * 29.0f));
+		model.setScale(glm::vec3(1.0f + offset * 0.01f));
+	}
+}
+
+//Compose the model matrices the way BaseModel::Draw does, without any OpenGL calls
+//Separates the math from the driver overhead measured by BM_BaseModel_Draw
+static void BM_BaseModel_ComposeMatrix(benchmark::State& state)
+{
+	struct Transform
+	{
+		glm::vec3 position;
+		glm::vec3 rotation;
+		glm::vec3 scale;
+	};
+
+	std::vector<Transform> transforms(state.range(0));
+	for (size_t i = 0; i < transforms.size(); i++)
+	{
+		float offset = static_cast<float>(i);
+		transforms[i] = { glm::vec3(offset, 0.0f, -offset), glm::vec3(offset * 7.0f, offset * 13.0f, offset * 29.0f), glm::vec3(1.0f + offset * 0.01f) };
+	}
+
+	for (auto _ : state)
+	{
+		for (const Transform& transform : transforms)
+		{
+			glm::mat4 model = glm::translate(glm::mat4(1.0f), transform.position);
+			model = glm::rotate(model, glm::radians(transform.rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+			model = glm::rotate(model, glm::radians(transform.rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+			model = glm::rotate(model, glm::radians(transform.rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+			model = glm::scale(model, transform.scale);
+			benchmark::DoNotOptimize(model);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BaseModel_ComposeMatrix)->Arg(1024);
+
+//Draw a frame worth of textured planes through BaseModel::Draw, the argument is the number of models
+//Only the CPU side of the submission is timed, the GPU is drained outside of the measurement after every frame
+static void BM_BaseModel_Draw(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	//All planes share the texture files, every plane still uploads its own copy like in the Playground
+	std::vector<PlaneModel> models;
+	models.reserve(state.range(0));
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		models.emplace_back("assets/metal.png", "assets/metal.png");
+		PlaceModel(models.back(), i);
+	}
+
+	//Render into a tiny framebuffer so the fragment work doesn't dominate
+	glViewport(0, 0, 1, 1);
+
+	for (auto _ : state)
+	{
+		for (const PlaneModel& model : models)
+		{
+			model.Draw(*shader);
+		}
+
+		state.PauseTiming();
+		glFinish();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BaseModel_Draw)->Arg(64)->Arg(256);
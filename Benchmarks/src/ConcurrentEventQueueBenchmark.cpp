@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <KJK_Engine/Events/ConcurrentEventQueue.h>
+#include <KJK_Engine/Events/KeyEvent.h>
+
+#include <thread>
+
+namespace
+{
+	//Number of events every producer posts per iteration
+	constexpr int s_EventsPerIteration = 1024;
+	//Highest number of producer threads the stress benchmark runs with
+	constexpr int s_MaxProducers = 15;
+
+	//Queue shared by all threads of the stress benchmark, small so producers regularly hit backpressure
+	KJK::ConcurrentEventQueue s_StressQueue(1024);
+	//Next expected sequence number per producer, only touched by the consumer
+	int s_ExpectedSequence[s_MaxProducers + 1];
+	//Next sequence number per producer, only touched by the producer itself
+	int s_NextSequence[s_MaxProducers + 1];
+}
+
+//Multi-producer stress benchmark, thread 0 drains the queue while all other threads post events
+//The consumer validates that no event is lost or duplicated and that every producer's events arrive in order
+static void BM_ConcurrentEventQueue_Stress(benchmark::State& state)
+{
+	int producerCount = state.threads() - 1;
+	bool isConsumer = state.thread_index() == 0;
+
+	//The loop start is a barrier for all threads, so this reset happens before any producer posts
+	if (isConsumer)
+	{
+		for (int i = 0; i <= s_MaxProducers; i++)
+		{
+			s_ExpectedSequence[i] = 0;
+			s_NextSequence[i] = 0;
+		}
+	}
+
+	int64_t errors = 0;
+	int64_t received = 0;
+	int64_t retries = 0;
+
+	for (auto _ : state)
+	{
+		if (isConsumer)
+		{
+			//Drain exactly the events the producers post during this iteration
+			int64_t target = received + static_cast<int64_t>(producerCount) * s_EventsPerIteration;
+			while (received < target)
+			{
+				uint32_t processed = s_StressQueue.Flush([&errors](KJK::Event& event)
+				{
+					//The key code carries the sequence number and the repeat count the producer index
+					auto& keyEvent = static_cast<KJK::KeyPressedEvent&>(event);
+					int producer = keyEvent.GetRepeatCount();
+					if (keyEvent.GetKeyCode() != s_ExpectedSequence[producer])
+						errors++;
+					s_ExpectedSequence[producer] = keyEvent.GetKeyCode() + 1;
+				});
+
+				received += processed;
+				if (processed == 0)
+					std::this_thread::yield();
+			}
+		}
+		else
+		{
+			int producer = state.thread_index();
+			for (int i = 0; i < s_EventsPerIteration; i++)
+			{
+				//Retry until the consumer makes room, counting every rejected push
+				while (!s_StressQueue.Emplace<KJK::KeyPressedEvent>(s_NextSequence[producer], producer))
+				{
+					retries++;
+					std::this_thread::yield();
+				}
+				s_NextSequence[producer]++;
+			}
+		}
+	}
+
+	if (isConsumer)
+	{
+		int64_t expected = static_cast<int64_t>(state.iterations()) * producerCount * s_EventsPerIteration;
+		if (errors != 0 || received != expected || s_StressQueue.GetSize() != 0)
+			state.SkipWithError("Concurrent event queue lost, duplicated or reordered events");
+
+		state.SetItemsProcessed(received);
+	}
+	else
+	{
+		state.counters["Retries"] = benchmark::Counter(static_cast<double>(retries), benchmark::Counter::kAvgThreads);
+	}
+}
+BENCHMARK(BM_ConcurrentEventQueue_Stress)->ThreadRange(2, s_MaxProducers + 1)->UseRealTime();
+
+//Single threaded push and flush cost, comparable to the EventQueue benchmarks
+static void BM_ConcurrentEventQueue_SingleThread(benchmark::State& state)
+{
+	KJK::ConcurrentEventQueue queue;
+	int64_t eventCount = state.range(0);
+	int64_t sum = 0;
+
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < eventCount; i++)
+		{
+			queue.Emplace<KJK::KeyPressedEvent>(static_cast<int>(i), 0);
+		}
+
+		queue.Flush([&sum](KJK::Event& event) { sum += static_cast<KJK::KeyPressedEvent&>(event).GetKeyCode(); });
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * eventCount);
+}
+BENCHMARK(BM_ConcurrentEventQueue_SingleThread)->Arg(256)->Arg(1024);
@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <KJK_Engine/Events/ApplicationEvent.h>
+#include <KJK_Engine/Events/EventQueue.h>
+#include <KJK_Engine/Events/KeyEvent.h>
+#include <KJK_Engine/Events/MouseEvent.h>
+
+namespace
+{
+	//Copy of the original dispatcher, kept as the baseline for the comparison
+	//It can't write the protected handled flag, so the result is returned instead
+	class VirtualEventDispatcher
+	{
+		template<typename T>
+		using EventFn = std::function<bool(T&)>;
+	public:
+		VirtualEventDispatcher(KJK::Event& event)
+			: m_Event(event) {}
+
+		//Dispatch the event to the correct event function if the types match
+		template<typename T>
+		bool Dispatch(EventFn<T> func)
+		{
+			if (m_Event.GetEventType() == T::GetStaticType())
+			{
+				m_Handled = func(*(T*)&m_Event);
+				return true;
+			}
+			return false;
+		}
+	private:
+		KJK::Event& m_Event;
+		bool m_Handled = false;
+	};
+
+	//Number of events per benchmark iteration
+	constexpr int s_EventCount = 1024;
+
+	//Fill a queue with a typical input mix, mostly mouse movement
+	void FillQueue(KJK::EventQueue& queue)
+	{
+		for (int i = 0; i < s_EventCount; i++)
+		{
+			switch (i % 8)
+			{
+			case 0: queue.Emplace<KJK::KeyPressedEvent>(i, 0); break;
+			case 1: queue.Emplace<KJK::WindowResizeEvent>(1280, 720); break;
+			default: queue.Emplace<KJK::MouseMovedEvent>(static_cast<float>(i), 1.0f); break;
+			}
+		}
+	}
+}
+
+//Route every event through three handlers with the original dispatcher, like an OnEvent function would
+static void BM_VirtualEventDispatcher(benchmark::State& state)
+{
+	KJK::EventQueue queue;
+	FillQueue(queue);
+	float sum = 0.0f;
+
+	for (auto _ : state)
+	{
+		queue.ForEach([&sum](KJK::Event& event)
+		{
+			VirtualEventDispatcher dispatcher(event);
+			dispatcher.Dispatch<KJK::MouseMovedEvent>([&sum](KJK::MouseMovedEvent& e) { sum += e.GetX(); return false; });
+			dispatcher.Dispatch<KJK::KeyPressedEvent>([&sum](KJK::KeyPressedEvent& e) { sum += static_cast<float>(e.GetKeyCode()); return true; });
+			dispatcher.Dispatch<KJK::WindowResizeEvent>([&sum](KJK::WindowResizeEvent& e) { sum += static_cast<float>(e.GetWidth()); return false; });
+		});
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * s_EventCount);
+}
+BENCHMARK(BM_VirtualEventDispatcher);
+
+//Route every event through three handlers with the template dispatcher
+static void BM_EventDispatcher(benchmark::State& state)
+{
+	KJK::EventQueue queue;
+	FillQueue(queue);
+	float sum = 0.0f;
+
+	for (auto _ : state)
+	{
+		queue.ForEach([&sum](KJK::Event& event)
+		{
+			KJK::EventDispatcher dispatcher(event);
+			dispatcher.Dispatch<KJK::MouseMovedEvent>([&sum](KJK::MouseMovedEvent& e) { sum += e.GetX(); return false; });
+			dispatcher.Dispatch<KJK::KeyPressedEvent>([&sum](KJK::KeyPressedEvent& e) { sum += static_cast<float>(e.GetKeyCode()); return true; });
+			dispatcher.Dispatch<KJK::WindowResizeEvent>([&sum](KJK::WindowResizeEvent& e) { sum += static_cast<float>(e.GetWidth()); return false; });
+		});
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * s_EventCount);
+}
+BENCHMARK(BM_EventDispatcher);
+
+//Dispatch all queued events of one type at a time in a tight loop per type
+//Every pass walks the whole queue, so batching pays off when only a few event types are handled
+static void BM_EventDispatcher_Batch(benchmark::State& state)
+{
+	KJK::EventQueue queue;
+	FillQueue(queue);
+	float sum = 0.0f;
+
+	for (auto _ : state)
+	{
+		queue.Dispatch<KJK::MouseMovedEvent>([&sum](KJK::MouseMovedEvent& e) { sum += e.GetX(); return false; });
+		queue.Dispatch<KJK::KeyPressedEvent>([&sum](KJK::KeyPressedEvent& e) { sum += static_cast<float>(e.GetKeyCode()); return true; });
+		queue.Dispatch<KJK::WindowResizeEvent>([&sum](KJK::WindowResizeEvent& e) { sum += static_cast<float>(e.GetWidth()); return false; });
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * s_EventCount);
+}
+BENCHMARK(BM_EventDispatcher_Batch);
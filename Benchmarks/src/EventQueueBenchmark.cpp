@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+
+#include <KJK_Engine/Events/EventQueue.h>
+#include <KJK_Engine/Events/KeyEvent.h>
+#include <KJK_Engine/Events/MouseEvent.h>
+
+namespace
+{
+	//Copy of the original heap based event queue, kept as the baseline for the comparison
+	class HeapEventQueue
+	{
+	public:
+		//Add an event to the queue
+		void Push(std::unique_ptr<KJK::Event> event)
+		{
+			m_Buffer.push_back(std::move(event));
+		}
+
+		//Process all events in the buffer with a callback function
+		void Flush(const std::function<void(KJK::Event&)>& callback)
+		{
+			for (auto& eventPtr : m_Buffer)
+			{
+				if (eventPtr)
+				{
+					callback(*eventPtr);
+				}
+			}
+			//Clear the buffer after processing
+			m_Buffer.clear();
+		}
+	private:
+		std::vector<std::unique_ptr<KJK::Event>> m_Buffer;
+	};
+
+	//Read the payload of an event so the work can't be optimized away
+	inline void ConsumeEvent(KJK::Event& event, float& sum)
+	{
+		if (event.GetEventType() == KJK::EventType::MouseMoved)
+			sum += static_cast<KJK::MouseMovedEvent&>(event).GetX();
+		else
+			sum += 1.0f;
+	}
+}
+
+//Push a frame worth of mouse moved events and flush them through the original queue
+static void BM_HeapEventQueue_MouseMoved(benchmark::State& state)
+{
+	HeapEventQueue queue;
+	int64_t eventCount = state.range(0);
+	float sum = 0.0f;
+
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < eventCount; i++)
+		{
+			queue.Push(std::make_unique<KJK::MouseMovedEvent>(static_cast<float>(i), 1.0f));
+		}
+
+		queue.Flush([&sum](KJK::Event& event) { ConsumeEvent(event, sum); });
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * eventCount);
+}
+BENCHMARK(BM_HeapEventQueue_MouseMoved)->Arg(16)->Arg(256)->Arg(1024);
+
+//Push a frame worth of mouse moved events and flush them through the ring buffer queue
+static void BM_EventQueue_MouseMoved(benchmark::State& state)
+{
+	KJK::EventQueue queue;
+	int64_t eventCount = state.range(0);
+	float sum = 0.0f;
+
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < eventCount; i++)
+		{
+			queue.Emplace<KJK::MouseMovedEvent>(static_cast<float>(i), 1.0f);
+		}
+
+		queue.Flush([&sum](KJK::Event& event) { ConsumeEvent(event, sum); });
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * eventCount);
+}
+BENCHMARK(BM_EventQueue_MouseMoved)->Arg(16)->Arg(256)->Arg(1024);
+
+//Push a mix of differently sized events through the original queue
+static void BM_HeapEventQueue_Mixed(benchmark::State& state)
+{
+	HeapEventQueue queue;
+	int64_t eventCount = state.range(0);
+	float sum = 0.0f;
+
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < eventCount; i++)
+		{
+			switch (i % 3)
+			{
+			case 0: queue.Push(std::make_unique<KJK::MouseMovedEvent>(static_cast<float>(i), 1.0f)); break;
+			case 1: queue.Push(std::make_unique<KJK::KeyPressedEvent>(static_cast<int>(i), 0)); break;
+			case 2: queue.Push(std::make_unique<KJK::MouseButtonPressedEvent>(1)); break;
+			}
+		}
+
+		queue.Flush([&sum](KJK::Event& event) { ConsumeEvent(event, sum); });
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * eventCount);
+}
+BENCHMARK(BM_HeapEventQueue_Mixed)->Arg(256);
+
+//Push a mix of differently sized events through the ring buffer queue
+static void BM_EventQueue_Mixed(benchmark::State& state)
+{
+	KJK::EventQueue queue;
+	int64_t eventCount = state.range(0);
+	float sum = 0.0f;
+
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < eventCount; i++)
+		{
+			switch (i % 3)
+			{
+			case 0: queue.Emplace<KJK::MouseMovedEvent>(static_cast<float>(i), 1.0f); break;
+			case 1: queue.Emplace<KJK::KeyPressedEvent>(static_cast<int>(i), 0); break;
+			case 2: queue.Emplace<KJK::MouseButtonPressedEvent>(1); break;
+			}
+		}
+
+		queue.Flush([&sum](KJK::Event& event) { ConsumeEvent(event, sum); });
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * eventCount);
+}
+BENCHMARK(BM_EventQueue_Mixed)->Arg(256);
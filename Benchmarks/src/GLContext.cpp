@@ -0,0 +1,108 @@
+#include "GLContext.h"
+
+#include <KJK_Engine/Core/Logger.h>
+#include <KJK_Engine/Renderer/GLStateCache.h>
+
+namespace
+{
+	SDL_Window* s_Window = nullptr;
+	SDL_GLContext s_Context = nullptr;
+	//Only try once, a failed context skips every OpenGL benchmark instead of retrying
+	bool s_Attempted = false;
+
+	//Create the hidden window with its context and load the OpenGL functions
+	bool CreateContext()
+	{
+		if (!SDL_Init(SDL_INIT_VIDEO))
+		{
+			KJK_ERROR("Failed to initialize SDL: {0}", SDL_GetError());
+			return false;
+		}
+
+		//Use the same context version as the Playground
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 5);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+
+		s_Window = SDL_CreateWindow("KJK Benchmarks", 64, 64, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+		if (s_Window == nullptr)
+		{
+			KJK_ERROR("Failed to create the benchmark window: {0}", SDL_GetError());
+			return false;
+		}
+
+		s_Context = SDL_GL_CreateContext(s_Window);
+		if (s_Context == nullptr)
+		{
+			KJK_ERROR("Failed to create the benchmark OpenGL context: {0}", SDL_GetError());
+			return false;
+		}
+
+		if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress))
+		{
+			KJK_ERROR("Failed to initialize GLAD!");
+			SDL_GL_DestroyContext(s_Context);
+			s_Context = nullptr;
+			return false;
+		}
+
+		//The Playground classes bind through the state cache, start it out knowing nothing about the new context
+		KJK::GLStateCache::Init();
+
+		KJK_INFO("Benchmarking on {0}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+		return true;
+	}
+}
+
+bool AcquireGLContext(benchmark::State& state)
+{
+	if (!s_Attempted)
+	{
+		s_Attempted = true;
+		CreateContext();
+	}
+
+	if (s_Context == nullptr)
+	{
+		state.SkipWithError("No OpenGL context");
+		return false;
+	}
+	return true;
+}
+
+void ReleaseGLContext()
+{
+	if (s_Context != nullptr)
+	{
+		SDL_GL_DestroyContext(s_Context);
+		s_Context = nullptr;
+	}
+	if (s_Window != nullptr)
+	{
+		SDL_DestroyWindow(s_Window);
+		s_Window = nullptr;
+	}
+	if (s_Attempted)
+		SDL_Quit();
+}
+
+std::optional<Shader> LoadModelShader(benchmark::State& state)
+{
+	if (!AcquireGLContext(state))
+		return std::nullopt;
+
+	//The paths are relative like in the Playground, the assets are copied next to the benchmark executable
+	std::optional<Shader> shader;
+	shader.emplace("assets/shaders/shader.vert", "assets/shaders/shader2.frag");
+
+	GLint linked = GL_FALSE;
+	glGetProgramiv(shader->ID, GL_LINK_STATUS, &linked);
+	if (linked != GL_TRUE)
+	{
+		state.SkipWithError("Failed to build the model shader, run the benchmarks from the directory with the assets");
+		return std::nullopt;
+	}
+
+	shader->Use();
+	return shader;
+}
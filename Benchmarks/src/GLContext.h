@@ -0,0 +1,18 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "Shader.h"
+
+#include <optional>
+
+//OpenGL 4.5 core context on a hidden SDL window, shared by all benchmarks that submit OpenGL calls
+//The context is created on first use and stays current on the main thread, which runs the benchmarks
+
+//Create the context if it doesn't exist yet, returns false and skips the benchmark if it couldn't be created
+bool AcquireGLContext(benchmark::State& state);
+//Destroy the context and the window, called once after all benchmarks ran
+void ReleaseGLContext();
+
+//Build the lit model shader of the Playground and make it current, returns nothing and skips the benchmark on failure
+std::optional<Shader> LoadModelShader(benchmark::State& state);
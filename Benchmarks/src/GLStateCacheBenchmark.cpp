@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include "GLContext.h"
+
+#include <KJK_Engine/Renderer/GLStateCache.h>
+
+namespace
+{
+	//Number of draws per benchmark iteration, each setting the state a textured draw of the Playground sets
+	constexpr int s_DrawCount = 256;
+}
+
+//Set the state of a frame worth of draws sharing one program, vertex array and pair of textures
+//The argument selects direct OpenGL calls that reset the texture unit and vertex array after every draw (0)
+//or calls through the state cache (1), which skips all but the first draw's calls
+//Only the CPU side of the submission is timed, the GPU is drained outside of the measurement after every frame
+static void BM_GLStateCache_RedundantState(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	GLuint vertexArray = 0;
+	glGenVertexArrays(1, &vertexArray);
+	GLuint textures[2] = {};
+	glGenTextures(2, textures);
+
+	bool cached = state.range(0) != 0;
+	KJK::GLStateCache::Invalidate();
+	uint64_t filteredBefore = KJK::GLStateCache::GetStats().Filtered;
+
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_DrawCount; i++)
+		{
+			if (cached)
+			{
+				KJK::GLStateCache::UseProgram(shader->ID);
+				KJK::GLStateCache::Enable(GL_DEPTH_TEST);
+				KJK::GLStateCache::Enable(GL_CULL_FACE);
+				KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, textures[0]);
+				KJK::GLStateCache::BindTexture(1, GL_TEXTURE_2D, textures[1]);
+				KJK::GLStateCache::BindVertexArray(vertexArray);
+			}
+			else
+			{
+				glUseProgram(shader->ID);
+				glEnable(GL_DEPTH_TEST);
+				glEnable(GL_CULL_FACE);
+				glActiveTexture(GL_TEXTURE0);
+				glBindTexture(GL_TEXTURE_2D, textures[0]);
+				glActiveTexture(GL_TEXTURE1);
+				glBindTexture(GL_TEXTURE_2D, textures[1]);
+				glActiveTexture(GL_TEXTURE0);
+				glBindVertexArray(vertexArray);
+				glBindVertexArray(0);
+			}
+		}
+
+		state.PauseTiming();
+		glFinish();
+		state.ResumeTiming();
+	}
+
+	state.counters["Filtered"] = benchmark::Counter(static_cast<double>(KJK::GLStateCache::GetStats().Filtered - filteredBefore), benchmark::Counter::kAvgIterations);
+	state.SetItemsProcessed(state.iterations() * s_DrawCount);
+
+	//The direct calls bypassed the cache, so it can't trust what it knows anymore
+	KJK::GLStateCache::DeleteVertexArray(vertexArray);
+	KJK::GLStateCache::DeleteTexture(textures[0]);
+	KJK::GLStateCache::DeleteTexture(textures[1]);
+	KJK::GLStateCache::Invalidate();
+}
+BENCHMARK(BM_GLStateCache_RedundantState)->Arg(0)->Arg(1);
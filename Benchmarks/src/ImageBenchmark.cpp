@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+	//Read a whole file, so decoding is measured without the disk
+	std::vector<char> ReadFile(const char* path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	//Decode an image from memory, the stream is closed by SDL_image
+	SDL_Surface* DecodeImage(const std::vector<char>& data)
+	{
+		return IMG_Load_IO(SDL_IOFromConstMem(data.data(), data.size()), true);
+	}
+}
+
+//Decode an image file held in memory, like IMG_Load does after reading the file
+static void BM_Image_Decode(benchmark::State& state, const char* path)
+{
+	std::vector<char> data = ReadFile(path);
+	if (data.empty())
+	{
+		state.SkipWithError("Failed to read the image, run the benchmarks from the directory with the assets");
+		return;
+	}
+
+	int64_t pixels = 0;
+	for (auto _ : state)
+	{
+		SDL_Surface* surface = DecodeImage(data);
+		if (surface == nullptr)
+		{
+			state.SkipWithError(SDL_GetError());
+			break;
+		}
+		pixels += static_cast<int64_t>(surface->w) * surface->h;
+		SDL_DestroySurface(surface);
+	}
+
+	state.SetItemsProcessed(pixels);
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK_CAPTURE(BM_Image_Decode, jpg, "assets/container.jpg")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Image_Decode, png, "assets/container2.png")->Unit(benchmark::kMillisecond);
+
+//Convert a decoded image to the RGBA byte order the textures are uploaded with
+static void BM_Image_ConvertSurface(benchmark::State& state, const char* path)
+{
+	SDL_Surface* surface = DecodeImage(ReadFile(path));
+	if (surface == nullptr)
+	{
+		state.SkipWithError("Failed to load the image, run the benchmarks from the directory with the assets");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		SDL_Surface* formattedSurface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ABGR8888);
+		benchmark::DoNotOptimize(formattedSurface);
+		SDL_DestroySurface(formattedSurface);
+	}
+
+	state.SetItemsProcessed(state.iterations() * surface->w * surface->h);
+	SDL_DestroySurface(surface);
+}
+BENCHMARK_CAPTURE(BM_Image_ConvertSurface, jpg, "assets/container.jpg")->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Image_ConvertSurface, png, "assets/container2.png")->Unit(benchmark::kMillisecond);
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+
+#include "GLContext.h"
+#include "Mesh.h"
+
+#include <KJK_Engine/Renderer/GLStateCache.h>
+
+namespace
+{
+	//Texture types in the order Model::processMesh adds them
+	const char* s_TextureTypes[] = { "texture_diffuse", "texture_specular", "texture_normal", "texture_height" };
+
+	//Create a small quad mesh with a number of 1x1 textures, the mesh takes ownership of the textures
+	Mesh CreateQuadMesh(int textureCount)
+	{
+		std::vector<Vertex> vertices(4);
+		vertices[0].position = glm::vec3(-1.0f, -1.0f, 0.0f);
+		vertices[1].position = glm::vec3(1.0f, -1.0f, 0.0f);
+		vertices[2].position = glm::vec3(1.0f, 1.0f, 0.0f);
+		vertices[3].position = glm::vec3(-1.0f, 1.0f, 0.0f);
+		std::vector<GLuint> indices{ 0, 1, 2, 2, 3, 0 };
+
+		std::vector<Texture> textures;
+		const GLubyte pixel[4] = { 255, 255, 255, 255 };
+		for (int i = 0; i < textureCount; i++)
+		{
+			Texture texture{};
+			glGenTextures(1, &texture.id);
+			KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, texture.id);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+			texture.type = s_TextureTypes[i % std::size(s_TextureTypes)];
+			textures.push_back(texture);
+		}
+		KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, 0);
+
+		return Mesh(vertices, indices, textures, Material{});
+	}
+}
+
+//Submit a frame worth of mesh draws, the arguments are the number of meshes and the textures per mesh
+//Only the CPU side of the submission is timed, the GPU is drained outside of the measurement after every frame
+static void BM_Mesh_Draw(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	std::vector<Mesh> meshes;
+	meshes.reserve(state.range(0));
+	for (int64_t i = 0; i < state.range(0); i++)
+	{
+		meshes.push_back(CreateQuadMesh(static_cast<int>(state.range(1))));
+	}
+
+	//Render into a tiny framebuffer so the fragment work doesn't dominate
+	glViewport(0, 0, 1, 1);
+
+	for (auto _ : state)
+	{
+		for (const Mesh& mesh : meshes)
+		{
+			mesh.Draw(*shader);
+		}
+
+		state.PauseTiming();
+		glFinish();
+		state.ResumeTiming();
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Mesh_Draw)->Args({ 256, 0 })->Args({ 256, 2 })->Args({ 256, 4 })->Args({ 1024, 2 });
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include "GLContext.h"
+#include "Model.h"
+
+//Gives the benchmarks access to the private mesh conversion of a model
+class ModelBenchmarkAccess
+{
+public:
+	//Convert an Assimp mesh like Model::loadModel does for every mesh of a file
+	Mesh ProcessMesh(aiMesh* mesh, const aiScene* scene)
+	{
+		return m_Model.processMesh(mesh, scene);
+	}
+private:
+	Model m_Model;
+};
+
+namespace
+{
+	//Build a scene with a single grid mesh with all the attributes a model file provides after post processing
+	std::unique_ptr<aiScene> CreateGridScene(unsigned int side)
+	{
+		auto scene = std::make_unique<aiScene>();
+
+		//Material without textures, so only the vertex conversion and the upload are measured
+		aiMaterial* material = new aiMaterial();
+		float shininess = 32.0f;
+		material->AddProperty(&shininess, 1, AI_MATKEY_SHININESS);
+		scene->mMaterials = new aiMaterial*[1]{ material };
+		scene->mNumMaterials = 1;
+
+		aiMesh* mesh = new aiMesh();
+		mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+		mesh->mMaterialIndex = 0;
+		mesh->mNumVertices = side * side;
+		mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+		mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+		mesh->mTangents = new aiVector3D[mesh->mNumVertices];
+		mesh->mBitangents = new aiVector3D[mesh->mNumVertices];
+		mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+		mesh->mNumUVComponents[0] = 2;
+
+		for (unsigned int y = 0; y < side; y++)
+		{
+			for (unsigned int x = 0; x < side; x++)
+			{
+				unsigned int i = y * side + x;
+				float u = static_cast<float>(x) / static_cast<float>(side - 1);
+				float v = static_cast<float>(y) / static_cast<float>(side - 1);
+				mesh->mVertices[i] = aiVector3D(u, v, 0.0f);
+				mesh->mNormals[i] = aiVector3D(0.0f, 0.0f, 1.0f);
+				mesh->mTangents[i] = aiVector3D(1.0f, 0.0f, 0.0f);
+				mesh->mBitangents[i] = aiVector3D(0.0f, 1.0f, 0.0f);
+				mesh->mTextureCoords[0][i] = aiVector3D(u, v, 0.0f);
+			}
+		}
+
+		//Two triangles per grid cell
+		mesh->mNumFaces = (side - 1) * (side - 1) * 2;
+		mesh->mFaces = new aiFace[mesh->mNumFaces];
+		unsigned int face = 0;
+		for (unsigned int y = 0; y + 1 < side; y++)
+		{
+			for (unsigned int x = 0; x + 1 < side; x++)
+			{
+				unsigned int corner = y * side + x;
+				unsigned int triangles[2][3] = { { corner, corner + 1, corner + side }, { corner + 1, corner + side + 1, corner + side } };
+				for (const auto& triangle : triangles)
+				{
+					mesh->mFaces[face].mNumIndices = 3;
+					mesh->mFaces[face].mIndices = new unsigned int[3]{ triangle[0], triangle[1], triangle[2] };
+					face++;
+				}
+			}
+		}
+
+		scene->mMeshes = new aiMesh*[1]{ mesh };
+		scene->mNumMeshes = 1;
+		return scene;
+	}
+}
+
+//Convert a large Assimp mesh to the engine's vertex format and upload it, the argument is the side of the vertex grid
+static void BM_Model_ProcessMesh(benchmark::State& state)
+{
+	if (!AcquireGLContext(state))
+		return;
+
+	std::unique_ptr<aiScene> scene = CreateGridScene(static_cast<unsigned int>(state.range(0)));
+	ModelBenchmarkAccess model;
+
+	for (auto _ : state)
+	{
+		Mesh mesh = model.ProcessMesh(scene->mMeshes[0], scene.get());
+		GLuint vao = mesh.GetVAO();
+		benchmark::DoNotOptimize(vao);
+	}
+
+	state.SetItemsProcessed(state.iterations() * scene->mMeshes[0]->mNumVertices);
+	state.SetBytesProcessed(state.iterations() * scene->mMeshes[0]->mNumVertices * sizeof(Vertex));
+}
+BENCHMARK(BM_Model_ProcessMesh)->Arg(128)->Arg(512)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,220 @@
+#include <benchmark/benchmark.h>
+
+#include "GLContext.h"
+
+#include <KJK_Engine/Renderer/ProgramCache.h>
+
+namespace
+{
+	//Number of uniforms set per benchmark iteration, about what a lit draw call sets
+	constexpr int s_UniformCount = 32;
+}
+
+//Set a float uniform by name, every call looks up the location in the reflected uniform table
+static void BM_Shader_SetFloat(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_UniformCount; i++)
+		{
+			shader->SetFloat("material.shininess", static_cast<float>(i));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * s_UniformCount);
+}
+BENCHMARK(BM_Shader_SetFloat);
+
+//Set an integer uniform by name, like binding the texture samplers
+static void BM_Shader_SetInt(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_UniformCount; i++)
+		{
+			shader->SetInt("material.diffuse", i & 7);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * s_UniformCount);
+}
+BENCHMARK(BM_Shader_SetInt);
+
+//Set a vector uniform by name inside an array of structs, the longest names the Playground uses
+static void BM_Shader_SetVec3(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	glm::vec3 position(1.0f, 2.0f, 3.0f);
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_UniformCount; i++)
+		{
+			position.x = static_cast<float>(i);
+			shader->SetVec3("pointLightsWorld[0].position", position);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * s_UniformCount);
+}
+BENCHMARK(BM_Shader_SetVec3);
+
+//Set the model matrix by name, done once per drawn object
+static void BM_Shader_SetMat4(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	glm::mat4 model(1.0f);
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_UniformCount; i++)
+		{
+			model[3][0] = static_cast<float>(i);
+			shader->SetMat4("model", model);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * s_UniformCount);
+}
+BENCHMARK(BM_Shader_SetMat4);
+
+//Set a matrix through the string overload, like the uniform names built at runtime
+static void BM_Shader_SetMat4_String(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	std::string name("model");
+	glm::mat4 model(1.0f);
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_UniformCount; i++)
+		{
+			model[3][0] = static_cast<float>(i);
+			shader->SetMat4(name, model);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * s_UniformCount);
+}
+BENCHMARK(BM_Shader_SetMat4_String);
+
+//Set a matrix through a handle resolved before the loop, no name lookup at all
+static void BM_Shader_SetMat4_Handle(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	UniformHandle<glm::mat4> uniform = shader->GetUniform<glm::mat4>("model");
+	glm::mat4 model(1.0f);
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_UniformCount; i++)
+		{
+			model[3][0] = static_cast<float>(i);
+			shader->Set(uniform, model);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * s_UniformCount);
+}
+BENCHMARK(BM_Shader_SetMat4_Handle);
+
+//Set an array element through a handle, the counterpart of the longest names
+static void BM_Shader_SetVec3_Handle(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	UniformHandle<glm::vec3> uniform = shader->GetUniform<glm::vec3>("pointLightsWorld[0].position");
+	glm::vec3 position(1.0f, 2.0f, 3.0f);
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_UniformCount; i++)
+		{
+			position.x = static_cast<float>(i);
+			shader->Set(uniform, position);
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * s_UniformCount);
+}
+BENCHMARK(BM_Shader_SetVec3_Handle);
+
+//Set a uniform the program doesn't have, the lookup fails and the driver ignores location -1
+static void BM_Shader_SetFloat_Missing(benchmark::State& state)
+{
+	std::optional<Shader> shader = LoadModelShader(state);
+	if (!shader)
+		return;
+
+	for (auto _ : state)
+	{
+		for (int i = 0; i < s_UniformCount; i++)
+		{
+			shader->SetFloat("material.missing", static_cast<float>(i));
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * s_UniformCount);
+}
+BENCHMARK(BM_Shader_SetFloat_Missing);
+
+//Compile and link the model shader every iteration, like a cold start
+//Drivers with their own shader cache (like Mesa) skip part of the work, so this is a lower bound
+static void BM_Shader_Build_Cold(benchmark::State& state)
+{
+	if (!AcquireGLContext(state))
+		return;
+
+	KJK::ProgramCache::Shutdown();
+	for (auto _ : state)
+	{
+		Shader shader("assets/shaders/shader.vert", "assets/shaders/shader2.frag");
+		benchmark::DoNotOptimize(shader.ID);
+	}
+}
+BENCHMARK(BM_Shader_Build_Cold)->Unit(benchmark::kMillisecond);
+
+//Create the model shader from its cached program binary every iteration, like a warm start
+static void BM_Shader_Build_Warm(benchmark::State& state)
+{
+	if (!AcquireGLContext(state))
+		return;
+
+	if (!KJK::ProgramCache::Init("benchmark_cache/programs"))
+	{
+		state.SkipWithError("The OpenGL driver doesn't support program binaries");
+		return;
+	}
+
+	//Store the binary before measuring
+	{
+		Shader shader("assets/shaders/shader.vert", "assets/shaders/shader2.frag");
+	}
+
+	for (auto _ : state)
+	{
+		Shader shader("assets/shaders/shader.vert", "assets/shaders/shader2.frag");
+		benchmark::DoNotOptimize(shader.ID);
+	}
+
+	state.counters["CacheHits"] = static_cast<double>(KJK::ProgramCache::GetStats().Hits);
+	KJK::ProgramCache::Shutdown();
+}
+BENCHMARK(BM_Shader_Build_Warm)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <Platform/SDL/SDLWindow.h>
+#include <KJK_Engine/Events/MouseEvent.h>
+
+namespace
+{
+	//Number of SDL events translated per benchmark iteration, a busy frame of input
+	constexpr int s_EventCount = 256;
+
+	//Build a typical input mix, mostly mouse motion with some keys, buttons and wheel events
+	std::vector<SDL_Event> CreateInputEvents()
+	{
+		std::vector<SDL_Event> events(s_EventCount);
+		for (int i = 0; i < s_EventCount; i++)
+		{
+			SDL_Event& event = events[i];
+			SDL_zero(event);
+			switch (i % 16)
+			{
+			case 0:
+				event.type = SDL_EVENT_KEY_DOWN;
+				event.key.key = SDLK_W;
+				event.key.scancode = SDL_SCANCODE_W;
+				break;
+			case 1:
+				event.type = SDL_EVENT_KEY_UP;
+				event.key.key = SDLK_W;
+				event.key.scancode = SDL_SCANCODE_W;
+				break;
+			case 2:
+				event.type = SDL_EVENT_MOUSE_BUTTON_DOWN;
+				event.button.button = SDL_BUTTON_LEFT;
+				break;
+			case 3:
+				event.type = SDL_EVENT_MOUSE_WHEEL;
+				event.wheel.y = 1.0f;
+				break;
+			default:
+				event.type = SDL_EVENT_MOUSE_MOTION;
+				event.motion.x = static_cast<float>(i);
+				event.motion.xrel = 1.0f;
+				break;
+			}
+		}
+		return events;
+	}
+}
+
+//Translate a frame worth of SDL events into engine events and deliver them, the argument enables merging runs of mouse motion
+static void BM_SDLWindow_TranslateEvents(benchmark::State& state)
+{
+	std::vector<SDL_Event> events = CreateInputEvents();
+	KJK::EventQueue queue;
+	queue.SetCoalescing(state.range(0) != 0);
+	float sum = 0.0f;
+
+	for (auto _ : state)
+	{
+		for (const SDL_Event& event : events)
+		{
+			KJK::SDLWindow::TranslateEvent(event, queue);
+		}
+
+		queue.Flush([&sum](KJK::Event& event)
+		{
+			KJK::EventDispatcher::Dispatch<KJK::MouseMovedEvent>(event, [&sum](KJK::MouseMovedEvent& motion) { sum += motion.GetDeltaX(); return true; });
+		});
+	}
+
+	benchmark::DoNotOptimize(sum);
+	state.SetItemsProcessed(state.iterations() * s_EventCount);
+}
+BENCHMARK(BM_SDLWindow_TranslateEvents)->Arg(0)->Arg(1);
@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+
+#include <KJK_Engine/Core/Logger.h>
+
+#include "GLContext.h"
+
+//Entry point of the benchmark suite, sets up the engine systems the benchmarks rely on
+int main(int argc, char** argv)
+{
+	//Initialize the logging system so engine warnings can be reported
+	KJK::Logger::Init();
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	//Destroy the OpenGL context, if any benchmark created it
+	ReleaseGLContext();
+
+	KJK::Logger::Shutdown();
+
+	return 0;
+}
@@ -1,13 +1,17 @@
 #include "Application.h"
 
 #include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/FrameAllocator.h"
+#include "KJK_Engine/Core/Profiler.h"
+#include "KJK_Engine/Core/Stats.h"
 #include <KJK_Engine/Events/ApplicationEvent.h>
 
 namespace KJK
 {
 	Application::Application()
 	{
-
+		//Cap the loop by default so an idle application doesn't occupy a whole core
+		m_FrameTimer.SetMaxFrameRate(60.0);
 	}
 
 	Application::~Application()
@@ -20,11 +24,57 @@ namespace KJK
 		WindowResizeEvent e(1280, 720);
 		KJK_CORE_INFO(e);
 
+		//Start timing from the first frame
+		m_FrameTimer.Reset();
 
-		while (true)
+		while (m_Running)
 		{
+			//Measure the frame time
+			Timestep deltaTime = m_FrameTimer.BeginFrame();
+
+			//Start or finish the requested profiler captures
+			Profiler::BeginFrame();
+			KJK_PROFILE_SCOPE("Application::Frame");
+			KJK_STAT_SET("Frame ms", deltaTime.GetMilliseconds());
+
+			//Release the frame memory used two frames ago
+			FrameAllocator::NextFrame();
+
+			//Publish the events queued since the last frame
+			{
+				KJK_PROFILE_SCOPE("Application::PublishEvents");
+				m_EventBus.Publish(m_EventQueue);
+			}
+
+			//Advance the simulation in fixed steps
+			while (m_FrameTimer.StepFixed())
+			{
+				KJK_PROFILE_SCOPE("Application::FixedUpdate");
+				OnFixedUpdate(m_FrameTimer.GetFixedTimestep());
+			}
 
+			//Update and render with the leftover time used for interpolation
+			{
+				KJK_PROFILE_SCOPE("Application::Update");
+				OnUpdate(deltaTime, m_FrameTimer.GetAlpha());
+			}
+
+			//Wait for the end of the frame budget
+			{
+				KJK_PROFILE_SCOPE("Application::WaitForFrame");
+				m_FrameTimer.EndFrame();
+			}
+
+			//Record the frame stats
+			KJK_STAT_SET("Work ms", m_FrameTimer.GetHistory().Get(0).WorkMs);
+			Stats::EndFrame();
 		}
 	}
+
+	//Request the main loop to stop after the current frame
+	void Application::Close()
+	{
+		m_Running = false;
+	}
 }
 
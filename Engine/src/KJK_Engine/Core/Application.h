@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Macros.h"
+#include "FrameTimer.h"
+#include "KJK_Engine/Events/EventBus.h"
+#include "KJK_Engine/Events/EventQueue.h"
 
 namespace KJK
 {
@@ -10,8 +13,34 @@ namespace KJK
 		Application();
 		virtual ~Application();
 
+		//Run the main loop until Close is called
 		void Run();
+		//Request the main loop to stop after the current frame
+		void Close();
+
+		//Getter for the frame timer driving the main loop
+		inline FrameTimer& GetFrameTimer() { return m_FrameTimer; }
+		//Getter for the queue of events published at the start of the next frame
+		inline EventQueue& GetEventQueue() { return m_EventQueue; }
+		//Getter for the event bus listeners subscribe to
+		inline EventBus& GetEventBus() { return m_EventBus; }
+
+	protected:
+		//Called zero or more times per frame with a constant timestep to advance the simulation
+		virtual void OnFixedUpdate(Timestep fixedTimestep) {}
+		//Called once per frame, alpha is the blend factor between the previous and the next fixed step
+		virtual void OnUpdate(Timestep deltaTime, float alpha) {}
+
+	private:
+		//Main loop flag
+		bool m_Running = true;
+		//Timer measuring and pacing frames
+		FrameTimer m_FrameTimer;
+		//Events waiting to be published
+		EventQueue m_EventQueue;
+		//Bus publishing events to the subscribed listeners
+		EventBus m_EventBus;
 	};
 
 	Application* CreateApplication();
-}
\ No newline at end of file
+}
@@ -0,0 +1,290 @@
+#include "BinaryTrace.h"
+
+#include "KJK_Engine/Core/Clock.h"
+#include "KJK_Engine/Core/Logger.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace KJK
+{
+	std::atomic<bool> BinaryTrace::s_Enabled{ false };
+
+	namespace
+	{
+		//Size of a single record buffer
+		constexpr size_t s_ChunkSize = 1024 * 1024;
+		//Number of full buffers kept before the oldest ones are dropped
+		constexpr size_t s_MaxRetiredChunks = 64;
+
+		//Buffer of records written by a single thread
+		struct Chunk
+		{
+			std::unique_ptr<std::byte[]> Data = std::make_unique<std::byte[]>(s_ChunkSize);
+			//Index of the thread writing the records
+			uint32_t ThreadIndex = 0;
+			//End of the reserved records, only used by the writing thread
+			size_t Reserved = 0;
+			//End of the finished records, read by the flushing thread
+			std::atomic<size_t> Committed{ 0 };
+			//End of the records already written to the file, only used by the flushing thread
+			size_t Flushed = 0;
+		};
+
+		//Recording state of a thread
+		struct ThreadBuffer
+		{
+			//Chunk the thread is currently writing to
+			std::atomic<Chunk*> Current{ nullptr };
+			uint32_t ThreadIndex = 0;
+		};
+
+		//Registered format of a call site
+		struct FormatInfo
+		{
+			std::string Format;
+			std::string File;
+			std::string ArgTypes;
+			uint32_t Line;
+		};
+
+		//Guards everything below, recording only takes it when a thread starts or fills a chunk
+		std::mutex s_Mutex;
+		std::vector<FormatInfo> s_Formats;
+		//Number of formats already written to the file
+		size_t s_WrittenFormats = 0;
+		std::vector<std::unique_ptr<ThreadBuffer>> s_ThreadBuffers;
+		//Full chunks waiting to be written to the file
+		std::deque<Chunk*> s_RetiredChunks;
+		std::ofstream s_File;
+
+		//Thread writing the chunks to the file
+		std::thread s_WriterThread;
+		std::condition_variable s_WriterCondition;
+		bool s_StopWriter = false;
+
+		std::atomic<uint64_t> s_DroppedBytes{ 0 };
+
+		//Recording state of the calling thread
+		thread_local ThreadBuffer* t_Buffer = nullptr;
+		//Chunk and end of the record reserved by BeginRecord
+		thread_local Chunk* t_RecordChunk = nullptr;
+		thread_local size_t t_RecordEnd = 0;
+
+		//Helpers for writing the trace file
+		void WriteU32(uint32_t value)
+		{
+			s_File.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+
+		void WriteU64(uint64_t value)
+		{
+			s_File.write(reinterpret_cast<const char*>(&value), sizeof(value));
+		}
+
+		void WriteString(const std::string& value)
+		{
+			WriteU32(static_cast<uint32_t>(value.size()));
+			s_File.write(value.data(), value.size());
+		}
+
+		//Write the unwritten records of a chunk as a record block, the mutex has to be held
+		void WriteChunk(Chunk& chunk, size_t committed)
+		{
+			if (committed <= chunk.Flushed)
+				return;
+
+			WriteU32(BinaryTraceFormat::RecordBlock);
+			WriteU32(chunk.ThreadIndex);
+			WriteU64(committed - chunk.Flushed);
+			s_File.write(reinterpret_cast<const char*>(chunk.Data.get() + chunk.Flushed), committed - chunk.Flushed);
+			chunk.Flushed = committed;
+		}
+
+		//Hand a full chunk to the flushing thread and give the thread a new one
+		Chunk* ReplaceChunk(ThreadBuffer& buffer, Chunk* full)
+		{
+			Chunk* chunk = new Chunk;
+			chunk->ThreadIndex = buffer.ThreadIndex;
+
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			if (full)
+			{
+				s_RetiredChunks.push_back(full);
+
+				//Drop the oldest chunks when the file isn't written fast enough
+				while (s_RetiredChunks.size() > s_MaxRetiredChunks)
+				{
+					Chunk* dropped = s_RetiredChunks.front();
+					s_RetiredChunks.pop_front();
+					s_DroppedBytes.fetch_add(dropped->Committed.load(std::memory_order_relaxed) - dropped->Flushed, std::memory_order_relaxed);
+					delete dropped;
+				}
+			}
+			buffer.Current.store(chunk, std::memory_order_release);
+			return chunk;
+		}
+	}
+
+	//Open the trace file and start the thread writing the buffers to it
+	void BinaryTrace::Init(const char* path, uint32_t flushIntervalMs)
+	{
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			s_File.open(path, std::ios::binary | std::ios::trunc);
+			if (!s_File)
+			{
+				KJK_CORE_ERROR("Failed to open the binary trace file {0}!", path);
+				return;
+			}
+
+			s_File.write(BinaryTraceFormat::Magic, sizeof(BinaryTraceFormat::Magic));
+			WriteU32(BinaryTraceFormat::Version);
+			s_WrittenFormats = 0;
+			s_StopWriter = false;
+		}
+
+		//Write the buffers to the file in the background
+		s_WriterThread = std::thread([flushIntervalMs]()
+		{
+			std::unique_lock<std::mutex> lock(s_Mutex);
+			while (!s_StopWriter)
+			{
+				s_WriterCondition.wait_for(lock, std::chrono::milliseconds(flushIntervalMs));
+				lock.unlock();
+				Flush();
+				lock.lock();
+			}
+		});
+
+		s_Enabled.store(true, std::memory_order_relaxed);
+		KJK_CORE_INFO("Recording binary trace to {0}", path);
+	}
+
+	//Write the remaining records, stop the writer thread and close the file
+	void BinaryTrace::Shutdown()
+	{
+		s_Enabled.store(false, std::memory_order_relaxed);
+
+		if (s_WriterThread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				s_StopWriter = true;
+			}
+			s_WriterCondition.notify_one();
+			s_WriterThread.join();
+		}
+
+		Flush();
+
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (s_File.is_open())
+			s_File.close();
+
+		if (uint64_t dropped = s_DroppedBytes.load(std::memory_order_relaxed))
+			KJK_CORE_WARN("Binary trace dropped {0} bytes of records", dropped);
+	}
+
+	//Enable or disable recording, records are skipped while disabled
+	void BinaryTrace::SetEnabled(bool enabled)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Enabled.store(enabled && s_File.is_open(), std::memory_order_relaxed);
+	}
+
+	//Write all recorded data to the trace file, called regularly by the writer thread
+	void BinaryTrace::Flush()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (!s_File.is_open())
+			return;
+
+		//Formats go first so the decoder knows them before their records
+		for (; s_WrittenFormats < s_Formats.size(); s_WrittenFormats++)
+		{
+			const FormatInfo& info = s_Formats[s_WrittenFormats];
+			WriteU32(BinaryTraceFormat::FormatBlock);
+			WriteU32(static_cast<uint32_t>(s_WrittenFormats + 1));
+			WriteString(info.ArgTypes);
+			WriteString(info.Format);
+			WriteString(info.File);
+			WriteU32(info.Line);
+		}
+
+		//Full chunks hold older records than the chunks the threads are writing to
+		for (Chunk* chunk : s_RetiredChunks)
+		{
+			WriteChunk(*chunk, chunk->Committed.load(std::memory_order_acquire));
+			delete chunk;
+		}
+		s_RetiredChunks.clear();
+
+		//Chunks can only be retired while holding the mutex, so the current ones stay valid here
+		for (const std::unique_ptr<ThreadBuffer>& buffer : s_ThreadBuffers)
+		{
+			Chunk* chunk = buffer->Current.load(std::memory_order_acquire);
+			if (chunk)
+				WriteChunk(*chunk, chunk->Committed.load(std::memory_order_acquire));
+		}
+
+		s_File.flush();
+	}
+
+	//Getter for the number of bytes dropped because the buffers weren't written out fast enough
+	uint64_t BinaryTrace::GetDroppedBytes()
+	{
+		return s_DroppedBytes.load(std::memory_order_relaxed);
+	}
+
+	//Register a format and its argument types, returns its id
+	uint32_t BinaryTrace::RegisterFormat(const char* format, const char* file, uint32_t line, const char* argTypes)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Formats.push_back({ format, file, argTypes, line });
+		return static_cast<uint32_t>(s_Formats.size());
+	}
+
+	//Reserve space for a record in the calling thread's buffer, returns the payload memory or nullptr if it was dropped
+	std::byte* BinaryTrace::BeginRecord(uint32_t formatId, uint32_t payloadSize)
+	{
+		size_t recordSize = sizeof(BinaryTraceFormat::RecordHeader) + payloadSize;
+		if (recordSize > s_ChunkSize)
+			return nullptr;
+
+		//Register the thread on its first record
+		if (!t_Buffer)
+		{
+			std::lock_guard<std::mutex> lock(s_Mutex);
+			auto buffer = std::make_unique<ThreadBuffer>();
+			buffer->ThreadIndex = static_cast<uint32_t>(s_ThreadBuffers.size());
+			t_Buffer = buffer.get();
+			s_ThreadBuffers.push_back(std::move(buffer));
+		}
+
+		Chunk* chunk = t_Buffer->Current.load(std::memory_order_relaxed);
+		if (!chunk || chunk->Reserved + recordSize > s_ChunkSize)
+			chunk = ReplaceChunk(*t_Buffer, chunk);
+
+		std::byte* memory = chunk->Data.get() + chunk->Reserved;
+
+		BinaryTraceFormat::RecordHeader header;
+		header.TimestampNs = Clock::GetTimeNs();
+		header.FormatId = formatId;
+		header.PayloadSize = payloadSize;
+		std::memcpy(memory, &header, sizeof(header));
+
+		t_RecordChunk = chunk;
+		t_RecordEnd = chunk->Reserved + recordSize;
+		return memory + sizeof(header);
+	}
+
+	//Publish the record reserved by BeginRecord
+	void BinaryTrace::EndRecord()
+	{
+		t_RecordChunk->Reserved = t_RecordEnd;
+		t_RecordChunk->Committed.store(t_RecordEnd, std::memory_order_release);
+	}
+}
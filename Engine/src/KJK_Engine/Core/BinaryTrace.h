@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace KJK
+{
+	//Layout of a binary trace file, shared with the trace decoder
+	//The file starts with the magic and version, followed by blocks that each start with a BinaryTraceBlock tag
+	namespace BinaryTraceFormat
+	{
+		constexpr char Magic[4] = { 'K', 'J', 'K', 'T' };
+		constexpr uint32_t Version = 1;
+
+		//Tags of the blocks in a trace file
+		enum BinaryTraceBlock : uint32_t
+		{
+			//uint32 id, then the argument types, format string and source file as uint32 length + characters, then uint32 line
+			FormatBlock = 1,
+			//uint32 thread index, uint64 byte count, then that many bytes of records
+			RecordBlock = 2
+		};
+
+		//Header in front of the raw argument bytes of every record
+		struct RecordHeader
+		{
+			uint64_t TimestampNs;
+			uint32_t FormatId;
+			uint32_t PayloadSize;
+		};
+
+		//Argument type codes stored with every format
+		constexpr char SignedArg = 'i'; //int64
+		constexpr char UnsignedArg = 'u'; //uint64
+		constexpr char FloatArg = 'f'; //float
+		constexpr char DoubleArg = 'd'; //double
+		constexpr char BoolArg = 'b'; //uint8
+		constexpr char CharArg = 'c'; //char
+		constexpr char PointerArg = 'p'; //uint64
+	}
+
+	//Call site of a binary trace, registers its format the first time it's recorded
+	struct BinaryTraceSite
+	{
+		std::atomic<uint32_t> FormatId{ 0 };
+	};
+
+	//Binary trace channel for hot paths
+	//Records store a format id and the raw argument bytes in a per thread buffer, formatting happens offline in the trace decoder
+	class BinaryTrace
+	{
+	public:
+		//Open the trace file and start the thread writing the buffers to it
+		static void Init(const char* path, uint32_t flushIntervalMs = 500);
+		//Write the remaining records, stop the writer thread and close the file
+		static void Shutdown();
+
+		//Enable or disable recording, records are skipped while disabled
+		static void SetEnabled(bool enabled);
+		//Check if records are currently recorded
+		inline static bool IsEnabled() { return s_Enabled.load(std::memory_order_relaxed); }
+
+		//Write all recorded data to the trace file, called regularly by the writer thread
+		static void Flush();
+
+		//Getter for the number of bytes dropped because the buffers weren't written out fast enough
+		static uint64_t GetDroppedBytes();
+
+		//Record a trace, the format is registered the first time the call site is hit
+		template<typename... Args>
+		static void Record(BinaryTraceSite& site, const char* format, const char* file, uint32_t line, const Args&... args)
+		{
+			uint32_t formatId = site.FormatId.load(std::memory_order_relaxed);
+			if (formatId == 0)
+			{
+				formatId = RegisterFormat(format, file, line, s_ArgTypes<std::decay_t<Args>...>);
+				site.FormatId.store(formatId, std::memory_order_relaxed);
+			}
+
+			constexpr size_t payloadSize = (0 + ... + ArgSize<std::decay_t<Args>>());
+			std::byte* memory = BeginRecord(formatId, static_cast<uint32_t>(payloadSize));
+			if (!memory)
+				return;
+
+			(WriteArg(memory, args), ...);
+			EndRecord();
+		}
+	private:
+		//Type code of an argument, only trivially copyable values can be recorded
+		template<typename T>
+		static constexpr char ArgType()
+		{
+			using namespace BinaryTraceFormat;
+
+			if constexpr (std::is_same_v<T, bool>)
+				return BoolArg;
+			else if constexpr (std::is_same_v<T, char>)
+				return CharArg;
+			else if constexpr (std::is_same_v<T, float>)
+				return FloatArg;
+			else if constexpr (std::is_same_v<T, double>)
+				return DoubleArg;
+			else if constexpr (std::is_pointer_v<T>)
+			{
+				static_assert(!std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>, "Strings can't be recorded in a binary trace, use the text logger");
+				return PointerArg;
+			}
+			else if constexpr (std::is_enum_v<T>)
+				return ArgType<std::underlying_type_t<T>>();
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+				return SignedArg;
+			else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T>)
+				return UnsignedArg;
+			else
+				static_assert(sizeof(T) == 0, "Only arithmetic, enum and pointer values can be recorded in a binary trace");
+		}
+
+		//Number of payload bytes an argument occupies
+		template<typename T>
+		static constexpr size_t ArgSize()
+		{
+			switch (ArgType<T>())
+			{
+			case BinaryTraceFormat::BoolArg:
+			case BinaryTraceFormat::CharArg:
+				return 1;
+			case BinaryTraceFormat::FloatArg:
+				return sizeof(float);
+			default:
+				return 8;
+			}
+		}
+
+		//Null terminated type codes of an argument list
+		template<typename... Args>
+		static constexpr char s_ArgTypes[] = { ArgType<Args>()..., '\0' };
+
+		//Copy an argument into the record, widening integers and pointers to 64 bits
+		template<typename T>
+		static void WriteArg(std::byte*& memory, const T& value)
+		{
+			using ValueType = std::decay_t<T>;
+			constexpr char type = ArgType<ValueType>();
+
+			if constexpr (type == BinaryTraceFormat::SignedArg)
+			{
+				int64_t widened = static_cast<int64_t>(value);
+				std::memcpy(memory, &widened, sizeof(widened));
+			}
+			else if constexpr (type == BinaryTraceFormat::UnsignedArg)
+			{
+				uint64_t widened = static_cast<uint64_t>(value);
+				std::memcpy(memory, &widened, sizeof(widened));
+			}
+			else if constexpr (type == BinaryTraceFormat::PointerArg)
+			{
+				uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+				std::memcpy(memory, &address, sizeof(address));
+			}
+			else if constexpr (type == BinaryTraceFormat::BoolArg)
+			{
+				uint8_t flag = value ? 1 : 0;
+				std::memcpy(memory, &flag, sizeof(flag));
+			}
+			else
+			{
+				std::memcpy(memory, &value, sizeof(value));
+			}
+
+			memory += ArgSize<ValueType>();
+		}
+
+		//Register a format and its argument types, returns its id
+		static uint32_t RegisterFormat(const char* format, const char* file, uint32_t line, const char* argTypes);
+		//Reserve space for a record in the calling thread's buffer, returns the payload memory or nullptr if it was dropped
+		static std::byte* BeginRecord(uint32_t formatId, uint32_t payloadSize);
+		//Publish the record reserved by BeginRecord
+		static void EndRecord();
+
+		//Recording flag
+		static std::atomic<bool> s_Enabled;
+	};
+}
+
+#ifdef KJK_MINSIZE
+	#define KJK_BTRACE(format, ...)
+#else
+	//Record a binary trace, the arguments are stored raw and formatted with the format string by the trace decoder
+	#define KJK_BTRACE(format, ...) \
+		do \
+		{ \
+			if (::KJK::BinaryTrace::IsEnabled()) \
+			{ \
+				static ::KJK::BinaryTraceSite kjkTraceSite; \
+				::KJK::BinaryTrace::Record(kjkTraceSite, format, __FILE__, __LINE__ __VA_OPT__(,) __VA_ARGS__); \
+			} \
+		} while (false)
+#endif
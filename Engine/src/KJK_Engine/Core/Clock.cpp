@@ -0,0 +1,24 @@
+#include "Clock.h"
+
+#include <thread>
+
+namespace KJK
+{
+	//Block the calling thread until the given time point, sleeping first and spinning for the remainder
+	void Clock::WaitUntil(uint64_t targetNs, uint64_t spinThresholdNs)
+	{
+		uint64_t now = GetTimeNs();
+
+		//Sleep through most of the wait, leaving a margin for the coarse OS scheduler granularity
+		if (now + spinThresholdNs < targetNs)
+		{
+			std::this_thread::sleep_for(std::chrono::nanoseconds(targetNs - now - spinThresholdNs));
+		}
+
+		//Spin for the remaining time to hit the target precisely
+		while (GetTimeNs() < targetNs)
+		{
+			std::this_thread::yield();
+		}
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace KJK
+{
+	//High resolution monotonic clock used for all engine timing
+	class Clock
+	{
+	public:
+		//Underlying clock type, guaranteed to never go backwards
+		using ClockType = std::chrono::steady_clock;
+
+		//Get the current time in nanoseconds since an unspecified epoch
+		inline static uint64_t GetTimeNs()
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now().time_since_epoch()).count());
+		}
+
+		//Get the current time in seconds since an unspecified epoch
+		inline static double GetTimeSeconds()
+		{
+			return NsToSeconds(GetTimeNs());
+		}
+
+		//Conversion helpers between nanoseconds and seconds
+		inline static double NsToSeconds(uint64_t ns) { return static_cast<double>(ns) * 1e-9; }
+		inline static uint64_t SecondsToNs(double seconds) { return static_cast<uint64_t>(seconds * 1e9); }
+
+		//Block the calling thread until the given time point, sleeping first and spinning for the remainder
+		static void WaitUntil(uint64_t targetNs, uint64_t spinThresholdNs);
+	};
+}
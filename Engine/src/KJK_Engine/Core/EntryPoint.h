@@ -6,6 +6,11 @@
 
 #include "KJK_Engine/Core/Application.h"
 #include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/JobSystem.h"
+#include "KJK_Engine/Core/FrameAllocator.h"
+#include "KJK_Engine/Core/Profiler.h"
+#include "KJK_Engine/Core/Stats.h"
+#include "KJK_Engine/Core/MemoryTracker.h"
 
 //Get the application created in the client code
 extern KJK::Application* KJK::CreateApplication();
@@ -15,10 +20,19 @@ extern KJK::Application* KJK::CreateApplication();
 int main(int argc, char** argv)
 {
 	KJK::Logger::Init();
+	KJK::JobSystem::Init();
+	KJK::FrameAllocator::Init();
 
 	KJK::Application* app = KJK::CreateApplication();
 	app->Run();
 	delete app;
+
+	KJK::FrameAllocator::Shutdown();
+	KJK::JobSystem::Shutdown();
+	KJK::Profiler::Shutdown();
+	KJK::Stats::Shutdown();
+	KJK::MemoryTracker::Shutdown();
+	KJK::Logger::Shutdown();
 }
 
 #endif // TEST_NO_ENTRYPOINT
@@ -0,0 +1,305 @@
+#include "FileWatcher.h"
+
+#include "KJK_Engine/Core/Clock.h"
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/MemoryTracker.h"
+#include "KJK_Engine/Core/Profiler.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#ifdef KJK_PLATFORM_LINUX
+	#include <poll.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+namespace KJK
+{
+	namespace
+	{
+		//Interval the watcher thread checks for shutdown at, and scans the directories at without inotify
+		constexpr int s_PollIntervalMs = 100;
+
+		std::thread s_Thread;
+		std::atomic<bool> s_Running{ false };
+		std::mutex s_ThreadMutex;
+		std::condition_variable s_ThreadCondition;
+
+		//Changed files with the time of their latest change, written by the watcher thread
+		std::mutex s_ChangesMutex;
+		std::unordered_map<std::string, uint64_t> s_Changes;
+		//Settled changes handed out by DispatchChanges, kept to reuse the memory
+		std::vector<std::string> s_Settled;
+
+		//Protects the watched directories, shared between the watcher thread and WatchDirectory
+		std::mutex s_WatchMutex;
+
+		//Normalize a path to forward slashes without a trailing separator, so paths compare equal
+		std::string NormalizePath(const std::string& path)
+		{
+			std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+			if (normalized.size() > 1 && normalized.back() == '/')
+				normalized.pop_back();
+			return normalized;
+		}
+
+		//Record a change of a file, restarting its settle time
+		void AddChange(const std::string& path)
+		{
+			uint64_t now = Clock::GetTimeNs();
+			std::lock_guard<std::mutex> lock(s_ChangesMutex);
+			s_Changes[path] = now;
+		}
+
+#ifdef KJK_PLATFORM_LINUX
+		//Events delivered for watched directories, created directories are watched as well
+		constexpr uint32_t s_WatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+
+		int s_Inotify = -1;
+		//Watched directories by watch descriptor
+		std::unordered_map<int, std::string> s_Watches;
+
+		//Add a watch for a directory and all its subdirectories
+		bool AddWatches(const std::string& directory)
+		{
+			std::lock_guard<std::mutex> lock(s_WatchMutex);
+
+			int watch = inotify_add_watch(s_Inotify, directory.c_str(), s_WatchMask);
+			if (watch < 0)
+			{
+				KJK_CORE_ERROR("Failed to watch directory {0}: {1}", directory, std::strerror(errno));
+				return false;
+			}
+			s_Watches[watch] = directory;
+
+			std::error_code error;
+			for (auto it = std::filesystem::recursive_directory_iterator(directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+			{
+				if (!it->is_directory(error))
+					continue;
+
+				std::string subdirectory = it->path().generic_string();
+				watch = inotify_add_watch(s_Inotify, subdirectory.c_str(), s_WatchMask);
+				if (watch >= 0)
+					s_Watches[watch] = subdirectory;
+			}
+			return true;
+		}
+
+		//Main loop of the watcher thread, turns inotify events into changes
+		void WatchLoop()
+		{
+			KJK_MEMORY_SCOPE(MemoryCategory::Engine);
+
+			alignas(inotify_event) char buffer[4096];
+			pollfd descriptor{ s_Inotify, POLLIN, 0 };
+
+			while (s_Running.load(std::memory_order_acquire))
+			{
+				if (poll(&descriptor, 1, s_PollIntervalMs) <= 0)
+					continue;
+
+				ssize_t length = read(s_Inotify, buffer, sizeof(buffer));
+				for (ssize_t offset = 0; offset < length;)
+				{
+					const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+					offset += sizeof(inotify_event) + event->len;
+
+					if (event->mask & IN_Q_OVERFLOW)
+					{
+						KJK_CORE_WARN("File watcher event queue overflowed, some changes were missed");
+						continue;
+					}
+
+					std::string path;
+					{
+						std::lock_guard<std::mutex> lock(s_WatchMutex);
+						auto watch = s_Watches.find(event->wd);
+						if (watch == s_Watches.end())
+							continue;
+
+						//The directory was deleted or moved away
+						if (event->mask & IN_IGNORED)
+						{
+							s_Watches.erase(watch);
+							continue;
+						}
+						if (event->len == 0)
+							continue;
+						path = watch->second + '/' + event->name;
+					}
+
+					if (event->mask & IN_ISDIR)
+					{
+						//Files written into a new directory before its watch is added are missed
+						if (event->mask & (IN_CREATE | IN_MOVED_TO))
+							AddWatches(path);
+					}
+					//Editors either rewrite a file in place or move a new version over it
+					else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+					{
+						AddChange(path);
+					}
+				}
+			}
+		}
+#else
+		//Watched directories and the last modification time of every file in them
+		std::vector<std::string> s_Directories;
+		std::unordered_map<std::string, std::filesystem::file_time_type> s_FileTimes;
+
+		//Compare the modification times of all files in a directory tree, reporting new and modified files
+		void ScanDirectory(const std::string& directory, bool report)
+		{
+			std::error_code error;
+			for (auto it = std::filesystem::recursive_directory_iterator(directory, error); !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+			{
+				std::error_code fileError;
+				if (!it->is_regular_file(fileError))
+					continue;
+
+				std::filesystem::file_time_type time = it->last_write_time(fileError);
+				if (fileError)
+					continue;
+
+				auto [file, inserted] = s_FileTimes.try_emplace(it->path().generic_string(), time);
+				if (inserted || file->second != time)
+				{
+					file->second = time;
+					if (report)
+						AddChange(file->first);
+				}
+			}
+		}
+
+		//Main loop of the watcher thread, rescans the watched directories on a timer
+		void WatchLoop()
+		{
+			KJK_MEMORY_SCOPE(MemoryCategory::Engine);
+
+			std::unique_lock<std::mutex> threadLock(s_ThreadMutex);
+			while (!s_ThreadCondition.wait_for(threadLock, std::chrono::milliseconds(s_PollIntervalMs), []() { return !s_Running.load(std::memory_order_acquire); }))
+			{
+				std::lock_guard<std::mutex> lock(s_WatchMutex);
+				for (const std::string& directory : s_Directories)
+					ScanDirectory(directory, true);
+			}
+		}
+#endif
+	}
+
+	bool FileWatcher::Init()
+	{
+		if (s_Running.load(std::memory_order_acquire))
+			return true;
+
+#ifdef KJK_PLATFORM_LINUX
+		s_Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (s_Inotify < 0)
+		{
+			KJK_CORE_ERROR("Failed to initialize inotify: {0}", std::strerror(errno));
+			return false;
+		}
+#endif
+
+		s_Running.store(true, std::memory_order_release);
+		s_Thread = std::thread(WatchLoop);
+		return true;
+	}
+
+	void FileWatcher::Shutdown()
+	{
+		if (!s_Running.load(std::memory_order_acquire))
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(s_ThreadMutex);
+			s_Running.store(false, std::memory_order_release);
+		}
+		s_ThreadCondition.notify_all();
+		s_Thread.join();
+
+		{
+			std::lock_guard<std::mutex> lock(s_WatchMutex);
+#ifdef KJK_PLATFORM_LINUX
+			close(s_Inotify);
+			s_Inotify = -1;
+			s_Watches.clear();
+#else
+			s_Directories.clear();
+			s_FileTimes.clear();
+#endif
+		}
+
+		std::lock_guard<std::mutex> lock(s_ChangesMutex);
+		s_Changes.clear();
+	}
+
+	bool FileWatcher::WatchDirectory(const std::string& directory)
+	{
+		if (!s_Running.load(std::memory_order_acquire))
+		{
+			KJK_CORE_ERROR("Can't watch {0}, the file watcher isn't running", directory);
+			return false;
+		}
+
+		std::error_code error;
+		if (!std::filesystem::is_directory(directory, error))
+		{
+			KJK_CORE_ERROR("Can't watch {0}, it isn't a directory", directory);
+			return false;
+		}
+
+		std::string normalized = NormalizePath(directory);
+#ifdef KJK_PLATFORM_LINUX
+		return AddWatches(normalized);
+#else
+		//Remember the current state without reporting it, only later modifications count
+		std::lock_guard<std::mutex> lock(s_WatchMutex);
+		ScanDirectory(normalized, false);
+		s_Directories.push_back(normalized);
+		return true;
+#endif
+	}
+
+	void FileWatcher::DispatchChanges(const ChangeCallbackFn& callback)
+	{
+		KJK_PROFILE_FUNCTION();
+
+		{
+			std::lock_guard<std::mutex> lock(s_ChangesMutex);
+			if (s_Changes.empty())
+				return;
+
+			uint64_t now = Clock::GetTimeNs();
+			for (auto it = s_Changes.begin(); it != s_Changes.end();)
+			{
+				if (now - it->second >= SettleTimeNs)
+				{
+					s_Settled.push_back(it->first);
+					it = s_Changes.erase(it);
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+
+		//Call outside the lock, the callbacks may take a while
+		for (const std::string& path : s_Settled)
+			callback(path);
+		s_Settled.clear();
+	}
+
+	bool FileWatcher::IsRunning()
+	{
+		return s_Running.load(std::memory_order_acquire);
+	}
+}
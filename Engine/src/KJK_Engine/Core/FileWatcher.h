@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+namespace KJK
+{
+	//Background service reporting modified files in watched directory trees
+	//Uses inotify on Linux and compares modification times on a timer elsewhere
+	//Changes are collected on the watcher thread and handed out on the calling thread, so they can be applied at a frame boundary
+	class FileWatcher
+	{
+	public:
+		//Function type receiving the path of a changed file, relative like the watched directory it is in
+		using ChangeCallbackFn = std::function<void(const std::string& path)>;
+
+		//Start the watcher thread, returns false if file watching isn't available
+		static bool Init();
+		//Stop the watcher thread and forget all watched directories and pending changes
+		static void Shutdown();
+
+		//Watch a directory and all its subdirectories, including ones created later
+		static bool WatchDirectory(const std::string& directory);
+
+		//Call the callback once for every file that changed and stayed unchanged for the settle time since
+		//Editors often write a file in several steps, waiting for them to settle avoids reading half written files
+		static void DispatchChanges(const ChangeCallbackFn& callback);
+
+		//Check if the watcher thread is running
+		static bool IsRunning();
+
+		//Time a file has to stay unchanged before its change is reported, in nanoseconds
+		static constexpr uint64_t SettleTimeNs = 150'000'000;
+	};
+}
@@ -0,0 +1,144 @@
+#include "FrameAllocator.h"
+
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/MemoryTracker.h"
+
+#include <new>
+
+namespace KJK
+{
+	LinearArena::LinearArena(size_t capacity)
+		: m_Capacity(capacity)
+	{
+		m_Memory = static_cast<std::byte*>(::operator new(capacity, std::align_val_t(alignof(std::max_align_t))));
+	}
+
+	LinearArena::~LinearArena()
+	{
+		Reset();
+		if (m_Memory)
+			::operator delete(m_Memory, std::align_val_t(alignof(std::max_align_t)));
+	}
+
+	//Allocate memory from the arena, falls back to the heap when the arena is full
+	void* LinearArena::Allocate(size_t size, size_t alignment)
+	{
+		if (size == 0)
+			size = 1;
+
+		//Bump the offset, aligning the start of the allocation
+		size_t offset = m_Offset.load(std::memory_order_relaxed);
+		size_t alignedOffset;
+		do
+		{
+			alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+		}
+		while (!m_Offset.compare_exchange_weak(offset, alignedOffset + size, std::memory_order_relaxed));
+
+		if (alignedOffset + size <= m_Capacity)
+			return m_Memory + alignedOffset;
+
+		//The arena is full, keep the allocation on the heap until the next reset
+		alignment = std::max(alignment, alignof(std::max_align_t));
+		void* memory = ::operator new(size, std::align_val_t(alignment));
+		std::lock_guard<std::mutex> lock(m_OverflowMutex);
+		m_OverflowAllocations.push_back({ memory, alignment });
+		return memory;
+	}
+
+	//Release all allocations at once, including the heap fallbacks
+	void LinearArena::Reset()
+	{
+		//The offset keeps growing past the capacity on overflow, so it reflects the full demand
+		size_t requested = m_Offset.exchange(0, std::memory_order_relaxed);
+
+		if (!m_OverflowAllocations.empty())
+		{
+			//Only warn when the demand reaches a new peak to avoid logging every frame
+			if (requested > m_HighWaterMark)
+				KJK_CORE_WARN("Frame arena overflowed with {0} heap allocations, requested {1} of {2} bytes", m_OverflowAllocations.size(), requested, m_Capacity);
+
+			for (const OverflowAllocation& allocation : m_OverflowAllocations)
+			{
+				::operator delete(allocation.Memory, std::align_val_t(allocation.Alignment));
+			}
+			m_OverflowAllocations.clear();
+		}
+
+		m_HighWaterMark = std::max(m_HighWaterMark, requested);
+	}
+
+	namespace
+	{
+		//The two arenas used in alternating frames
+		std::unique_ptr<LinearArena> s_Arenas[2];
+		//Index of the arena used by the current frame
+		uint32_t s_CurrentArena = 0;
+	}
+
+	//Allocate both frame arenas
+	void FrameAllocator::Init(size_t capacityPerFrame)
+	{
+		KJK_MEMORY_SCOPE(MemoryCategory::Engine);
+		s_Arenas[0] = std::make_unique<LinearArena>(capacityPerFrame);
+		s_Arenas[1] = std::make_unique<LinearArena>(capacityPerFrame);
+		s_CurrentArena = 0;
+
+		KJK_CORE_INFO("Initialized the frame allocator with {0} bytes per frame", capacityPerFrame);
+	}
+
+	//Release both frame arenas
+	void FrameAllocator::Shutdown()
+	{
+		if (s_Arenas[0])
+			KJK_CORE_INFO("Frame allocator high water mark: {0} of {1} bytes", GetHighWaterMark(), GetCapacity());
+
+		s_Arenas[0].reset();
+		s_Arenas[1].reset();
+	}
+
+	//Allocate memory that lives until the end of the next frame
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		//Without an arena every allocation is a plain heap allocation that is never reclaimed
+		if (!s_Arenas[s_CurrentArena])
+		{
+			KJK_CORE_ERROR("Frame allocator used before it was initialized!");
+			return ::operator new(size, std::align_val_t(std::max(alignment, alignof(std::max_align_t))));
+		}
+
+		return s_Arenas[s_CurrentArena]->Allocate(size, alignment);
+	}
+
+	//Switch to the other arena and reset it, called once at the start of every frame
+	void FrameAllocator::NextFrame()
+	{
+		if (!s_Arenas[0])
+			return;
+
+		s_CurrentArena = 1 - s_CurrentArena;
+		s_Arenas[s_CurrentArena]->Reset();
+	}
+
+	size_t FrameAllocator::GetUsed()
+	{
+		return s_Arenas[s_CurrentArena] ? s_Arenas[s_CurrentArena]->GetUsed() : 0;
+	}
+
+	size_t FrameAllocator::GetCapacity()
+	{
+		return s_Arenas[s_CurrentArena] ? s_Arenas[s_CurrentArena]->GetCapacity() : 0;
+	}
+
+	//Getter for the highest usage of any frame so far, in bytes
+	size_t FrameAllocator::GetHighWaterMark()
+	{
+		size_t highWaterMark = 0;
+		for (const auto& arena : s_Arenas)
+		{
+			if (arena)
+				highWaterMark = std::max({ highWaterMark, arena->GetHighWaterMark(), arena->GetUsed() });
+		}
+		return highWaterMark;
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace KJK
+{
+	//Bump allocator over a fixed block of memory, individual allocations are never freed
+	//Allocating is thread safe, resetting is not
+	class LinearArena
+	{
+	public:
+		LinearArena() = default;
+		LinearArena(size_t capacity);
+		~LinearArena();
+
+		//Disable copy semantics
+		LinearArena(const LinearArena& other) = delete;
+		LinearArena& operator=(const LinearArena& other) = delete;
+
+		//Allocate memory from the arena, falls back to the heap when the arena is full
+		void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		//Release all allocations at once, including the heap fallbacks
+		void Reset();
+
+		//Getters for the arena usage in bytes
+		inline size_t GetCapacity() const { return m_Capacity; }
+		inline size_t GetUsed() const { return std::min(m_Offset.load(std::memory_order_relaxed), m_Capacity); }
+		inline size_t GetHighWaterMark() const { return m_HighWaterMark; }
+		//Getter for the number of allocations that didn't fit since the last reset
+		inline size_t GetOverflowCount() const { return m_OverflowAllocations.size(); }
+	private:
+		//Start of the memory block
+		std::byte* m_Memory = nullptr;
+		size_t m_Capacity = 0;
+		//Offset of the next free byte
+		std::atomic<size_t> m_Offset{ 0 };
+		//Highest amount of bytes requested between two resets, including overflowing requests
+		size_t m_HighWaterMark = 0;
+
+		//Heap allocation made when the arena was full
+		struct OverflowAllocation
+		{
+			void* Memory;
+			size_t Alignment;
+		};
+
+		//Heap allocations made when the arena was full, freed on reset
+		std::mutex m_OverflowMutex;
+		std::vector<OverflowAllocation> m_OverflowAllocations;
+	};
+
+	//Double buffered arena for transient per frame data
+	//Memory allocated during a frame stays valid until the end of the following frame
+	class FrameAllocator
+	{
+	public:
+		//Allocate both frame arenas
+		static void Init(size_t capacityPerFrame = 4 * 1024 * 1024);
+		//Release both frame arenas
+		static void Shutdown();
+
+		//Allocate memory that lives until the end of the next frame
+		static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+		//Switch to the other arena and reset it, called once at the start of every frame
+		static void NextFrame();
+
+		//Getters for the usage of the current frame's arena in bytes
+		static size_t GetUsed();
+		static size_t GetCapacity();
+		//Getter for the highest usage of any frame so far, in bytes
+		static size_t GetHighWaterMark();
+	};
+
+	//Allocator adapter for using the frame allocator with standard containers
+	//Deallocation is a no-op, the memory is reclaimed when the frame arena is reset
+	template<typename T>
+	class FrameStlAllocator
+	{
+	public:
+		using value_type = T;
+
+		FrameStlAllocator() noexcept = default;
+		template<typename U>
+		FrameStlAllocator(const FrameStlAllocator<U>&) noexcept {}
+
+		T* allocate(size_t count)
+		{
+			return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T*, size_t) noexcept {}
+
+		template<typename U>
+		bool operator==(const FrameStlAllocator<U>&) const noexcept { return true; }
+		template<typename U>
+		bool operator!=(const FrameStlAllocator<U>&) const noexcept { return false; }
+	};
+
+	//Standard containers living in frame memory
+	template<typename T>
+	using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+	template<typename Key, typename Value, typename Compare = std::less<Key>>
+	using FrameMap = std::map<Key, Value, Compare, FrameStlAllocator<std::pair<const Key, Value>>>;
+	using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+}
@@ -0,0 +1,130 @@
+#include "FrameTimer.h"
+
+namespace KJK
+{
+	//Add the timing of a finished frame, overwriting the oldest one when full
+	void FrameTimeHistory::Push(const FrameTiming& timing)
+	{
+		m_Timings[m_Head] = timing;
+		m_Head = (m_Head + 1) % Capacity;
+		if (m_Size < Capacity)
+			m_Size++;
+	}
+
+	//Get a frame timing, where index 0 is the most recent frame
+	const FrameTiming& FrameTimeHistory::Get(size_t index) const
+	{
+		return m_Timings[(m_Head + Capacity - 1 - index) % Capacity];
+	}
+
+	float FrameTimeHistory::GetAverageFrameMs() const
+	{
+		if (m_Size == 0)
+			return 0.0f;
+
+		float total = 0.0f;
+		for (size_t i = 0; i < m_Size; i++)
+			total += Get(i).FrameMs;
+		return total / static_cast<float>(m_Size);
+	}
+
+	float FrameTimeHistory::GetMinFrameMs() const
+	{
+		if (m_Size == 0)
+			return 0.0f;
+
+		float minimum = Get(0).FrameMs;
+		for (size_t i = 1; i < m_Size; i++)
+			minimum = std::min(minimum, Get(i).FrameMs);
+		return minimum;
+	}
+
+	float FrameTimeHistory::GetMaxFrameMs() const
+	{
+		float maximum = 0.0f;
+		for (size_t i = 0; i < m_Size; i++)
+			maximum = std::max(maximum, Get(i).FrameMs);
+		return maximum;
+	}
+
+	FrameTimer::FrameTimer(const FrameTimerSettings& settings)
+		: m_Settings(settings)
+	{
+		Reset();
+	}
+
+	//Restart timing from the current time, dropping any accumulated simulation time
+	void FrameTimer::Reset()
+	{
+		m_FrameStartNs = Clock::GetTimeNs();
+		m_DeltaTime = Timestep(0.0);
+		m_Accumulator = 0.0;
+		m_SimulationTime = 0.0;
+		m_FixedStepsThisFrame = 0;
+		m_FrameCount = 0;
+	}
+
+	//Start a new frame, measuring the time since the previous one and feeding the accumulator
+	Timestep FrameTimer::BeginFrame()
+	{
+		uint64_t now = Clock::GetTimeNs();
+		m_DeltaTime = Timestep(Clock::NsToSeconds(now - m_FrameStartNs));
+		m_FrameStartNs = now;
+		m_FrameCount++;
+
+		//Feed the accumulator, clamping it so a long hitch doesn't queue up an unbounded amount of steps
+		m_Accumulator += m_DeltaTime.GetSeconds();
+		double maxAccumulated = m_Settings.FixedTimestep * m_Settings.MaxFixedStepsPerFrame;
+		if (m_Accumulator > maxAccumulated)
+			m_Accumulator = maxAccumulated;
+
+		m_FixedStepsThisFrame = 0;
+
+		return m_DeltaTime;
+	}
+
+	//Consume one fixed step from the accumulator, returns false once no full steps remain
+	bool FrameTimer::StepFixed()
+	{
+		if (m_Accumulator < m_Settings.FixedTimestep || m_FixedStepsThisFrame >= m_Settings.MaxFixedStepsPerFrame)
+			return false;
+
+		m_Accumulator -= m_Settings.FixedTimestep;
+		m_SimulationTime += m_Settings.FixedTimestep;
+		m_FixedStepsThisFrame++;
+		return true;
+	}
+
+	//Finish the frame, recording its timings and waiting to honour the frame rate cap
+	void FrameTimer::EndFrame()
+	{
+		FrameTiming timing;
+		timing.FixedSteps = m_FixedStepsThisFrame;
+
+		uint64_t workEndNs = Clock::GetTimeNs();
+		timing.WorkMs = static_cast<float>(Clock::NsToSeconds(workEndNs - m_FrameStartNs) * 1000.0);
+
+		//Wait out the remainder of the frame budget if a cap is set
+		if (m_Settings.MaxFrameRate > 0.0)
+		{
+			uint64_t targetNs = m_FrameStartNs + Clock::SecondsToNs(1.0 / m_Settings.MaxFrameRate);
+			Clock::WaitUntil(targetNs, Clock::SecondsToNs(m_Settings.SpinThreshold));
+		}
+
+		timing.FrameMs = static_cast<float>(Clock::NsToSeconds(Clock::GetTimeNs() - m_FrameStartNs) * 1000.0);
+		m_History.Push(timing);
+	}
+
+	//Setter for the frame rate cap, 0 disables the cap
+	void FrameTimer::SetMaxFrameRate(double framesPerSecond)
+	{
+		m_Settings.MaxFrameRate = framesPerSecond > 0.0 ? framesPerSecond : 0.0;
+	}
+
+	//Setter for the fixed simulation step
+	void FrameTimer::SetFixedTimestep(double seconds)
+	{
+		if (seconds > 0.0)
+			m_Settings.FixedTimestep = seconds;
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Clock.h"
+#include "Timestep.h"
+
+namespace KJK
+{
+	//Settings controlling the main loop timing
+	struct FrameTimerSettings
+	{
+		//Length of a single fixed simulation step in seconds
+		double FixedTimestep = 1.0 / 60.0;
+		//Maximum number of fixed steps run in a single frame, prevents a spiral of death after a hitch
+		unsigned int MaxFixedStepsPerFrame = 8;
+		//Frame rate cap in frames per second, 0 disables the cap
+		double MaxFrameRate = 0.0;
+		//Time before the frame deadline at which pacing switches from sleeping to spinning
+		double SpinThreshold = 0.002;
+	};
+
+	//Timing information recorded for a single frame
+	struct FrameTiming
+	{
+		//Total time of the frame including pacing, in milliseconds
+		float FrameMs = 0.0f;
+		//Time spent doing work before pacing, in milliseconds
+		float WorkMs = 0.0f;
+		//Number of fixed steps run during the frame
+		unsigned int FixedSteps = 0;
+	};
+
+	//Ring buffer storing the timings of the most recent frames
+	class FrameTimeHistory
+	{
+	public:
+		//Number of frames kept in the history
+		static constexpr size_t Capacity = 256;
+
+		//Add the timing of a finished frame, overwriting the oldest one when full
+		void Push(const FrameTiming& timing);
+
+		//Get a frame timing, where index 0 is the most recent frame
+		const FrameTiming& Get(size_t index) const;
+
+		//Getter for the number of stored frames
+		inline size_t GetSize() const { return m_Size; }
+
+		//Statistics over the stored frames, in milliseconds
+		float GetAverageFrameMs() const;
+		float GetMinFrameMs() const;
+		float GetMaxFrameMs() const;
+	private:
+		std::array<FrameTiming, Capacity> m_Timings{};
+		//Index the next timing is written to
+		size_t m_Head = 0;
+		size_t m_Size = 0;
+	};
+
+	//Measures frame times, drives a fixed timestep accumulator and paces frames to a frame rate cap
+	class FrameTimer
+	{
+	public:
+		FrameTimer(const FrameTimerSettings& settings = FrameTimerSettings());
+
+		//Restart timing from the current time, dropping any accumulated simulation time
+		void Reset();
+
+		//Start a new frame, measuring the time since the previous one and feeding the accumulator
+		Timestep BeginFrame();
+
+		//Consume one fixed step from the accumulator, returns false once no full steps remain
+		bool StepFixed();
+
+		//Finish the frame, recording its timings and waiting to honour the frame rate cap
+		void EndFrame();
+
+		//Getter for the time between the start of the previous and the current frame
+		inline Timestep GetDeltaTime() const { return m_DeltaTime; }
+		//Getter for the fixed simulation step
+		inline Timestep GetFixedTimestep() const { return m_Settings.FixedTimestep; }
+		//Getter for the blend factor between the previous and the next fixed step, used for render interpolation
+		inline float GetAlpha() const { return static_cast<float>(m_Accumulator / m_Settings.FixedTimestep); }
+		//Getter for the total simulated time
+		inline double GetSimulationTime() const { return m_SimulationTime; }
+		//Getter for the number of frames started since the last reset
+		inline uint64_t GetFrameCount() const { return m_FrameCount; }
+
+		//Setter for the frame rate cap, 0 disables the cap
+		void SetMaxFrameRate(double framesPerSecond);
+		//Setter for the fixed simulation step
+		void SetFixedTimestep(double seconds);
+
+		//Getters for the settings and frame history
+		inline const FrameTimerSettings& GetSettings() const { return m_Settings; }
+		inline const FrameTimeHistory& GetHistory() const { return m_History; }
+	private:
+		FrameTimerSettings m_Settings;
+		FrameTimeHistory m_History;
+
+		//Start time of the current frame in nanoseconds
+		uint64_t m_FrameStartNs = 0;
+		//Time between the start of the previous and the current frame
+		Timestep m_DeltaTime;
+		//Simulation time not consumed by fixed steps yet, in seconds
+		double m_Accumulator = 0.0;
+		//Total simulated time in seconds
+		double m_SimulationTime = 0.0;
+
+		//Fixed steps run during the current frame
+		unsigned int m_FixedStepsThisFrame = 0;
+		uint64_t m_FrameCount = 0;
+	};
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace KJK
+{
+	//Starting value of an FNV-1a hash
+	constexpr uint64_t FNV1aOffsetBasis = 14695981039346656037ull;
+	//Multiplier applied after every byte
+	constexpr uint64_t FNV1aPrime = 1099511628211ull;
+
+	//FNV-1a over a block of bytes, continuing from a previous hash
+	//Fast for the short keys it's used on, not meant for untrusted input or hash tables that can't compare full keys
+	inline uint64_t HashFNV1a(const void* data, size_t size, uint64_t hash = FNV1aOffsetBasis)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash ^= bytes[i];
+			hash *= FNV1aPrime;
+		}
+		return hash;
+	}
+
+	//FNV-1a over a null terminated string, without the terminator
+	inline uint64_t HashFNV1a(const char* string, uint64_t hash = FNV1aOffsetBasis)
+	{
+		for (const char* c = string; *c != '\0'; c++)
+		{
+			hash ^= static_cast<uint8_t>(*c);
+			hash *= FNV1aPrime;
+		}
+		return hash;
+	}
+}
@@ -0,0 +1,189 @@
+#include "Input.h"
+
+#include "KJK_Engine/Core/Clock.h"
+#include "KJK_Engine/Core/Profiler.h"
+#include "KJK_Engine/Events/ApplicationEvent.h"
+#include "KJK_Engine/Events/KeyEvent.h"
+#include "KJK_Engine/Events/MouseEvent.h"
+
+#include <atomic>
+
+namespace KJK
+{
+	namespace
+	{
+		//State collected from the events of the current frame, only touched by the polling thread
+		InputSnapshot s_Pending;
+
+		//Published snapshots, the front one is read while the next frame is written into the other one
+		InputSnapshot s_Snapshots[2];
+		std::atomic<uint32_t> s_Front{ 0 };
+
+		//Copy a snapshot into the back slot and make it the front one
+		const InputSnapshot& Swap(const InputSnapshot& snapshot)
+		{
+			uint32_t back = 1 - s_Front.load(std::memory_order_relaxed);
+			s_Snapshots[back] = snapshot;
+
+			//Release so readers acquiring the new index see the whole snapshot
+			s_Front.store(back, std::memory_order_release);
+			return s_Snapshots[back];
+		}
+	}
+
+	int InputSnapshot::GetKeySlot(int scancode)
+	{
+		//SDL_SCANCODE_UNKNOWN is 0, events without a physical key don't get a slot
+		if (scancode > 0 && scancode < static_cast<int>(KeySlotCount))
+			return scancode;
+		return -1;
+	}
+
+	bool InputSnapshot::IsKeyDown(int scancode) const
+	{
+		int slot = GetKeySlot(scancode);
+		return slot >= 0 && KeysDown.test(slot);
+	}
+
+	bool InputSnapshot::IsKeyPressed(int scancode) const
+	{
+		int slot = GetKeySlot(scancode);
+		return slot >= 0 && KeysPressed.test(slot);
+	}
+
+	bool InputSnapshot::IsKeyReleased(int scancode) const
+	{
+		int slot = GetKeySlot(scancode);
+		return slot >= 0 && KeysReleased.test(slot);
+	}
+
+	void Input::OnEvent(const Event& event)
+	{
+		switch (event.GetEventType())
+		{
+		case EventType::KeyPressed:
+		{
+			const auto& key = static_cast<const KeyPressedEvent&>(event);
+			int slot = InputSnapshot::GetKeySlot(key.GetScanCode());
+			//Repeats keep the key down without a new press edge
+			if (slot >= 0 && !s_Pending.KeysDown.test(slot))
+			{
+				s_Pending.KeysDown.set(slot);
+				s_Pending.KeysPressed.set(slot);
+			}
+			break;
+		}
+		case EventType::KeyReleased:
+		{
+			int slot = InputSnapshot::GetKeySlot(static_cast<const KeyReleasedEvent&>(event).GetScanCode());
+			if (slot >= 0 && s_Pending.KeysDown.test(slot))
+			{
+				s_Pending.KeysDown.reset(slot);
+				s_Pending.KeysReleased.set(slot);
+			}
+			break;
+		}
+		case EventType::MouseButtonPressed:
+		{
+			int button = static_cast<const MouseButtonPressedEvent&>(event).GetMouseButton();
+			if (button >= 0 && button < 32)
+			{
+				uint32_t bit = 1u << button;
+				if ((s_Pending.ButtonsDown & bit) == 0)
+					s_Pending.ButtonsPressed |= bit;
+				s_Pending.ButtonsDown |= bit;
+			}
+			break;
+		}
+		case EventType::MouseButtonReleased:
+		{
+			int button = static_cast<const MouseButtonReleasedEvent&>(event).GetMouseButton();
+			if (button >= 0 && button < 32)
+			{
+				uint32_t bit = 1u << button;
+				if ((s_Pending.ButtonsDown & bit) != 0)
+					s_Pending.ButtonsReleased |= bit;
+				s_Pending.ButtonsDown &= ~bit;
+			}
+			break;
+		}
+		case EventType::MouseMoved:
+		{
+			const auto& mouse = static_cast<const MouseMovedEvent&>(event);
+			s_Pending.MousePosition = glm::vec2(mouse.GetX(), mouse.GetY());
+			s_Pending.MouseDelta += glm::vec2(mouse.GetDeltaX(), mouse.GetDeltaY());
+			break;
+		}
+		case EventType::MouseScrolled:
+		{
+			const auto& scroll = static_cast<const MouseScrolledEvent&>(event);
+			s_Pending.Scroll += glm::vec2(scroll.GetXOffset(), scroll.GetYOffset());
+			break;
+		}
+		case EventType::WindowLostFocus:
+			//The release events of keys held while the focus changes never arrive
+			ReleaseAll();
+			break;
+		default:
+			return;
+		}
+
+		uint64_t now = Clock::GetTimeNs();
+		if (s_Pending.EventCount == 0)
+			s_Pending.FirstEventNs = now;
+		s_Pending.LastEventNs = now;
+		s_Pending.EventCount++;
+	}
+
+	const InputSnapshot& Input::Publish()
+	{
+		KJK_PROFILE_FUNCTION();
+
+		const InputSnapshot& previous = GetSnapshot();
+		uint64_t now = Clock::GetTimeNs();
+		s_Pending.FrameIndex = previous.FrameIndex + 1;
+		s_Pending.DeltaNs = previous.TimeNs != 0 ? now - previous.TimeNs : 0;
+		s_Pending.TimeNs = now;
+
+		const InputSnapshot& published = Swap(s_Pending);
+
+		//Held keys and the mouse position carry over, edges and accumulated motion start over
+		s_Pending.KeysPressed.reset();
+		s_Pending.KeysReleased.reset();
+		s_Pending.ButtonsPressed = 0;
+		s_Pending.ButtonsReleased = 0;
+		s_Pending.MouseDelta = glm::vec2(0.0f);
+		s_Pending.Scroll = glm::vec2(0.0f);
+		s_Pending.FirstEventNs = 0;
+		s_Pending.LastEventNs = 0;
+		s_Pending.EventCount = 0;
+
+		return published;
+	}
+
+	const InputSnapshot& Input::Replay(const InputSnapshot& snapshot)
+	{
+		KJK_PROFILE_FUNCTION();
+
+		//Events fed meanwhile belong to the live input and are dropped, held keys follow the recording
+		s_Pending = InputSnapshot();
+		s_Pending.KeysDown = snapshot.KeysDown;
+		s_Pending.ButtonsDown = snapshot.ButtonsDown;
+		s_Pending.MousePosition = snapshot.MousePosition;
+
+		return Swap(snapshot);
+	}
+
+	const InputSnapshot& Input::GetSnapshot()
+	{
+		return s_Snapshots[s_Front.load(std::memory_order_acquire)];
+	}
+
+	void Input::ReleaseAll()
+	{
+		s_Pending.KeysReleased |= s_Pending.KeysDown;
+		s_Pending.KeysDown.reset();
+		s_Pending.ButtonsReleased |= s_Pending.ButtonsDown;
+		s_Pending.ButtonsDown = 0;
+	}
+}
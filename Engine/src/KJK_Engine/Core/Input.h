@@ -0,0 +1,80 @@
+#pragma once
+
+#include "KJK_Engine/Events/Event.h"
+
+#include <bitset>
+#include <cstdint>
+
+namespace KJK
+{
+	//Immutable input state of one frame, built from all input events that arrived before the frame started
+	//Plain values only, so a snapshot can be copied, recorded and replayed
+	struct InputSnapshot
+	{
+		//Number of key slots, one per scancode
+		//Keys are tracked by scancode since the key code of a key changes with the modifiers held, so its release could miss the slot of its press
+		static constexpr size_t KeySlotCount = SDL_SCANCODE_COUNT;
+
+		//Index of the frame the snapshot belongs to, counting published snapshots
+		uint64_t FrameIndex = 0;
+		//Time the snapshot was published and the time since the previous snapshot, in nanoseconds
+		uint64_t TimeNs = 0;
+		uint64_t DeltaNs = 0;
+		//Arrival times of the first and the last input event of the frame, 0 without events
+		uint64_t FirstEventNs = 0;
+		uint64_t LastEventNs = 0;
+		//Number of input events the snapshot was built from
+		uint32_t EventCount = 0;
+
+		//Keys held down at the start of the frame
+		std::bitset<KeySlotCount> KeysDown;
+		//Keys that went down or up since the previous frame, a short tap sets both
+		std::bitset<KeySlotCount> KeysPressed;
+		std::bitset<KeySlotCount> KeysReleased;
+
+		//Mouse buttons held down, pressed and released, bit N is button N
+		uint32_t ButtonsDown = 0;
+		uint32_t ButtonsPressed = 0;
+		uint32_t ButtonsReleased = 0;
+
+		//Last mouse position in window coordinates
+		glm::vec2 MousePosition{ 0.0f };
+		//Mouse motion and wheel scrolling accumulated over the frame
+		glm::vec2 MouseDelta{ 0.0f };
+		glm::vec2 Scroll{ 0.0f };
+
+		//Check the state of a key by its scancode
+		bool IsKeyDown(int scancode) const;
+		bool IsKeyPressed(int scancode) const;
+		bool IsKeyReleased(int scancode) const;
+
+		//Check the state of a mouse button
+		inline bool IsMouseButtonDown(int button) const { return button >= 0 && button < 32 && (ButtonsDown >> button) & 1u; }
+		inline bool IsMouseButtonPressed(int button) const { return button >= 0 && button < 32 && (ButtonsPressed >> button) & 1u; }
+		inline bool IsMouseButtonReleased(int button) const { return button >= 0 && button < 32 && (ButtonsReleased >> button) & 1u; }
+
+		//Map a scancode to its key slot, returns -1 for unknown scancodes
+		static int GetKeySlot(int scancode);
+	};
+
+	//Double buffered input state
+	//Events of a frame are collected into a pending state on the thread polling the window, and published at a frame boundary
+	//The published snapshot can be read from any thread and stays unchanged until the publish after next
+	class Input
+	{
+	public:
+		//Feed an input or window event, called from the thread polling the window
+		static void OnEvent(const Event& event);
+
+		//Publish the events fed since the last publish as the snapshot of the new frame
+		static const InputSnapshot& Publish();
+		//Publish a recorded snapshot instead of the fed events, for replaying input
+		static const InputSnapshot& Replay(const InputSnapshot& snapshot);
+
+		//Getter for the latest published snapshot
+		static const InputSnapshot& GetSnapshot();
+
+		//Release all keys and buttons, like when the window loses focus
+		static void ReleaseAll();
+	};
+}
@@ -0,0 +1,302 @@
+#include "JobSystem.h"
+
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/MemoryTracker.h"
+#include "KJK_Engine/Core/Profiler.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace KJK
+{
+	namespace
+	{
+		//Fixed capacity double-ended job queue owned by one thread
+		//The owner pushes and pops at the back, other threads steal from the front
+		class JobQueue
+		{
+		public:
+			//Maximum number of jobs queued on a single thread
+			static constexpr size_t Capacity = 4096;
+
+			JobQueue()
+				: m_Jobs(Capacity) {}
+
+			//Add a job at the back, returns false when the queue is full
+			bool Push(const Job& job)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_Size == Capacity)
+					return false;
+
+				m_Jobs[(m_Front + m_Size) % Capacity] = job;
+				m_Size++;
+				return true;
+			}
+
+			//Take the most recently pushed job, used by the owning thread
+			bool Pop(Job& job)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_Size == 0)
+					return false;
+
+				m_Size--;
+				job = m_Jobs[(m_Front + m_Size) % Capacity];
+				return true;
+			}
+
+			//Take the oldest job, used by other threads
+			bool Steal(Job& job)
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_Size == 0)
+					return false;
+
+				job = m_Jobs[m_Front];
+				m_Front = (m_Front + 1) % Capacity;
+				m_Size--;
+				return true;
+			}
+		private:
+			std::mutex m_Mutex;
+			std::vector<Job> m_Jobs;
+			size_t m_Front = 0;
+			size_t m_Size = 0;
+		};
+
+		//Index used by threads that are not part of the job system
+		constexpr uint32_t InvalidThreadIndex = UINT32_MAX;
+
+		//Index of the calling thread in the job system
+		thread_local uint32_t t_ThreadIndex = InvalidThreadIndex;
+
+		//Queue per thread, index 0 belongs to the thread that called Init
+		std::vector<std::unique_ptr<JobQueue>> s_Queues;
+		//Worker threads, the thread that called Init is not included
+		std::vector<std::thread> s_Workers;
+
+		//Running flag for the worker threads
+		std::atomic<bool> s_Running{ false };
+		//Number of jobs sitting in the queues, used to wake up sleeping workers
+		std::atomic<uint32_t> s_QueuedJobs{ 0 };
+		//Number of workers waiting on the wake condition
+		std::atomic<uint32_t> s_SleepingWorkers{ 0 };
+		//Round robin queue selection for threads outside of the job system
+		std::atomic<uint32_t> s_NextExternalQueue{ 0 };
+
+		//Synchronization for putting idle workers to sleep
+		std::mutex s_SleepMutex;
+		std::condition_variable s_WakeCondition;
+	}
+
+	//Start the worker threads, 0 uses one worker per hardware thread besides the calling one
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		if (s_Running)
+		{
+			KJK_CORE_WARN("Job system is already running!");
+			return;
+		}
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		KJK_MEMORY_SCOPE(MemoryCategory::Engine);
+
+		//Create a queue for every worker and for the calling thread
+		s_Queues.clear();
+		for (uint32_t i = 0; i < workerCount + 1; i++)
+		{
+			s_Queues.push_back(std::make_unique<JobQueue>());
+		}
+
+		//Register the calling thread
+		t_ThreadIndex = 0;
+		Profiler::SetThreadName("Main");
+		s_Running = true;
+
+		//Start the workers
+		for (uint32_t i = 1; i <= workerCount; i++)
+		{
+			s_Workers.emplace_back(WorkerLoop, i);
+		}
+
+		KJK_CORE_INFO("Initialized the job system with {0} worker threads", workerCount);
+	}
+
+	//Finish all queued jobs and join the worker threads
+	void JobSystem::Shutdown()
+	{
+		if (!s_Running)
+			return;
+
+		//Drain the remaining work on the calling thread
+		Job job;
+		while (TryGetJob(0, job))
+		{
+			Run(job);
+		}
+
+		//Stop and wake all workers
+		{
+			std::lock_guard<std::mutex> lock(s_SleepMutex);
+			s_Running = false;
+		}
+		s_WakeCondition.notify_all();
+
+		for (auto& worker : s_Workers)
+		{
+			worker.join();
+		}
+
+		s_Workers.clear();
+		s_Queues.clear();
+		t_ThreadIndex = InvalidThreadIndex;
+	}
+
+	//Wait until all jobs tracked by the counter are finished, running queued jobs in the meantime
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			//Help with the queued work instead of blocking
+			if (!RunPendingJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	//Run a single queued job on the calling thread, returns false if there was nothing to run
+	bool JobSystem::RunPendingJob()
+	{
+		if (!s_Running)
+			return false;
+
+		uint32_t threadIndex = t_ThreadIndex != InvalidThreadIndex ? t_ThreadIndex : 0;
+
+		Job job;
+		if (!TryGetJob(threadIndex, job))
+			return false;
+
+		Run(job);
+		return true;
+	}
+
+	//Getter for the number of threads executing jobs, including the thread that called Init
+	uint32_t JobSystem::GetThreadCount()
+	{
+		return s_Running ? static_cast<uint32_t>(s_Queues.size()) : 1;
+	}
+
+	//Getter for the index of the calling thread, 0 is the thread that called Init
+	uint32_t JobSystem::GetThreadIndex()
+	{
+		return t_ThreadIndex;
+	}
+
+	//Check if the worker threads are running
+	bool JobSystem::IsRunning()
+	{
+		return s_Running;
+	}
+
+	//Push a job to the queue of the calling thread, or run it inline when the system is not running
+	void JobSystem::Submit(const Job& job)
+	{
+		job.Counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+		if (!s_Running)
+		{
+			Run(job);
+			return;
+		}
+
+		//Threads outside of the job system spread their jobs over all queues
+		uint32_t queueIndex = t_ThreadIndex;
+		if (queueIndex == InvalidThreadIndex)
+			queueIndex = s_NextExternalQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(s_Queues.size());
+
+		//Run the job right away if the queue is full
+		if (!s_Queues[queueIndex]->Push(job))
+		{
+			Run(job);
+			return;
+		}
+
+		s_QueuedJobs.fetch_add(1);
+
+		//Wake up a sleeping worker to pick up the new job
+		if (s_SleepingWorkers.load() > 0)
+		{
+			//Taking the lock orders the wake up after a worker's last check of the queues
+			{
+				std::lock_guard<std::mutex> lock(s_SleepMutex);
+			}
+			s_WakeCondition.notify_one();
+		}
+	}
+
+	//Run a job and signal its counter
+	void JobSystem::Run(const Job& job)
+	{
+		job.Invoke(job);
+		job.Counter->m_Pending.fetch_sub(1, std::memory_order_release);
+	}
+
+	//Pop a job from the given thread's queue or steal one from another thread
+	bool JobSystem::TryGetJob(uint32_t threadIndex, Job& job)
+	{
+		uint32_t queueCount = static_cast<uint32_t>(s_Queues.size());
+
+		//Prefer the thread's own most recent job, it is the most likely to be in cache
+		if (s_Queues[threadIndex]->Pop(job))
+		{
+			s_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		//Steal the oldest job from the other threads
+		for (uint32_t i = 1; i < queueCount; i++)
+		{
+			if (s_Queues[(threadIndex + i) % queueCount]->Steal(job))
+			{
+				s_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//Main loop of a worker thread
+	void JobSystem::WorkerLoop(uint32_t threadIndex)
+	{
+		t_ThreadIndex = threadIndex;
+		Profiler::SetThreadName("Worker " + std::to_string(threadIndex));
+
+		while (s_Running)
+		{
+			Job job;
+			if (TryGetJob(threadIndex, job))
+			{
+				Run(job);
+				continue;
+			}
+
+			//Sleep until new jobs are queued or the system shuts down
+			std::unique_lock<std::mutex> lock(s_SleepMutex);
+			s_SleepingWorkers.fetch_add(1);
+			s_WakeCondition.wait(lock, []
+			{
+				return !s_Running || s_QueuedJobs.load() > 0;
+			});
+			s_SleepingWorkers.fetch_sub(1);
+		}
+	}
+}
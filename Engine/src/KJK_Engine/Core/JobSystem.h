@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace KJK
+{
+	//Counter tracking the completion of a group of jobs, used as a wait handle
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+
+		//Disable copy semantics, jobs keep a pointer to the counter
+		JobCounter(const JobCounter& other) = delete;
+		JobCounter& operator=(const JobCounter& other) = delete;
+
+		//Check if all jobs tracked by the counter have finished
+		inline bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+		//Getter for the number of unfinished jobs
+		inline uint32_t GetPending() const { return m_Pending.load(std::memory_order_acquire); }
+	private:
+		friend class JobSystem;
+
+		//Number of jobs that have not finished yet
+		std::atomic<uint32_t> m_Pending{ 0 };
+	};
+
+	//Unit of work stored by value in the job queues
+	struct Job
+	{
+		//Size of the inline storage for the job's callable
+		static constexpr size_t StorageSize = 64;
+
+		//Function invoking the callable stored in the job
+		void (*Invoke)(const Job& job) = nullptr;
+		//Counter decremented once the job has finished
+		JobCounter* Counter = nullptr;
+		//Inline storage for the callable, avoids a heap allocation per job
+		alignas(16) unsigned char Storage[StorageSize];
+	};
+
+	//Work-stealing thread pool, each worker owns a deque and steals from the others when it runs dry
+	class JobSystem
+	{
+	public:
+		//Start the worker threads, 0 uses one worker per hardware thread besides the calling one
+		static void Init(uint32_t workerCount = 0);
+		//Finish all queued jobs and join the worker threads
+		static void Shutdown();
+
+		//Run a callable on the job system, counter is incremented now and decremented when it finishes
+		template<typename F>
+		static void Execute(JobCounter& counter, const F& func)
+		{
+			static_assert(std::is_trivially_copyable_v<F>, "Job callables must be trivially copyable, capture by reference or pointer");
+			static_assert(sizeof(F) <= Job::StorageSize, "Job callable is too large, capture by reference or pointer");
+
+			Job job;
+			job.Counter = &counter;
+			new (job.Storage) F(func);
+			job.Invoke = [](const Job& self)
+			{
+				(*std::launder(reinterpret_cast<const F*>(self.Storage)))();
+			};
+
+			Submit(job);
+		}
+
+		//Split the range [0, count) into batches and run func(index) for every index across the workers
+		//The jobs refer to func, it has to stay alive until the counter was waited on
+		template<typename F>
+		static void ParallelFor(JobCounter& counter, uint32_t count, uint32_t batchSize, const F& func)
+		{
+			if (batchSize == 0)
+				batchSize = 1;
+
+			for (uint32_t begin = 0; begin < count; begin += batchSize)
+			{
+				uint32_t end = begin + batchSize < count ? begin + batchSize : count;
+				Execute(counter, [&func, begin, end]()
+				{
+					for (uint32_t i = begin; i < end; i++)
+						func(i);
+				});
+			}
+		}
+
+		//A temporary callable would be destroyed while the jobs still refer to it, use the blocking overload or a named callable
+		template<typename F>
+		static void ParallelFor(JobCounter& counter, uint32_t count, uint32_t batchSize, const F&& func) = delete;
+
+		//Blocking overload of ParallelFor, the calling thread helps with the work until the range is done
+		template<typename F>
+		static void ParallelFor(uint32_t count, uint32_t batchSize, const F& func)
+		{
+			JobCounter counter;
+			ParallelFor(counter, count, batchSize, func);
+			Wait(counter);
+		}
+
+		//Wait until all jobs tracked by the counter are finished, running queued jobs in the meantime
+		static void Wait(const JobCounter& counter);
+		//Run a single queued job on the calling thread, returns false if there was nothing to run
+		static bool RunPendingJob();
+
+		//Getter for the number of threads executing jobs, including the thread that called Init
+		static uint32_t GetThreadCount();
+		//Getter for the index of the calling thread, 0 is the thread that called Init
+		static uint32_t GetThreadIndex();
+		//Check if the worker threads are running
+		static bool IsRunning();
+	private:
+		//Push a job to the queue of the calling thread, or run it inline when the system is not running
+		static void Submit(const Job& job);
+		//Run a job and signal its counter
+		static void Run(const Job& job);
+		//Pop a job from the given thread's queue or steal one from another thread
+		static bool TryGetJob(uint32_t threadIndex, Job& job);
+		//Main loop of a worker thread
+		static void WorkerLoop(uint32_t threadIndex);
+	};
+}
@@ -1,5 +1,7 @@
 #include "Logger.h"
 
+#include "spdlog/async.h"
+#include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
 
 namespace KJK
@@ -8,18 +10,97 @@ namespace KJK
 	std::shared_ptr<spdlog::logger> Logger::s_CoreLogger;
 	std::shared_ptr<spdlog::logger> Logger::s_ClientLogger;
 
+	namespace
+	{
+		//Log pattern shared by all sinks
+		const char* s_LogPattern = "%^[%l][%t][%D %H:%M:%S.%e][%n]: %v%$ [%s:%#]";
+
+		//Create a logger writing to the given sinks, either synchronously or through the shared thread pool
+		std::shared_ptr<spdlog::logger> CreateLogger(const std::string& name, const std::vector<spdlog::sink_ptr>& sinks, const LoggerSettings& settings)
+		{
+			std::shared_ptr<spdlog::logger> logger;
+			if (settings.Async)
+			{
+				spdlog::async_overflow_policy policy = settings.OverflowPolicy == LogOverflowPolicy::Block
+					? spdlog::async_overflow_policy::block
+					: spdlog::async_overflow_policy::overrun_oldest;
+				logger = std::make_shared<spdlog::async_logger>(name, sinks.begin(), sinks.end(), spdlog::thread_pool(), policy);
+			}
+			else
+			{
+				logger = std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
+			}
+
+			//Set the log pattern
+			logger->set_pattern(s_LogPattern);
+			logger->set_level(settings.Level);
+			//Errors are written out right away so they aren't lost on a crash
+			logger->flush_on(spdlog::level::err);
+			spdlog::register_logger(logger);
+			return logger;
+		}
+	}
+
 	//Initialize the loggers used in the engine and client application
-	void Logger::Init()
+	void Logger::Init(const LoggerSettings& settings)
 	{
-		//Set the log pattern
-		spdlog::set_pattern("%^[%l][%t][%D %H:%M:%S.%e][%n]: %v%$ [%s:%#]");
+		//Create the sinks shared by both loggers
+		std::vector<spdlog::sink_ptr> sinks;
+		if (settings.ConsoleOutput)
+			sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+		if (!settings.FilePath.empty())
+			sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(settings.FilePath, true));
+
+		//Preallocate the message queue and start the flush thread
+		if (settings.Async)
+			spdlog::init_thread_pool(settings.QueueSize, 1);
 
 		//Define the logger used in the engine
-		s_CoreLogger = spdlog::stdout_color_mt("KJK_ENGINE");
-		s_CoreLogger->set_level(spdlog::level::trace);
+		s_CoreLogger = CreateLogger("KJK_ENGINE", sinks, settings);
 
 		//Define the logger used in the client application
-		s_ClientLogger = spdlog::stdout_color_mt("APP");
-		s_ClientLogger->set_level(spdlog::level::trace);
+		s_ClientLogger = CreateLogger("APP", sinks, settings);
+
+		//Write buffered file output regularly
+		if (!settings.FilePath.empty())
+			spdlog::flush_every(std::chrono::seconds(1));
+
+		if (settings.Async)
+			KJK_CORE_INFO("Initialized asynchronous logging with a queue of {0} messages", settings.QueueSize);
+	}
+
+	//Flush all queued messages and stop the flush thread, the loggers can't be used afterwards
+	void Logger::Shutdown()
+	{
+		//Nothing to flush if Init never ran or failed
+		if (!s_CoreLogger || !s_ClientLogger)
+			return;
+
+		if (size_t dropped = GetDroppedCount())
+			KJK_CORE_WARN("Dropped {0} log messages because the log queue was full", dropped);
+
+		s_CoreLogger->flush();
+		s_ClientLogger->flush();
+
+		//Joins the flush thread after it has written out the remaining messages
+		spdlog::shutdown();
+	}
+
+	//Change the level of a logger at runtime
+	void Logger::SetCoreLevel(spdlog::level::level_enum level)
+	{
+		s_CoreLogger->set_level(level);
+	}
+
+	void Logger::SetClientLevel(spdlog::level::level_enum level)
+	{
+		s_ClientLogger->set_level(level);
+	}
+
+	//Getter for the number of messages dropped because the async queue was full
+	size_t Logger::GetDroppedCount()
+	{
+		std::shared_ptr<spdlog::details::thread_pool> threadPool = spdlog::thread_pool();
+		return threadPool ? threadPool->overrun_counter() : 0;
 	}
-}
\ No newline at end of file
+}
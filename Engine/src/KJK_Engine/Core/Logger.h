@@ -1,19 +1,54 @@
 #pragma once
 
+//Compile in every level, the loggers filter at runtime so tracing can be enabled without rebuilding
 #ifndef SPDLOG_ACTIVE_LEVEL
-	#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+	#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
 #endif
 #include "spdlog/spdlog.h"
 #include "spdlog/fmt/ostr.h" //Allows logging custom types
 
 namespace KJK
 {
+	//What an asynchronous logger does when its message queue is full
+	enum class LogOverflowPolicy
+	{
+		//Wait until the flush thread makes room, no message is lost
+		Block = 0,
+		//Drop the oldest queued message and count it, logging never stalls the caller
+		DropOldest
+	};
+
+	//Settings for initializing the loggers
+	struct LoggerSettings
+	{
+		//Format and write messages on a dedicated thread instead of the calling thread
+		bool Async = false;
+		//Number of messages preallocated in the async queue
+		size_t QueueSize = 8192;
+		//Behaviour of the async queue when it's full
+		LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::Block;
+		//Write to the colored console
+		bool ConsoleOutput = true;
+		//Also write to this file when not empty
+		std::string FilePath;
+		//Initial level of both loggers
+		spdlog::level::level_enum Level = spdlog::level::info;
+	};
+
 	//Logger class for engine and client logging
 	class Logger
 	{
 	public:
 		//Initialize the loggers
-		static void Init();
+		static void Init(const LoggerSettings& settings = LoggerSettings());
+		//Flush all queued messages and stop the flush thread, the loggers can't be used afterwards
+		static void Shutdown();
+
+		//Change the level of a logger at runtime
+		static void SetCoreLevel(spdlog::level::level_enum level);
+		static void SetClientLevel(spdlog::level::level_enum level);
+		//Getter for the number of messages dropped because the async queue was full
+		static size_t GetDroppedCount();
 
 		//Getters for the loggers
 		inline static std::shared_ptr<spdlog::logger>& GetCoreLogger() { return s_CoreLogger; }
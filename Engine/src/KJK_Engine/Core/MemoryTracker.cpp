@@ -0,0 +1,417 @@
+#include "MemoryTracker.h"
+
+#include "KJK_Engine/Core/Logger.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace KJK
+{
+	namespace
+	{
+		//Per category counters, updated from operator new and delete on any thread
+		struct CategoryCounters
+		{
+			std::atomic<int64_t> CpuBytes{ 0 };
+			std::atomic<int64_t> CpuPeakBytes{ 0 };
+			std::atomic<int64_t> CpuAllocations{ 0 };
+			std::atomic<uint64_t> CpuTotalAllocations{ 0 };
+		};
+
+		//Estimated size and category of a live GPU resource
+		struct GpuResource
+		{
+			MemoryCategory Category;
+			size_t Bytes;
+		};
+
+		constexpr const char* s_CategoryNames[] =
+		{
+			"General",
+			"Engine",
+			"Events",
+			"Models",
+			"Meshes",
+			"Textures",
+			"Shaders",
+			"Framebuffers",
+			"Buffers"
+		};
+		static_assert(std::size(s_CategoryNames) == static_cast<size_t>(MemoryCategory::Count), "Every memory category needs a name");
+
+		//Constant initialized so allocations made before main are counted too
+		CategoryCounters s_Counters[static_cast<size_t>(MemoryCategory::Count)];
+		thread_local MemoryCategory t_Category = MemoryCategory::General;
+
+		//Guards the GPU resources, which are only tracked from the thread owning the OpenGL context
+		std::mutex s_GpuMutex;
+		std::unordered_map<uint64_t, GpuResource> s_GpuResources;
+
+		//Combine the resource type and the OpenGL name into a map key
+		uint64_t GpuResourceKey(GpuResourceType type, uint32_t id)
+		{
+			return (static_cast<uint64_t>(type) << 32) | id;
+		}
+
+		const char* GpuResourceTypeName(GpuResourceType type)
+		{
+			switch (type)
+			{
+			case GpuResourceType::Texture: return "texture";
+			case GpuResourceType::Buffer: return "buffer";
+			case GpuResourceType::Renderbuffer: return "renderbuffer";
+			}
+			return "resource";
+		}
+
+		//Format a byte count for the report
+		std::string FormatBytes(int64_t bytes)
+		{
+			if (bytes >= 1024 * 1024 || bytes <= -1024 * 1024)
+				return fmt::format("{0:.2f} MiB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+			if (bytes >= 1024 || bytes <= -1024)
+				return fmt::format("{0:.2f} KiB", static_cast<double>(bytes) / 1024.0);
+			return fmt::format("{0} B", bytes);
+		}
+
+		//Sum the live GPU resources per category, the mutex has to be held
+		void SumGpuResources(int64_t (&bytes)[static_cast<size_t>(MemoryCategory::Count)], int64_t (&counts)[static_cast<size_t>(MemoryCategory::Count)])
+		{
+			for (const auto& [key, resource] : s_GpuResources)
+			{
+				bytes[static_cast<size_t>(resource.Category)] += static_cast<int64_t>(resource.Bytes);
+				counts[static_cast<size_t>(resource.Category)]++;
+			}
+		}
+	}
+
+	//Log the final report and warn about GPU resources that were never released
+	void MemoryTracker::Shutdown()
+	{
+		LogReport();
+
+		std::lock_guard<std::mutex> lock(s_GpuMutex);
+		if (s_GpuResources.empty())
+			return;
+
+		KJK_CORE_WARN("{0} GPU resources were never released:", s_GpuResources.size());
+		for (const auto& [key, resource] : s_GpuResources)
+		{
+			KJK_CORE_WARN("  {0} {1} in {2}, {3}", GpuResourceTypeName(static_cast<GpuResourceType>(key >> 32)),
+				static_cast<uint32_t>(key), GetCategoryName(resource.Category), FormatBytes(static_cast<int64_t>(resource.Bytes)));
+		}
+	}
+
+	//Record a GPU resource, tracking an existing resource again replaces its size and category
+	void MemoryTracker::TrackGpuResource(GpuResourceType type, uint32_t id, MemoryCategory category, size_t bytes)
+	{
+		if (id == 0)
+			return;
+
+		//The map nodes are bookkeeping of the tracker itself
+		KJK_MEMORY_SCOPE(MemoryCategory::Engine);
+		std::lock_guard<std::mutex> lock(s_GpuMutex);
+		s_GpuResources[GpuResourceKey(type, id)] = GpuResource{ category, bytes };
+	}
+
+	//Forget a GPU resource when it's deleted, unknown resources are ignored
+	void MemoryTracker::ReleaseGpuResource(GpuResourceType type, uint32_t id)
+	{
+		std::lock_guard<std::mutex> lock(s_GpuMutex);
+		s_GpuResources.erase(GpuResourceKey(type, id));
+	}
+
+	//Estimate the size of a texture in bytes, including the full mip chain when requested
+	size_t MemoryTracker::EstimateTextureSize(uint32_t width, uint32_t height, uint32_t bytesPerPixel, bool mipmaps, uint32_t layers, uint32_t samples)
+	{
+		size_t bytes = static_cast<size_t>(width) * height * bytesPerPixel;
+
+		//Every level halves both sides down to 1x1
+		while (mipmaps && width > 0 && height > 0 && (width > 1 || height > 1))
+		{
+			width = std::max(width / 2, 1u);
+			height = std::max(height / 2, 1u);
+			bytes += static_cast<size_t>(width) * height * bytesPerPixel;
+		}
+
+		return bytes * layers * samples;
+	}
+
+	//Getter for the memory accounted to a category
+	MemoryCategoryStats MemoryTracker::GetCategoryStats(MemoryCategory category)
+	{
+		const CategoryCounters& counters = s_Counters[static_cast<size_t>(category)];
+
+		MemoryCategoryStats stats;
+		stats.CpuBytes = counters.CpuBytes.load(std::memory_order_relaxed);
+		stats.CpuPeakBytes = counters.CpuPeakBytes.load(std::memory_order_relaxed);
+		stats.CpuAllocations = counters.CpuAllocations.load(std::memory_order_relaxed);
+		stats.CpuTotalAllocations = counters.CpuTotalAllocations.load(std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lock(s_GpuMutex);
+		for (const auto& [key, resource] : s_GpuResources)
+		{
+			if (resource.Category != category)
+				continue;
+			stats.GpuBytes += static_cast<int64_t>(resource.Bytes);
+			stats.GpuResources++;
+		}
+		return stats;
+	}
+
+	//Getter for the display name of a category
+	const char* MemoryTracker::GetCategoryName(MemoryCategory category)
+	{
+		size_t index = static_cast<size_t>(category);
+		return index < std::size(s_CategoryNames) ? s_CategoryNames[index] : "Unknown";
+	}
+
+	//Log the memory of every category
+	void MemoryTracker::LogReport()
+	{
+		constexpr size_t categoryCount = static_cast<size_t>(MemoryCategory::Count);
+		int64_t gpuBytes[categoryCount] = {};
+		int64_t gpuCounts[categoryCount] = {};
+		{
+			std::lock_guard<std::mutex> lock(s_GpuMutex);
+			SumGpuResources(gpuBytes, gpuCounts);
+		}
+
+#if !KJK_ENABLE_MEMORY_TRACKING
+		KJK_CORE_INFO("Heap tracking is disabled, only GPU resources are reported");
+#endif
+
+		int64_t cpuTotal = 0;
+		int64_t gpuTotal = 0;
+		KJK_CORE_INFO("Memory report:");
+		for (size_t i = 0; i < categoryCount; i++)
+		{
+			const CategoryCounters& counters = s_Counters[i];
+			int64_t cpuBytes = counters.CpuBytes.load(std::memory_order_relaxed);
+			cpuTotal += cpuBytes;
+			gpuTotal += gpuBytes[i];
+
+			KJK_CORE_INFO("  {0:<12} CPU {1:>12} in {2:>7} allocations (peak {3}, {4} total), GPU {5:>12} in {6} resources",
+				s_CategoryNames[i], FormatBytes(cpuBytes), counters.CpuAllocations.load(std::memory_order_relaxed),
+				FormatBytes(counters.CpuPeakBytes.load(std::memory_order_relaxed)), counters.CpuTotalAllocations.load(std::memory_order_relaxed),
+				FormatBytes(gpuBytes[i]), gpuCounts[i]);
+		}
+		KJK_CORE_INFO("  {0:<12} CPU {1:>12}, GPU {2:>12}", "Total", FormatBytes(cpuTotal), FormatBytes(gpuTotal));
+	}
+
+	//Getter for the category of the calling thread's allocations
+	MemoryCategory MemoryTracker::GetThreadCategory()
+	{
+		return t_Category;
+	}
+
+	//Setter for the category of the calling thread's allocations
+	void MemoryTracker::SetThreadCategory(MemoryCategory category)
+	{
+		t_Category = category;
+	}
+}
+
+#if KJK_ENABLE_MEMORY_TRACKING
+
+#if defined(KJK_PLATFORM_WINDOWS)
+	#include <malloc.h>
+#endif
+
+//Global operator new and delete replacements, linked in with this file whenever the application references MemoryTracker
+//SDL, assimp and other C allocations through malloc aren't counted
+//Blocks are plain CRT allocations without a header, so memory may be freed by a module using the default operator delete and the other way around
+namespace
+{
+	//Alignment passed for the forms of new and delete without an alignment argument
+	constexpr size_t s_DefaultAlignment = 0;
+	//Number of independently locked parts of the allocation table, a power of two
+	constexpr size_t s_AllocationShardCount = 64;
+
+	//Size and category of a live allocation, so its free is accounted to the category it was allocated in
+	struct AllocationRecord
+	{
+		size_t Size;
+		KJK::MemoryCategory Category;
+	};
+
+	//Allocator of the allocation table, goes to malloc directly so recording an allocation doesn't allocate through operator new again
+	template<typename T>
+	struct UntrackedAllocator
+	{
+		using value_type = T;
+
+		UntrackedAllocator() = default;
+		template<typename U>
+		UntrackedAllocator(const UntrackedAllocator<U>&) noexcept {}
+
+		T* allocate(size_t count)
+		{
+			if (void* pointer = std::malloc(count * sizeof(T)))
+				return static_cast<T*>(pointer);
+			throw std::bad_alloc();
+		}
+
+		void deallocate(T* pointer, size_t) noexcept { std::free(pointer); }
+
+		template<typename U>
+		bool operator==(const UntrackedAllocator<U>&) const noexcept { return true; }
+	};
+
+	//Part of the table of live allocations, split so allocating threads rarely wait on each other
+	struct AllocationShard
+	{
+		std::mutex Mutex;
+		std::unordered_map<void*, AllocationRecord, std::hash<void*>, std::equal_to<void*>, UntrackedAllocator<std::pair<void* const, AllocationRecord>>> Records;
+	};
+
+	//Shard of the table a block is recorded in
+	AllocationShard& GetAllocationShard(void* pointer) noexcept
+	{
+		//Built on first use so allocations made before main are recorded, and never destroyed so frees after exit still find it
+		alignas(AllocationShard) static unsigned char storage[sizeof(AllocationShard) * s_AllocationShardCount];
+		static AllocationShard* shards = []()
+		{
+			AllocationShard* created = reinterpret_cast<AllocationShard*>(storage);
+			for (size_t i = 0; i < s_AllocationShardCount; i++)
+				new (&created[i]) AllocationShard();
+			return created;
+		}();
+
+		//Blocks are at least 16 byte aligned, the low bits carry no information
+		return shards[(reinterpret_cast<uintptr_t>(pointer) >> 4) & (s_AllocationShardCount - 1)];
+	}
+
+	void ReleaseBlock(void* pointer, size_t alignment) noexcept
+	{
+#if defined(KJK_PLATFORM_WINDOWS)
+		//Aligned blocks come from _aligned_malloc like in the default operator new
+		if (alignment != s_DefaultAlignment)
+		{
+			_aligned_free(pointer);
+			return;
+		}
+#endif
+		std::free(pointer);
+	}
+
+	void* TrackedAllocate(size_t size, size_t alignment) noexcept
+	{
+		//malloc(0) may return a null pointer, but new has to return a unique one
+		size = std::max<size_t>(size, 1);
+
+		void* pointer = nullptr;
+		if (alignment == s_DefaultAlignment)
+			pointer = std::malloc(size);
+		else
+		{
+#if defined(KJK_PLATFORM_WINDOWS)
+			pointer = _aligned_malloc(size, alignment);
+#else
+			//posix_memalign needs at least pointer alignment, the block is freed with free like any other
+			if (posix_memalign(&pointer, std::max(alignment, sizeof(void*)), size) != 0)
+				pointer = nullptr;
+#endif
+		}
+		if (!pointer)
+			return nullptr;
+
+		KJK::MemoryCategory category = KJK::t_Category;
+		try
+		{
+			AllocationShard& shard = GetAllocationShard(pointer);
+			std::lock_guard<std::mutex> lock(shard.Mutex);
+			shard.Records[pointer] = AllocationRecord{ size, category };
+		}
+		catch (...)
+		{
+			//Out of memory for the record, fail the allocation instead of losing track of it
+			ReleaseBlock(pointer, alignment);
+			return nullptr;
+		}
+
+		KJK::CategoryCounters& counters = KJK::s_Counters[static_cast<size_t>(category)];
+		int64_t bytes = counters.CpuBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+		int64_t peak = counters.CpuPeakBytes.load(std::memory_order_relaxed);
+		while (bytes > peak && !counters.CpuPeakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+		{
+		}
+		counters.CpuAllocations.fetch_add(1, std::memory_order_relaxed);
+		counters.CpuTotalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+		return pointer;
+	}
+
+	//Throwing allocation as required by the non nothrow operator new forms
+	void* TrackedAllocateOrThrow(size_t size, size_t alignment)
+	{
+		//Retry through the new handler like the default operator new
+		for (;;)
+		{
+			if (void* pointer = TrackedAllocate(size, alignment))
+				return pointer;
+
+			std::new_handler handler = std::get_new_handler();
+			if (!handler)
+				throw std::bad_alloc();
+			handler();
+		}
+	}
+
+	void TrackedFree(void* pointer, size_t alignment) noexcept
+	{
+		if (!pointer)
+			return;
+
+		//The free is accounted to the category the block was allocated in, on any thread and in any scope
+		//Blocks another module allocated with the default operator new were never counted and aren't recorded
+		AllocationRecord record{};
+		bool recorded = false;
+		{
+			AllocationShard& shard = GetAllocationShard(pointer);
+			std::lock_guard<std::mutex> lock(shard.Mutex);
+			auto it = shard.Records.find(pointer);
+			if (it != shard.Records.end())
+			{
+				record = it->second;
+				recorded = true;
+				shard.Records.erase(it);
+			}
+		}
+
+		if (recorded)
+		{
+			KJK::CategoryCounters& counters = KJK::s_Counters[static_cast<size_t>(record.Category)];
+			counters.CpuBytes.fetch_sub(static_cast<int64_t>(record.Size), std::memory_order_relaxed);
+			counters.CpuAllocations.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		ReleaseBlock(pointer, alignment);
+	}
+}
+
+void* operator new(size_t size) { return TrackedAllocateOrThrow(size, s_DefaultAlignment); }
+void* operator new[](size_t size) { return TrackedAllocateOrThrow(size, s_DefaultAlignment); }
+void* operator new(size_t size, std::align_val_t alignment) { return TrackedAllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return TrackedAllocateOrThrow(size, static_cast<size_t>(alignment)); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, s_DefaultAlignment); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return TrackedAllocate(size, s_DefaultAlignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return TrackedAllocate(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void* pointer) noexcept { TrackedFree(pointer, s_DefaultAlignment); }
+void operator delete[](void* pointer) noexcept { TrackedFree(pointer, s_DefaultAlignment); }
+void operator delete(void* pointer, size_t) noexcept { TrackedFree(pointer, s_DefaultAlignment); }
+void operator delete[](void* pointer, size_t) noexcept { TrackedFree(pointer, s_DefaultAlignment); }
+void operator delete(void* pointer, std::align_val_t alignment) noexcept { TrackedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept { TrackedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete(void* pointer, size_t, std::align_val_t alignment) noexcept { TrackedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete[](void* pointer, size_t, std::align_val_t alignment) noexcept { TrackedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { TrackedFree(pointer, s_DefaultAlignment); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { TrackedFree(pointer, s_DefaultAlignment); }
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept { TrackedFree(pointer, static_cast<size_t>(alignment)); }
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept { TrackedFree(pointer, static_cast<size_t>(alignment)); }
+
+#endif
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//Heap allocations are tracked unless disabled explicitly or building for minimum size
+#ifndef KJK_ENABLE_MEMORY_TRACKING
+	#ifdef KJK_MINSIZE
+		#define KJK_ENABLE_MEMORY_TRACKING 0
+	#else
+		#define KJK_ENABLE_MEMORY_TRACKING 1
+	#endif
+#endif
+
+namespace KJK
+{
+	//Subsystems memory is accounted to
+	enum class MemoryCategory : uint8_t
+	{
+		General = 0,
+		//Core systems like the job system, frame allocator and logger
+		Engine,
+		Events,
+		Models,
+		Meshes,
+		Textures,
+		Shaders,
+		Framebuffers,
+		//Uniform, instance and other standalone GPU buffers
+		Buffers,
+		Count
+	};
+
+	//Kinds of OpenGL objects holding GPU memory
+	enum class GpuResourceType : uint8_t
+	{
+		Texture = 0,
+		Buffer,
+		Renderbuffer
+	};
+
+	//Memory accounted to a category
+	struct MemoryCategoryStats
+	{
+		//Live heap bytes and the highest amount seen
+		int64_t CpuBytes = 0;
+		int64_t CpuPeakBytes = 0;
+		//Live heap allocations and the number made in total
+		int64_t CpuAllocations = 0;
+		uint64_t CpuTotalAllocations = 0;
+		//Estimated bytes and number of live GPU resources
+		int64_t GpuBytes = 0;
+		int64_t GpuResources = 0;
+	};
+
+	//Accounting of heap allocations and estimated GPU memory per category
+	//Heap allocations are tagged with the category of the innermost MemoryScope on the allocating thread
+	//Frees are accounted to the category the block was allocated in, whichever thread or scope frees it
+	class MemoryTracker
+	{
+	public:
+		//Log the final report and warn about GPU resources that were never released
+		static void Shutdown();
+
+		//Record a GPU resource, tracking an existing resource again replaces its size and category
+		static void TrackGpuResource(GpuResourceType type, uint32_t id, MemoryCategory category, size_t bytes);
+		//Forget a GPU resource when it's deleted, unknown resources are ignored
+		static void ReleaseGpuResource(GpuResourceType type, uint32_t id);
+
+		//Estimate the size of a texture in bytes, including the full mip chain when requested
+		static size_t EstimateTextureSize(uint32_t width, uint32_t height, uint32_t bytesPerPixel, bool mipmaps, uint32_t layers = 1, uint32_t samples = 1);
+
+		//Getter for the memory accounted to a category
+		static MemoryCategoryStats GetCategoryStats(MemoryCategory category);
+		//Getter for the display name of a category
+		static const char* GetCategoryName(MemoryCategory category);
+
+		//Log the memory of every category
+		static void LogReport();
+
+		//Getter and setter for the category of the calling thread's allocations, used by MemoryScope
+		static MemoryCategory GetThreadCategory();
+		static void SetThreadCategory(MemoryCategory category);
+	};
+
+	//Tags the heap allocations made by the calling thread in a scope with a category
+	class MemoryScope
+	{
+	public:
+		inline MemoryScope(MemoryCategory category)
+			: m_Previous(MemoryTracker::GetThreadCategory())
+		{
+			MemoryTracker::SetThreadCategory(category);
+		}
+
+		inline ~MemoryScope()
+		{
+			MemoryTracker::SetThreadCategory(m_Previous);
+		}
+
+		//Disable copy semantics
+		MemoryScope(const MemoryScope& other) = delete;
+		MemoryScope& operator=(const MemoryScope& other) = delete;
+	private:
+		MemoryCategory m_Previous;
+	};
+}
+
+#if KJK_ENABLE_MEMORY_TRACKING
+	#define KJK_MEMORY_CONCAT_IMPL(a, b) a##b
+	#define KJK_MEMORY_CONCAT(a, b) KJK_MEMORY_CONCAT_IMPL(a, b)
+
+	//Account the heap allocations made in the rest of the current scope to a category
+	#define KJK_MEMORY_SCOPE(category) ::KJK::MemoryScope KJK_MEMORY_CONCAT(kjkMemoryScope, __LINE__)(category)
+#else
+	#define KJK_MEMORY_SCOPE(category)
+#endif
@@ -0,0 +1,338 @@
+#include "Profiler.h"
+
+#include "KJK_Engine/Core/Clock.h"
+#include "KJK_Engine/Core/Logger.h"
+
+#include <iomanip>
+#include <mutex>
+
+namespace KJK
+{
+	std::atomic<bool> Profiler::s_Capturing{ false };
+
+	namespace
+	{
+		//Number of markers stored in a single buffer
+		constexpr uint32_t s_EventsPerChunk = 4096;
+		//Number of buffers a thread may fill during one capture before markers are dropped
+		constexpr uint32_t s_MaxChunksPerThread = 256;
+
+		//Finished marker
+		struct ProfileEvent
+		{
+			const char* Name;
+			uint64_t StartNs;
+			uint64_t EndNs;
+			//Number of enclosing markers on the same thread
+			uint32_t Depth;
+		};
+
+		//Buffer of markers recorded by a single thread, reused across captures
+		struct EventChunk
+		{
+			ProfileEvent Events[s_EventsPerChunk];
+			//Number of finished markers, read by the exporting thread
+			std::atomic<uint32_t> Count{ 0 };
+			//Capture the markers belong to
+			std::atomic<uint32_t> Generation{ 0 };
+			//Next buffer of the same thread
+			std::atomic<EventChunk*> Next{ nullptr };
+		};
+
+		//Recording state of a thread
+		struct ThreadProfile
+		{
+			//First and currently written buffer, only the owning thread moves the tail
+			EventChunk* Head = nullptr;
+			EventChunk* Tail = nullptr;
+			//Number of buffers used in the current capture
+			uint32_t ChunkCount = 0;
+			//Capture the buffers currently hold
+			uint32_t Generation = 0;
+			//Id of the thread in the exported traces
+			uint32_t ThreadId = 0;
+			std::string Name;
+		};
+
+		//Guards the thread list and the capture state below
+		std::mutex s_Mutex;
+		std::vector<std::unique_ptr<ThreadProfile>> s_Threads;
+
+		//Index of the current frame
+		std::atomic<uint64_t> s_FrameIndex{ 0 };
+
+		//Requested or running capture
+		bool s_CapturePending = false;
+		std::string s_CapturePath;
+		uint64_t s_CaptureFirstFrame = 0;
+		uint64_t s_CaptureEndFrame = 0;
+		uint64_t s_CaptureStartNs = 0;
+		//Start times of the captured frames
+		std::vector<std::pair<uint64_t, uint64_t>> s_FrameStarts;
+		//Id of the running capture, buffers holding an older id are reset before use
+		std::atomic<uint32_t> s_Generation{ 0 };
+		//Markers dropped in the running capture because a thread filled all its buffers
+		std::atomic<uint64_t> s_DroppedEvents{ 0 };
+		//Number of shutdowns, the recording state of threads registered before the last shutdown was released
+		std::atomic<uint32_t> s_Session{ 0 };
+
+		//Recording state of the calling thread and the session it was registered in
+		thread_local ThreadProfile* t_Profile = nullptr;
+		thread_local uint32_t t_Session = 0;
+		//Number of open markers on the calling thread
+		thread_local uint32_t t_Depth = 0;
+
+		//Getter for the recording state of the calling thread, registers the thread on first use and again after a shutdown
+		ThreadProfile& GetThreadProfile()
+		{
+			if (!t_Profile || t_Session != s_Session.load(std::memory_order_acquire))
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				t_Session = s_Session.load(std::memory_order_relaxed);
+				auto profile = std::make_unique<ThreadProfile>();
+				profile->Head = new EventChunk;
+				profile->Tail = profile->Head;
+				profile->ThreadId = static_cast<uint32_t>(s_Threads.size());
+				profile->Name = "Thread " + std::to_string(profile->ThreadId);
+				t_Profile = profile.get();
+				s_Threads.push_back(std::move(profile));
+			}
+			return *t_Profile;
+		}
+
+		//Prepare a buffer for the markers of a capture
+		void ResetChunk(EventChunk& chunk, uint32_t generation)
+		{
+			chunk.Generation.store(generation, std::memory_order_relaxed);
+			chunk.Count.store(0, std::memory_order_release);
+		}
+
+		//Write a string as a JSON string literal
+		void WriteJsonString(std::ostream& stream, const char* value)
+		{
+			stream << '"';
+			for (const char* c = value; *c; c++)
+			{
+				if (*c == '"' || *c == '\\')
+					stream << '\\' << *c;
+				else if (static_cast<unsigned char>(*c) < 0x20)
+					stream << ' ';
+				else
+					stream << *c;
+			}
+			stream << '"';
+		}
+
+		//Convert a time point to microseconds since the start of the capture
+		double ToCaptureUs(uint64_t timeNs)
+		{
+			return static_cast<double>(static_cast<int64_t>(timeNs - s_CaptureStartNs)) / 1000.0;
+		}
+	}
+
+	//Release all recorded data, an unfinished capture is exported first
+	void Profiler::Shutdown()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (IsCapturing())
+			FinishCapture();
+		s_CapturePending = false;
+
+		for (const std::unique_ptr<ThreadProfile>& profile : s_Threads)
+		{
+			EventChunk* chunk = profile->Head;
+			while (chunk)
+			{
+				EventChunk* next = chunk->Next.load(std::memory_order_relaxed);
+				delete chunk;
+				chunk = next;
+			}
+		}
+		s_Threads.clear();
+
+		//Other threads only clear their pointer into the released buffers the next time they record
+		s_Session.fetch_add(1, std::memory_order_release);
+		t_Profile = nullptr;
+	}
+
+	//Mark the start of a new frame, starts and finishes the requested captures
+	void Profiler::BeginFrame()
+	{
+		uint64_t frame = s_FrameIndex.fetch_add(1, std::memory_order_relaxed) + 1;
+
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (IsCapturing() && frame >= s_CaptureEndFrame)
+			FinishCapture();
+
+		if (s_CapturePending && frame >= s_CaptureFirstFrame)
+		{
+			s_CapturePending = false;
+			s_FrameStarts.clear();
+			s_DroppedEvents.store(0, std::memory_order_relaxed);
+			s_CaptureStartNs = Clock::GetTimeNs();
+			s_Generation.fetch_add(1, std::memory_order_release);
+			s_Capturing.store(true, std::memory_order_release);
+		}
+
+		if (IsCapturing())
+			s_FrameStarts.emplace_back(frame, Clock::GetTimeNs());
+	}
+
+	//Getter for the index of the current frame
+	uint64_t Profiler::GetFrameIndex()
+	{
+		return s_FrameIndex.load(std::memory_order_relaxed);
+	}
+
+	//Request a capture of frameCount frames starting at firstFrame, written to path as Chrome trace JSON when finished
+	void Profiler::RequestCapture(const std::string& path, uint64_t firstFrame, uint32_t frameCount)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		if (IsCapturing() || s_CapturePending)
+		{
+			KJK_CORE_WARN("A profiler capture is already running, ignoring the request for {0}", path);
+			return;
+		}
+		if (frameCount == 0)
+			return;
+
+		s_CapturePending = true;
+		s_CapturePath = path;
+		s_CaptureFirstFrame = firstFrame;
+		s_CaptureEndFrame = firstFrame + frameCount;
+		KJK_CORE_INFO("Capturing frames {0} to {1} to {2}", firstFrame, s_CaptureEndFrame - 1, path);
+	}
+
+	//Set the name the calling thread is shown with in the exported traces
+	void Profiler::SetThreadName(const std::string& name)
+	{
+		ThreadProfile& profile = GetThreadProfile();
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		profile.Name = name;
+	}
+
+	//Record a finished marker of the calling thread
+	void Profiler::RecordEvent(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth)
+	{
+		ThreadProfile& profile = GetThreadProfile();
+
+		//Start over in the first buffer when a new capture began
+		uint32_t generation = s_Generation.load(std::memory_order_acquire);
+		if (profile.Generation != generation)
+		{
+			profile.Generation = generation;
+			profile.Tail = profile.Head;
+			profile.ChunkCount = 1;
+			ResetChunk(*profile.Head, generation);
+		}
+
+		EventChunk* chunk = profile.Tail;
+		uint32_t count = chunk->Count.load(std::memory_order_relaxed);
+		if (count == s_EventsPerChunk)
+		{
+			//Move on to the next buffer, allocating it if no earlier capture needed it
+			EventChunk* next = chunk->Next.load(std::memory_order_relaxed);
+			if (!next)
+			{
+				if (profile.ChunkCount >= s_MaxChunksPerThread)
+				{
+					s_DroppedEvents.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+				next = new EventChunk;
+				chunk->Next.store(next, std::memory_order_release);
+			}
+			ResetChunk(*next, generation);
+			profile.Tail = next;
+			profile.ChunkCount++;
+			chunk = next;
+			count = 0;
+		}
+
+		chunk->Events[count] = { name, startNs, endNs, depth };
+		chunk->Count.store(count + 1, std::memory_order_release);
+	}
+
+	//Stop the running capture and write it to its file, the mutex has to be held
+	void Profiler::FinishCapture()
+	{
+		s_Capturing.store(false, std::memory_order_release);
+
+		uint64_t exportStartNs = Clock::GetTimeNs();
+		uint32_t generation = s_Generation.load(std::memory_order_relaxed);
+
+		std::ofstream file(s_CapturePath, std::ios::trunc);
+		if (!file)
+		{
+			KJK_CORE_ERROR("Failed to open the profiler capture file {0}!", s_CapturePath);
+			return;
+		}
+
+		file << std::fixed << std::setprecision(3);
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+		//Name the threads
+		bool first = true;
+		for (const std::unique_ptr<ThreadProfile>& profile : s_Threads)
+		{
+			file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << profile->ThreadId << ",\"args\":{\"name\":";
+			WriteJsonString(file, profile->Name.c_str());
+			file << "}}";
+			first = false;
+		}
+
+		//Mark the frame boundaries
+		for (const auto& [frame, startNs] : s_FrameStarts)
+		{
+			file << (first ? "" : ",\n") << "{\"name\":\"Frame " << frame << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":0,\"tid\":0,\"ts\":" << ToCaptureUs(startNs) << "}";
+			first = false;
+		}
+
+		//Markers of every thread, threads may still be appending so only the published count is read
+		size_t eventCount = 0;
+		for (const std::unique_ptr<ThreadProfile>& profile : s_Threads)
+		{
+			for (EventChunk* chunk = profile->Head; chunk; chunk = chunk->Next.load(std::memory_order_acquire))
+			{
+				uint32_t count = chunk->Count.load(std::memory_order_acquire);
+				if (chunk->Generation.load(std::memory_order_relaxed) != generation)
+					break;
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					const ProfileEvent& event = chunk->Events[i];
+					file << (first ? "" : ",\n") << "{\"name\":";
+					WriteJsonString(file, event.Name);
+					file << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":0,\"tid\":" << profile->ThreadId
+						<< ",\"ts\":" << ToCaptureUs(event.StartNs) << ",\"dur\":" << static_cast<double>(event.EndNs - event.StartNs) / 1000.0
+						<< ",\"args\":{\"depth\":" << event.Depth << "}}";
+					first = false;
+				}
+				eventCount += count;
+			}
+		}
+
+		file << "\n]}\n";
+		file.close();
+
+		KJK_CORE_INFO("Wrote {0} profiler markers of {1} frames to {2} in {3:.1f} ms", eventCount, s_FrameStarts.size(), s_CapturePath, Clock::NsToSeconds(Clock::GetTimeNs() - exportStartNs) * 1000.0);
+		if (uint64_t dropped = s_DroppedEvents.load(std::memory_order_relaxed))
+			KJK_CORE_WARN("Profiler dropped {0} markers, the per thread buffers were full", dropped);
+	}
+
+	//Start the marker, only called while capturing
+	void ProfileScope::Begin(const char* name)
+	{
+		m_Name = name;
+		t_Depth++;
+		m_StartNs = Clock::GetTimeNs();
+	}
+
+	//Finish the marker and record it
+	void ProfileScope::End()
+	{
+		uint64_t endNs = Clock::GetTimeNs();
+		t_Depth--;
+		Profiler::RecordEvent(m_Name, m_StartNs, endNs, t_Depth);
+	}
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+//Profiler markers are compiled in unless disabled explicitly or building for minimum size
+#ifndef KJK_ENABLE_PROFILER
+	#ifdef KJK_MINSIZE
+		#define KJK_ENABLE_PROFILER 0
+	#else
+		#define KJK_ENABLE_PROFILER 1
+	#endif
+#endif
+
+namespace KJK
+{
+	//Hierarchical CPU profiler recording scoped markers into per thread buffers
+	//Markers are only recorded while a capture is running, captures cover a range of frames and are exported as Chrome trace JSON
+	class Profiler
+	{
+	public:
+		//Release all recorded data, an unfinished capture is exported first
+		//No other thread may be recording a marker during the call, threads recording afterwards register again
+		static void Shutdown();
+
+		//Mark the start of a new frame, starts and finishes the requested captures
+		static void BeginFrame();
+		//Getter for the index of the current frame
+		static uint64_t GetFrameIndex();
+
+		//Request a capture of frameCount frames starting at firstFrame, written to path as Chrome trace JSON when finished
+		static void RequestCapture(const std::string& path, uint64_t firstFrame, uint32_t frameCount);
+		//Check if markers are currently recorded
+		inline static bool IsCapturing() { return s_Capturing.load(std::memory_order_relaxed); }
+
+		//Set the name the calling thread is shown with in the exported traces
+		static void SetThreadName(const std::string& name);
+	private:
+		friend class ProfileScope;
+
+		//Record a finished marker of the calling thread
+		static void RecordEvent(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth);
+		//Stop the running capture and write it to its file
+		static void FinishCapture();
+
+		//Recording flag
+		static std::atomic<bool> s_Capturing;
+	};
+
+	//Marker measuring the lifetime of a scope, the name has to outlive the capture
+	class ProfileScope
+	{
+	public:
+		inline ProfileScope(const char* name)
+		{
+			if (Profiler::IsCapturing())
+				Begin(name);
+		}
+
+		inline ~ProfileScope()
+		{
+			if (m_Name)
+				End();
+		}
+
+		//Disable copy semantics
+		ProfileScope(const ProfileScope& other) = delete;
+		ProfileScope& operator=(const ProfileScope& other) = delete;
+	private:
+		//Start and finish the marker, only called while capturing
+		void Begin(const char* name);
+		void End();
+
+		const char* m_Name = nullptr;
+		uint64_t m_StartNs = 0;
+	};
+}
+
+#if KJK_ENABLE_PROFILER
+	#if defined(_MSC_VER)
+		#define KJK_PROFILE_FUNCTION_NAME __FUNCTION__
+	#else
+		#define KJK_PROFILE_FUNCTION_NAME __PRETTY_FUNCTION__
+	#endif
+
+	#define KJK_PROFILE_CONCAT_IMPL(a, b) a##b
+	#define KJK_PROFILE_CONCAT(a, b) KJK_PROFILE_CONCAT_IMPL(a, b)
+
+	//Profile the rest of the current scope under the given name
+	#define KJK_PROFILE_SCOPE(name) ::KJK::ProfileScope KJK_PROFILE_CONCAT(kjkProfileScope, __LINE__)(name)
+	//Profile the rest of the current function under its name
+	#define KJK_PROFILE_FUNCTION() KJK_PROFILE_SCOPE(KJK_PROFILE_FUNCTION_NAME)
+#else
+	#define KJK_PROFILE_SCOPE(name)
+	#define KJK_PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,216 @@
+#include "Stats.h"
+
+#include "KJK_Engine/Core/Logger.h"
+
+#include <cmath>
+#include <mutex>
+
+namespace KJK
+{
+	//Add the value of a finished frame, overwriting the oldest one when full
+	void StatHistory::Push(float value)
+	{
+		m_Values[m_Head] = value;
+		m_Head = (m_Head + 1) % Capacity;
+		if (m_Size < Capacity)
+			m_Size++;
+	}
+
+	//Get a value, where index 0 is the most recent frame
+	float StatHistory::Get(size_t index) const
+	{
+		return m_Values[(m_Head + Capacity - 1 - index) % Capacity];
+	}
+
+	//Copy the values oldest first into a buffer of at least GetSize() elements, returns the number of values
+	size_t StatHistory::CopyOrdered(float* values) const
+	{
+		for (size_t i = 0; i < m_Size; i++)
+			values[i] = Get(m_Size - 1 - i);
+		return m_Size;
+	}
+
+	//Compute the percentiles over the stored frames
+	StatSummary StatHistory::Summarize() const
+	{
+		StatSummary summary;
+		if (m_Size == 0)
+			return summary;
+
+		std::array<float, Capacity> sorted;
+		CopyOrdered(sorted.data());
+		std::sort(sorted.begin(), sorted.begin() + m_Size);
+
+		double total = 0.0;
+		for (size_t i = 0; i < m_Size; i++)
+			total += sorted[i];
+
+		//Nearest rank percentile, the smallest value that at least the given share of frames doesn't exceed
+		auto percentile = [&](double share)
+		{
+			size_t rank = static_cast<size_t>(std::ceil(share * static_cast<double>(m_Size)));
+			return sorted[std::clamp<size_t>(rank, 1, m_Size) - 1];
+		};
+
+		summary.Last = Get(0);
+		summary.Min = sorted[0];
+		summary.Mean = static_cast<float>(total / static_cast<double>(m_Size));
+		summary.P50 = percentile(0.50);
+		summary.P95 = percentile(0.95);
+		summary.P99 = percentile(0.99);
+		summary.Max = sorted[m_Size - 1];
+		summary.SampleCount = m_Size;
+		return summary;
+	}
+
+	namespace
+	{
+		//Registered stat with its history
+		struct StatEntry
+		{
+			std::string Name;
+			StatType Type;
+			StatCounter Counter;
+			StatGauge Gauge;
+			StatHistory History;
+		};
+
+		//Guards the registry and the histories, never taken by Add or Set
+		std::mutex s_Mutex;
+		//Stats in creation order, entries are never moved or destroyed
+		std::vector<std::unique_ptr<StatEntry>> s_Stats;
+		std::unordered_map<std::string, StatEntry*> s_StatsByName;
+		uint64_t s_FrameCount = 0;
+
+		//Find or create a stat, the mutex has to be held
+		StatEntry& FindOrCreate(const std::string& name, StatType type)
+		{
+			auto it = s_StatsByName.find(name);
+			if (it != s_StatsByName.end())
+			{
+				if (it->second->Type != type)
+					KJK_CORE_WARN("Stat {0} is used as both a counter and a gauge!", name);
+				return *it->second;
+			}
+
+			auto entry = std::make_unique<StatEntry>();
+			entry->Name = name;
+			entry->Type = type;
+			StatEntry& result = *entry;
+			s_StatsByName.emplace(name, entry.get());
+			s_Stats.push_back(std::move(entry));
+			return result;
+		}
+	}
+
+	//Log the summary of every stat, the stats stay valid for call sites that still hold references
+	void Stats::Shutdown()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		for (const std::unique_ptr<StatEntry>& stat : s_Stats)
+		{
+			StatSummary summary = stat->History.Summarize();
+			KJK_CORE_INFO("{0}: mean {1:.3f}, p50 {2:.3f}, p95 {3:.3f}, p99 {4:.3f}, max {5:.3f} over {6} frames",
+				stat->Name, summary.Mean, summary.P50, summary.P95, summary.P99, summary.Max, summary.SampleCount);
+		}
+	}
+
+	//Get the counter with the given name, creating it on first use
+	StatCounter& Stats::GetCounter(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return FindOrCreate(name, StatType::Counter).Counter;
+	}
+
+	//Get the gauge with the given name, creating it on first use
+	StatGauge& Stats::GetGauge(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return FindOrCreate(name, StatType::Gauge).Gauge;
+	}
+
+	//Record the values of the finished frame into the histories and reset the counters, called once per frame
+	void Stats::EndFrame()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		for (const std::unique_ptr<StatEntry>& stat : s_Stats)
+		{
+			if (stat->Type == StatType::Counter)
+			{
+				uint64_t value = stat->Counter.m_Value.exchange(0, std::memory_order_relaxed);
+				stat->Counter.m_Total += value;
+				stat->History.Push(static_cast<float>(value));
+			}
+			else
+			{
+				stat->History.Push(static_cast<float>(stat->Gauge.GetValue()));
+			}
+		}
+		s_FrameCount++;
+	}
+
+	//Getter for the number of frames recorded so far
+	uint64_t Stats::GetFrameCount()
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		return s_FrameCount;
+	}
+
+	//Visit all stats in the order they were created
+	void Stats::ForEach(const VisitFn& visitor)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		for (const std::unique_ptr<StatEntry>& stat : s_Stats)
+			visitor(stat->Name, stat->Type, stat->History);
+	}
+
+	//Getter for the summary of a stat, returns an empty summary for unknown stats
+	StatSummary Stats::GetSummary(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		auto it = s_StatsByName.find(name);
+		if (it == s_StatsByName.end())
+			return StatSummary();
+		return it->second->History.Summarize();
+	}
+
+	//Write the recorded per frame values of all stats to a CSV file, one row per frame
+	bool Stats::ExportCsv(const std::string& path)
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+		{
+			KJK_CORE_ERROR("Failed to open the stats file {0}!", path);
+			return false;
+		}
+
+		//Header with the stat names, quoted in case they contain separators
+		file << "Frame";
+		size_t rowCount = 0;
+		for (const std::unique_ptr<StatEntry>& stat : s_Stats)
+		{
+			file << ",\"" << stat->Name << '"';
+			rowCount = std::max(rowCount, stat->History.GetSize());
+		}
+		file << '\n';
+
+		//Oldest frame first, stats created later have no values for the earlier frames
+		for (size_t row = rowCount; row > 0; row--)
+		{
+			size_t age = row - 1;
+			file << s_FrameCount - age;
+			for (const std::unique_ptr<StatEntry>& stat : s_Stats)
+			{
+				file << ',';
+				if (age < stat->History.GetSize())
+					file << stat->History.Get(age);
+			}
+			file << '\n';
+		}
+
+		KJK_CORE_INFO("Exported {0} frames of {1} stats to {2}", rowCount, s_Stats.size(), path);
+		return true;
+	}
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace KJK
+{
+	//Kinds of values tracked by the stats registry
+	enum class StatType
+	{
+		//Summed during a frame, for example draw calls
+		Counter = 0,
+		//Last value set during a frame, for example the frame time
+		Gauge
+	};
+
+	//Counter that can be incremented from any thread, its sum is recorded and reset at the end of every frame
+	class StatCounter
+	{
+	public:
+		//Add to the value of the current frame
+		inline void Add(uint64_t value = 1) { m_Value.fetch_add(value, std::memory_order_relaxed); }
+
+		//Getter for the value accumulated in the current frame
+		inline uint64_t GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+		//Getter for the sum over all finished frames
+		inline uint64_t GetTotal() const { return m_Total; }
+	private:
+		friend class Stats;
+
+		std::atomic<uint64_t> m_Value{ 0 };
+		uint64_t m_Total = 0;
+	};
+
+	//Value that can be set from any thread, its latest value is recorded at the end of every frame
+	class StatGauge
+	{
+	public:
+		//Set the current value
+		inline void Set(double value) { m_Value.store(value, std::memory_order_relaxed); }
+
+		//Getter for the current value
+		inline double GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+	private:
+		std::atomic<double> m_Value{ 0.0 };
+	};
+
+	//Percentiles and extremes of a stat over its recorded frames
+	struct StatSummary
+	{
+		float Last = 0.0f;
+		float Min = 0.0f;
+		float Mean = 0.0f;
+		float P50 = 0.0f;
+		float P95 = 0.0f;
+		float P99 = 0.0f;
+		float Max = 0.0f;
+		//Number of frames the summary covers
+		size_t SampleCount = 0;
+	};
+
+	//Ring buffer storing the per frame values of a stat over a rolling window
+	class StatHistory
+	{
+	public:
+		//Number of frames kept in the history
+		static constexpr size_t Capacity = 1024;
+
+		//Add the value of a finished frame, overwriting the oldest one when full
+		void Push(float value);
+
+		//Get a value, where index 0 is the most recent frame
+		float Get(size_t index) const;
+		//Copy the values oldest first into a buffer of at least GetSize() elements, returns the number of values
+		size_t CopyOrdered(float* values) const;
+
+		//Getter for the number of stored frames
+		inline size_t GetSize() const { return m_Size; }
+
+		//Compute the percentiles over the stored frames
+		StatSummary Summarize() const;
+	private:
+		std::array<float, Capacity> m_Values{};
+		//Index the next value is written to
+		size_t m_Head = 0;
+		size_t m_Size = 0;
+	};
+
+	//Central registry of named counters and gauges
+	//Stats are created on first use and never destroyed, so references to them can be kept
+	class Stats
+	{
+	public:
+		//Function type for visiting the registered stats
+		using VisitFn = std::function<void(const std::string& name, StatType type, const StatHistory& history)>;
+
+		//Log the summary of every stat, the stats stay valid for call sites that still hold references
+		static void Shutdown();
+
+		//Get the counter with the given name, creating it on first use
+		static StatCounter& GetCounter(const std::string& name);
+		//Get the gauge with the given name, creating it on first use
+		static StatGauge& GetGauge(const std::string& name);
+
+		//Record the values of the finished frame into the histories and reset the counters, called once per frame
+		static void EndFrame();
+		//Getter for the number of frames recorded so far
+		static uint64_t GetFrameCount();
+
+		//Visit all stats in the order they were created
+		static void ForEach(const VisitFn& visitor);
+		//Getter for the summary of a stat, returns an empty summary for unknown stats
+		static StatSummary GetSummary(const std::string& name);
+
+		//Write the recorded per frame values of all stats to a CSV file, one row per frame
+		static bool ExportCsv(const std::string& path);
+	};
+}
+
+#ifdef KJK_MINSIZE
+	#define KJK_STAT_ADD(name, value)
+	#define KJK_STAT_SET(name, value)
+#else
+	//Add to a named counter, the counter is looked up once per call site
+	#define KJK_STAT_ADD(name, value) \
+		do \
+		{ \
+			static ::KJK::StatCounter& kjkStatCounter = ::KJK::Stats::GetCounter(name); \
+			kjkStatCounter.Add(value); \
+		} while (false)
+
+	//Set a named gauge, the gauge is looked up once per call site
+	#define KJK_STAT_SET(name, value) \
+		do \
+		{ \
+			static ::KJK::StatGauge& kjkStatGauge = ::KJK::Stats::GetGauge(name); \
+			kjkStatGauge.Set(value); \
+		} while (false)
+#endif
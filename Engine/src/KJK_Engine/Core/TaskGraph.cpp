@@ -0,0 +1,190 @@
+#include "TaskGraph.h"
+
+#include "KJK_Engine/Core/Clock.h"
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/Profiler.h"
+
+#include <thread>
+
+namespace KJK
+{
+	//Add a task to the graph, only allowed before Compile
+	TaskGraph::TaskHandle TaskGraph::AddTask(const char* name, const TaskFn& function, TaskAffinity affinity)
+	{
+		if (m_Compiled)
+		{
+			KJK_CORE_ERROR("Can't add task {0} to a compiled task graph!", name);
+			return UINT32_MAX;
+		}
+
+		Task task;
+		task.Name = name;
+		task.Function = function;
+		task.Affinity = affinity;
+		m_Tasks.push_back(std::move(task));
+		return static_cast<TaskHandle>(m_Tasks.size() - 1);
+	}
+
+	//Declare that a task may only start once another task has finished
+	void TaskGraph::AddDependency(TaskHandle task, TaskHandle dependsOn)
+	{
+		if (m_Compiled || task >= m_Tasks.size() || dependsOn >= m_Tasks.size() || task == dependsOn)
+		{
+			KJK_CORE_ERROR("Invalid task graph dependency {0} -> {1}!", dependsOn, task);
+			return;
+		}
+
+		m_Tasks[dependsOn].Dependents.push_back(task);
+		m_Tasks[task].DependencyCount++;
+	}
+
+	//Validate the graph and allocate all execution state, returns false if the graph has a cycle
+	bool TaskGraph::Compile()
+	{
+		uint32_t taskCount = GetTaskCount();
+
+		//Walk the graph in topological order, tasks that are never reached are part of a cycle
+		std::vector<uint32_t> remaining(taskCount);
+		std::vector<TaskHandle> ready;
+		m_RootTasks.clear();
+		for (TaskHandle i = 0; i < taskCount; i++)
+		{
+			remaining[i] = m_Tasks[i].DependencyCount;
+			if (remaining[i] == 0)
+			{
+				ready.push_back(i);
+				m_RootTasks.push_back(i);
+			}
+		}
+
+		uint32_t visited = 0;
+		while (!ready.empty())
+		{
+			TaskHandle task = ready.back();
+			ready.pop_back();
+			visited++;
+
+			for (TaskHandle dependent : m_Tasks[task].Dependents)
+			{
+				if (--remaining[dependent] == 0)
+					ready.push_back(dependent);
+			}
+		}
+
+		if (visited != taskCount)
+		{
+			KJK_CORE_ERROR("Task graph contains a dependency cycle!");
+			return false;
+		}
+
+		//Allocate the execution state once so executing never allocates
+		m_Remaining = std::make_unique<std::atomic<uint32_t>[]>(taskCount);
+		m_MainThreadQueue = std::make_unique<std::atomic<uint32_t>[]>(taskCount);
+		m_Timings.resize(taskCount);
+		for (TaskHandle i = 0; i < taskCount; i++)
+		{
+			m_Timings[i].Name = m_Tasks[i].Name;
+		}
+
+		m_Compiled = true;
+		return true;
+	}
+
+	//Run all tasks once, the calling thread runs the main thread tasks and helps with the rest
+	void TaskGraph::Execute()
+	{
+		if (!m_Compiled)
+		{
+			KJK_CORE_ERROR("Task graph has to be compiled before it's executed!");
+			return;
+		}
+
+		uint32_t taskCount = GetTaskCount();
+
+		//Reset the execution state
+		for (TaskHandle i = 0; i < taskCount; i++)
+		{
+			m_Remaining[i].store(m_Tasks[i].DependencyCount, std::memory_order_relaxed);
+			m_MainThreadQueue[i].store(0, std::memory_order_relaxed);
+		}
+		m_MainThreadWrite.store(0, std::memory_order_relaxed);
+		m_MainThreadRead = 0;
+		m_Finished.store(0, std::memory_order_relaxed);
+		m_ExecuteStartNs = Clock::GetTimeNs();
+
+		//Start the tasks without dependencies
+		for (TaskHandle task : m_RootTasks)
+		{
+			Schedule(task);
+		}
+
+		while (m_Finished.load(std::memory_order_acquire) < taskCount)
+		{
+			//Run the next ready main thread task
+			if (m_MainThreadRead < taskCount)
+			{
+				uint32_t slot = m_MainThreadQueue[m_MainThreadRead].load(std::memory_order_acquire);
+				if (slot != 0)
+				{
+					m_MainThreadRead++;
+					RunTask(slot - 1);
+					continue;
+				}
+			}
+
+			//Help the workers with the other tasks
+			if (!JobSystem::RunPendingJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		//Make sure no job is still touching the graph
+		JobSystem::Wait(m_JobCounter);
+
+		m_TotalMs = static_cast<float>(Clock::NsToSeconds(Clock::GetTimeNs() - m_ExecuteStartNs) * 1000.0);
+	}
+
+	//Run a task, record its timing and release its dependents
+	void TaskGraph::RunTask(TaskHandle task)
+	{
+		uint64_t startNs = Clock::GetTimeNs();
+		{
+			KJK_PROFILE_SCOPE(m_Tasks[task].Name);
+			m_Tasks[task].Function();
+		}
+		uint64_t endNs = Clock::GetTimeNs();
+
+		//Record the timing, every task writes only its own entry
+		TaskTiming& timing = m_Timings[task];
+		timing.StartMs = static_cast<float>(Clock::NsToSeconds(startNs - m_ExecuteStartNs) * 1000.0);
+		timing.DurationMs = static_cast<float>(Clock::NsToSeconds(endNs - startNs) * 1000.0);
+		timing.ThreadIndex = JobSystem::GetThreadIndex();
+
+		//Release the dependents whose last dependency was this task
+		for (TaskHandle dependent : m_Tasks[task].Dependents)
+		{
+			if (m_Remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Schedule(dependent);
+		}
+
+		m_Finished.fetch_add(1, std::memory_order_release);
+	}
+
+	//Hand a task whose dependencies are done to the thread that is allowed to run it
+	void TaskGraph::Schedule(TaskHandle task)
+	{
+		if (m_Tasks[task].Affinity == TaskAffinity::MainThread)
+		{
+			uint32_t slot = m_MainThreadWrite.fetch_add(1, std::memory_order_relaxed);
+			m_MainThreadQueue[slot].store(task + 1, std::memory_order_release);
+		}
+		else
+		{
+			JobSystem::Execute(m_JobCounter, [this, task]()
+			{
+				RunTask(task);
+			});
+		}
+	}
+}
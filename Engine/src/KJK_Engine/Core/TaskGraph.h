@@ -0,0 +1,103 @@
+#pragma once
+
+#include "JobSystem.h"
+
+namespace KJK
+{
+	//Threads a task is allowed to run on
+	enum class TaskAffinity
+	{
+		//Any job system thread
+		Any = 0,
+		//Only the thread that executes the graph, used for work like OpenGL calls
+		MainThread
+	};
+
+	//Timing of a single task during the last execution of a graph
+	struct TaskTiming
+	{
+		//Name of the task
+		const char* Name = "";
+		//Start time relative to the start of the execution, in milliseconds
+		float StartMs = 0.0f;
+		//Duration of the task, in milliseconds
+		float DurationMs = 0.0f;
+		//Job system index of the thread that ran the task
+		uint32_t ThreadIndex = 0;
+	};
+
+	//Graph of tasks with declared dependencies, built once and executed every frame
+	//Tasks whose dependencies are done run in parallel on the job system
+	class TaskGraph
+	{
+	public:
+		//Handle identifying a task in the graph
+		using TaskHandle = uint32_t;
+		//Function type for task bodies
+		using TaskFn = std::function<void()>;
+
+		TaskGraph() = default;
+
+		//Disable copy semantics, queued jobs keep a pointer to the graph
+		TaskGraph(const TaskGraph& other) = delete;
+		TaskGraph& operator=(const TaskGraph& other) = delete;
+
+		//Add a task to the graph, only allowed before Compile
+		TaskHandle AddTask(const char* name, const TaskFn& function, TaskAffinity affinity = TaskAffinity::Any);
+		//Declare that a task may only start once another task has finished
+		void AddDependency(TaskHandle task, TaskHandle dependsOn);
+
+		//Validate the graph and allocate all execution state, returns false if the graph has a cycle
+		bool Compile();
+		//Run all tasks once, the calling thread runs the main thread tasks and helps with the rest
+		void Execute();
+
+		//Getter for the per task timings of the last execution, in the order the tasks were added
+		inline const std::vector<TaskTiming>& GetTimings() const { return m_Timings; }
+		//Getter for the wall time of the last execution, in milliseconds
+		inline float GetTotalMs() const { return m_TotalMs; }
+		//Getter for the number of tasks
+		inline uint32_t GetTaskCount() const { return static_cast<uint32_t>(m_Tasks.size()); }
+		//Check if the graph was compiled
+		inline bool IsCompiled() const { return m_Compiled; }
+	private:
+		//Static description of a task
+		struct Task
+		{
+			const char* Name;
+			TaskFn Function;
+			TaskAffinity Affinity;
+			//Number of tasks that have to finish before this one can start
+			uint32_t DependencyCount = 0;
+			//Tasks waiting on this one
+			std::vector<TaskHandle> Dependents;
+		};
+
+		//Run a task, record its timing and release its dependents
+		void RunTask(TaskHandle task);
+		//Hand a task whose dependencies are done to the thread that is allowed to run it
+		void Schedule(TaskHandle task);
+
+		std::vector<Task> m_Tasks;
+		//Tasks without dependencies, scheduled at the start of every execution
+		std::vector<TaskHandle> m_RootTasks;
+		bool m_Compiled = false;
+
+		//Remaining dependencies per task during an execution
+		std::unique_ptr<std::atomic<uint32_t>[]> m_Remaining;
+		//Main thread tasks that are ready to run, one slot per task storing the handle + 1
+		std::unique_ptr<std::atomic<uint32_t>[]> m_MainThreadQueue;
+		//Write and read positions in the main thread queue
+		std::atomic<uint32_t> m_MainThreadWrite{ 0 };
+		uint32_t m_MainThreadRead = 0;
+		//Number of tasks that have finished during an execution
+		std::atomic<uint32_t> m_Finished{ 0 };
+		//Counter tracking the tasks submitted to the job system
+		JobCounter m_JobCounter;
+
+		//Start time of the current execution in nanoseconds
+		uint64_t m_ExecuteStartNs = 0;
+		std::vector<TaskTiming> m_Timings;
+		float m_TotalMs = 0.0f;
+	};
+}
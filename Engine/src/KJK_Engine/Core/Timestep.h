@@ -0,0 +1,23 @@
+#pragma once
+
+namespace KJK
+{
+	//Class representing the time elapsed between two updates, stored in seconds
+	class Timestep
+	{
+	public:
+		Timestep(double time = 0.0)
+			: m_Time(time) {}
+
+		//Implicit conversion to seconds for use in calculations
+		operator float() const { return static_cast<float>(m_Time); }
+
+		//Getters for the time in different units
+		inline double GetSeconds() const { return m_Time; }
+		inline double GetMilliseconds() const { return m_Time * 1000.0; }
+		inline double GetMicroseconds() const { return m_Time * 1000000.0; }
+	private:
+		//Time in seconds
+		double m_Time;
+	};
+}
@@ -2,17 +2,29 @@
 
 #include "KJK_Engine/Events/Event.h"
 
-namespace KJk
+namespace KJK
 {
+	//Swap interval modes of a window
+	enum class VSyncMode
+	{
+		//Present immediately, frames may tear
+		Off,
+		//Wait for the vertical blank
+		On,
+		//Wait for the vertical blank, but present immediately when a frame missed it instead of waiting for the next one
+		Adaptive
+	};
+
 	//Struct representing properties necessary for creating a window
 	struct WindowProps
 	{
 		std::string Title;
 		unsigned int Width;
 		unsigned int Height;
+		VSyncMode VSync;
 
-		WindowProps(const std::string& title = "KJK Engine", unsigned int width = 1280, unsigned int height = 720)
-			: Title(title), Width(width), Height(height) {}
+		WindowProps(const std::string& title = "KJK Engine", unsigned int width = 1280, unsigned int height = 720, VSyncMode vsync = VSyncMode::On)
+			: Title(title), Width(width), Height(height), VSync(vsync) {}
 	};
 
 	//Interface representing a desktop system window
@@ -24,8 +36,10 @@ namespace KJk
 
 		virtual ~Window() {}
 
-		//Called every frame to update the window
+		//Called every frame to drain the pending system events and deliver them to the event callback
 		virtual void OnUpdate() = 0;
+		//Present the rendered frame
+		virtual void SwapBuffers() = 0;
 
 		//Getter for window width
 		virtual unsigned int GetWidth() const = 0;
@@ -34,12 +48,19 @@ namespace KJk
 
 		//Setter for the event callback function
 		virtual void SetEventCallback(const EventCallbackFn& callback) = 0;
+		//Setter for the swap interval mode, falls back to plain vsync if adaptive sync isn't supported
+		virtual void SetVSyncMode(VSyncMode mode) = 0;
+		//Getter for the swap interval mode
+		virtual VSyncMode GetVSyncMode() const = 0;
 		//Setter for the VSync state
-		virtual void SetVSync(bool enabled) = 0;
+		inline void SetVSync(bool enabled) { SetVSyncMode(enabled ? VSyncMode::On : VSyncMode::Off); }
 		//Getter for the VSync state
-		virtual bool IsVSync() const = 0;
-		
-		//Factory method for creating a window
+		inline bool IsVSync() const { return GetVSyncMode() != VSyncMode::Off; }
+
+		//Getter for the platform window handle
+		virtual void* GetNativeWindow() const = 0;
+
+		//Factory method for creating a window, returns nullptr if the window couldn't be created
 		static Window* Create(const WindowProps& props = WindowProps());
-	}
-}
\ No newline at end of file
+	};
+}
@@ -7,7 +7,8 @@ namespace KJK
 	class WindowCloseEvent : public Event
 	{
 	public:
-		WindowCloseEvent() {}
+		WindowCloseEvent()
+			: Event(GetStaticType(), GetStaticCategoryFlags()) {}
 
 		EVENT_CLASS_TYPE(WindowClose)
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -17,12 +18,19 @@ namespace KJK
 	{
 	public:
 		WindowResizeEvent(int width, int height)
-			: m_Width(width), m_Height(height) {
+			: Event(GetStaticType(), GetStaticCategoryFlags()), m_Width(width), m_Height(height) {
 		}
 
 		inline int GetWidth() const { return m_Width; }
 		inline int GetHeight() const { return m_Height; }
 
+		//Merge a newer event into this one, only the final size matters
+		void Coalesce(const WindowResizeEvent& newer)
+		{
+			m_Width = newer.m_Width;
+			m_Height = newer.m_Height;
+		}
+
 		std::string ToString() const override
 		{
 			std::stringstream ss;
@@ -40,7 +48,8 @@ namespace KJK
 	class AppTickEvent : public Event
 	{
 	public:
-		AppTickEvent() {}
+		AppTickEvent()
+			: Event(GetStaticType(), GetStaticCategoryFlags()) {}
 
 		EVENT_CLASS_TYPE(AppTick)
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -49,7 +58,8 @@ namespace KJK
 	class AppUpdateEvent : public Event
 	{
 	public:
-		AppUpdateEvent() {}
+		AppUpdateEvent()
+			: Event(GetStaticType(), GetStaticCategoryFlags()) {}
 
 		EVENT_CLASS_TYPE(AppUpdate)
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -58,7 +68,8 @@ namespace KJK
 	class AppRenderEvent : public Event
 	{
 	public:
-		AppRenderEvent() {}
+		AppRenderEvent()
+			: Event(GetStaticType(), GetStaticCategoryFlags()) {}
 
 		EVENT_CLASS_TYPE(AppRender)
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -67,7 +78,8 @@ namespace KJK
 	class WindowFocusEvent : public Event
 	{
 	public:
-		WindowFocusEvent() {}
+		WindowFocusEvent()
+			: Event(GetStaticType(), GetStaticCategoryFlags()) {}
 
 		EVENT_CLASS_TYPE(WindowFocus)
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -76,7 +88,8 @@ namespace KJK
 	class WindowLostFocusEvent : public Event
 	{
 	public:
-		WindowLostFocusEvent() {}
+		WindowLostFocusEvent()
+			: Event(GetStaticType(), GetStaticCategoryFlags()) {}
 
 		EVENT_CLASS_TYPE(WindowLostFocus)
 		EVENT_CLASS_CATEGORY(EventCategoryApplication)
@@ -86,7 +99,7 @@ namespace KJK
 	{
 	public:
 		WindowMovedEvent(int x, int y)
-			: m_X(x), m_Y(y) {}
+			: Event(GetStaticType(), GetStaticCategoryFlags()), m_X(x), m_Y(y) {}
 
 		inline int GetX() const { return m_X; }
 		inline int GetY() const { return m_Y; }
@@ -0,0 +1,70 @@
+#include "ConcurrentEventQueue.h"
+
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/MemoryTracker.h"
+
+namespace KJK
+{
+	//Create a queue with room for the given number of events, rounded up to a power of two
+	ConcurrentEventQueue::ConcurrentEventQueue(uint32_t capacity)
+	{
+		m_Capacity = 2;
+		while (m_Capacity < capacity)
+			m_Capacity <<= 1;
+		m_Mask = m_Capacity - 1;
+
+		//Every slot starts out owned by the producers of the first lap
+		KJK_MEMORY_SCOPE(MemoryCategory::Events);
+		m_Slots = new Slot[m_Capacity];
+		for (uint64_t i = 0; i < m_Capacity; i++)
+		{
+			m_Slots[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	ConcurrentEventQueue::~ConcurrentEventQueue()
+	{
+		//Destroy the events that were never flushed
+		Flush([](Event&) {});
+		delete[] m_Slots;
+	}
+
+	//Getter for the approximate number of queued events
+	uint32_t ConcurrentEventQueue::GetSize() const
+	{
+		uint64_t enqueuePosition = m_EnqueuePosition.load(std::memory_order_relaxed);
+		uint64_t dequeuePosition = m_DequeuePosition.load(std::memory_order_relaxed);
+		return enqueuePosition > dequeuePosition ? static_cast<uint32_t>(enqueuePosition - dequeuePosition) : 0;
+	}
+
+	//Reserve the next free slot for a producer, returns nullptr if the queue is full
+	ConcurrentEventQueue::Slot* ConcurrentEventQueue::ClaimSlot(uint64_t& position)
+	{
+		position = m_EnqueuePosition.load(std::memory_order_relaxed);
+		while (true)
+		{
+			Slot& slot = m_Slots[position & m_Mask];
+			uint64_t sequence = slot.Sequence.load(std::memory_order_acquire);
+			int64_t difference = static_cast<int64_t>(sequence - position);
+
+			if (difference == 0)
+			{
+				//The slot is free for this lap, try to take it before another producer does
+				if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					return &slot;
+			}
+			else if (difference < 0)
+			{
+				//The consumer hasn't released the slot from the previous lap yet, the queue is full
+				if (m_Rejected.fetch_add(1, std::memory_order_relaxed) == 0)
+					KJK_CORE_WARN("Concurrent event queue is full ({0} events), rejecting events!", m_Capacity);
+				return nullptr;
+			}
+			else
+			{
+				//Another producer took the slot, retry with the current position
+				position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Event.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace KJK
+{
+	//Bounded lock-free event queue for posting events from any thread to a single consumer thread
+	//Events are stored by value in fixed size slots, so pushing and flushing never allocates
+	class ConcurrentEventQueue
+	{
+	public:
+		//Size of the inline storage for a single event
+		static constexpr size_t SlotStorageSize = 48;
+
+		//Create a queue with room for the given number of events, rounded up to a power of two
+		ConcurrentEventQueue(uint32_t capacity = 4096);
+		~ConcurrentEventQueue();
+
+		//Disable copy semantics, the slots hold live event objects
+		ConcurrentEventQueue(const ConcurrentEventQueue& other) = delete;
+		ConcurrentEventQueue& operator=(const ConcurrentEventQueue& other) = delete;
+
+		//Construct an event of type T in the queue from any thread
+		//Returns false and counts the event as rejected if the queue is full, the caller decides whether to retry or drop
+		template<typename T, typename... Args>
+		bool Emplace(Args&&... args)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "Only events can be pushed to an event queue");
+			static_assert(sizeof(T) <= SlotStorageSize, "Event is too large for a concurrent event queue slot");
+			static_assert(alignof(T) <= alignof(std::max_align_t), "Event alignment is too large for the event queue");
+
+			uint64_t position;
+			Slot* slot = ClaimSlot(position);
+			if (!slot)
+				return false;
+
+			new (slot->Storage) T(std::forward<Args>(args)...);
+
+			//Publish the event to the consumer
+			slot->Sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		//Copy or move an event into the queue from any thread, returns false if the queue is full
+		template<typename T>
+		bool Push(T&& event)
+		{
+			return Emplace<std::decay_t<T>>(std::forward<T>(event));
+		}
+
+		//Process the published events in order with a callback function and destroy them, only called by the consumer thread
+		//Stops after maxEvents events, returns the number of processed events
+		template<typename F>
+		uint32_t Flush(F&& callback, uint32_t maxEvents = UINT32_MAX)
+		{
+			uint64_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+			uint32_t processed = 0;
+
+			while (processed < maxEvents)
+			{
+				Slot& slot = m_Slots[position & m_Mask];
+				if (slot.Sequence.load(std::memory_order_acquire) != position + 1)
+					break;
+
+				Event* event = std::launder(reinterpret_cast<Event*>(slot.Storage));
+				callback(*event);
+				event->~Event();
+
+				//Hand the slot back to the producers for the next lap around the ring
+				slot.Sequence.store(position + m_Capacity, std::memory_order_release);
+				position++;
+				processed++;
+			}
+
+			m_DequeuePosition.store(position, std::memory_order_relaxed);
+			return processed;
+		}
+
+		//Getter for the approximate number of queued events
+		uint32_t GetSize() const;
+		//Getter for the maximum number of queued events
+		inline uint32_t GetCapacity() const { return static_cast<uint32_t>(m_Capacity); }
+		//Getter for the number of pushes rejected because the queue was full
+		inline uint64_t GetRejectedCount() const { return m_Rejected.load(std::memory_order_relaxed); }
+	private:
+		//Storage for a single event, the sequence tells producers and the consumer who owns the slot
+		struct alignas(64) Slot
+		{
+			std::atomic<uint64_t> Sequence;
+			alignas(std::max_align_t) unsigned char Storage[SlotStorageSize];
+		};
+
+		//Reserve the next free slot for a producer, returns nullptr if the queue is full
+		Slot* ClaimSlot(uint64_t& position);
+
+		Slot* m_Slots = nullptr;
+		uint64_t m_Capacity = 0;
+		uint64_t m_Mask = 0;
+
+		//Positions of the next slot to write and to read, kept on separate cache lines
+		alignas(64) std::atomic<uint64_t> m_EnqueuePosition{ 0 };
+		alignas(64) std::atomic<uint64_t> m_DequeuePosition{ 0 };
+		//Number of pushes rejected because the queue was full
+		alignas(64) std::atomic<uint64_t> m_Rejected{ 0 };
+	};
+}
@@ -12,6 +12,9 @@ namespace KJK
 		MouseButtonPressed, MouseButtonReleased, MouseMoved, MouseScrolled
 	};
 
+	//Number of event types, used for tables indexed by EventType
+	constexpr uint32_t EventTypeCount = static_cast<uint32_t>(EventType::MouseScrolled) + 1;
+
 	//Categories of events, saved as bitflags to allows multiple categories to be applied to a single event
 	enum EventCategory
 	{
@@ -24,12 +27,13 @@ namespace KJK
 	};
 
 //Macro for defining all virtual methods related to event type
-#define EVENT_CLASS_TYPE(type) static EventType GetStaticType() { return EventType::##type; }\
+#define EVENT_CLASS_TYPE(type) static constexpr EventType GetStaticType() { return EventType::type; }\
 								virtual EventType GetEventType() const override { return GetStaticType(); }\
 								virtual const char* GetName() const override { return #type; }
 
 //Macro for defining one or more categories for an event type
-#define EVENT_CLASS_CATEGORY(category) virtual int GetCategoryFlags() const override { return category; }
+#define EVENT_CLASS_CATEGORY(category) static constexpr int GetStaticCategoryFlags() { return category; }\
+										virtual int GetCategoryFlags() const override { return category; }
 
 	//Base Event class
 	//Signifies an event occurring in the window application
@@ -37,11 +41,15 @@ namespace KJK
 	{
 		//Associated EventDispatcher which handles events
 		friend class EventDispatcher;
+		//Event bus publishing events to its listeners
+		friend class EventBus;
 	public:
 		virtual ~Event() = default;
 
 		//Getter for event type
 		virtual EventType GetEventType() const = 0;
+		//Getter for the event type stored at construction, avoids the virtual call
+		inline EventType GetType() const { return m_Type; }
 		//Getter for event category
 		virtual int GetCategoryFlags() const = 0;
 		//Used for logging event info
@@ -49,14 +57,28 @@ namespace KJK
 		//Used for logging detailed event info
 		virtual std::string ToString() const { return GetName(); }
 
+		//Getter for the category flags stored at construction, avoids the virtual call
+		inline int GetCategories() const { return m_CategoryFlags; }
+
 		//Check if the event is in a certain category
-		inline bool IsInCategory(EventCategory category)
+		inline bool IsInCategory(EventCategory category) const
 		{
 			//Bitwise AND to check category flag
-			return GetCategoryFlags() & category;
+			return m_CategoryFlags & category;
 		}
 
+		//Check if the event has been handled
+		inline bool IsHandled() const { return m_Handled; }
+
 	protected:
+		//Events pass their static type and categories up so they can be checked without a virtual call
+		Event(EventType type, int categoryFlags)
+			: m_Type(type), m_CategoryFlags(categoryFlags) {}
+
+		//Type of the event
+		EventType m_Type;
+		//Categories of the event
+		int m_CategoryFlags;
 		//Check if the event has been handled
 		bool m_Handled = false;
 	};
@@ -64,20 +86,27 @@ namespace KJK
 	//Class for dispatching events to the correct event handler functions
 	class EventDispatcher
 	{
-		//Define a function type for event handling functions
-		template<typename T>
-		using EventFn = std::function<bool(T&)>;
 	public:
 		EventDispatcher(Event& event)
 			: m_Event(event) {}
 
 		//Dispatch the event to the correct event function if the types match
-		template<typename T>
-		bool Dispatch(EventFn<T> func)
+		//Accepts any callable taking T& and returning bool, the type check doesn't need a virtual call
+		template<typename T, typename F>
+		bool Dispatch(const F& func)
+		{
+			return Dispatch<T>(m_Event, func);
+		}
+
+		//Dispatch a single event without constructing a dispatcher
+		template<typename T, typename F>
+		static bool Dispatch(Event& event, const F& func)
 		{
-			if (m_Event.GetEventType() == T::GetStaticType())
+			static_assert(std::is_base_of_v<Event, T>, "Events can only be dispatched to event handlers");
+
+			if (event.m_Type == T::GetStaticType())
 			{
-				m_Event.m_Handled = func(*(T*)&m_Event);
+				event.m_Handled = func(static_cast<T&>(event));
 				return true;
 			}
 			return false;
@@ -91,43 +120,4 @@ namespace KJK
 	inline std::string format_as(const Event& e) {
 		return e.ToString();
 	}
-
-	//Queue for storing a buffer of events
-	class EventQueue
-	{
-	public:
-		//Add an event to the queue
-		void Push(std::unique_ptr<Event> event)
-		{
-			m_Buffer.push_back(std::move(event));
-		}
-
-		//Overload for raw pointer events
-		void Push(Event* event)
-		{
-			m_Buffer.emplace_back(event);
-		}
-
-		//Getter for the event buffer
-		std::vector<std::unique_ptr<Event>>& GetBuffer()
-		{
-			return m_Buffer;
-		}
-
-		//Process all events in the buffer with a callback function
-		void Flush(const std::function<void(Event&)>& callback)
-		{
-			for (auto& eventPtr : m_Buffer)
-			{
-				if (eventPtr)
-				{
-					callback(*eventPtr);
-				}
-			}
-			//Clear the buffer after processing
-			m_Buffer.clear();
-		}
-	private:
-		std::vector<std::unique_ptr<Event>> m_Buffer;
-	};
 }
\ No newline at end of file
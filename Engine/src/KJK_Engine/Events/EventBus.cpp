@@ -0,0 +1,160 @@
+#include "EventBus.h"
+
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Events/ApplicationEvent.h"
+#include "KJK_Engine/Events/EventQueue.h"
+#include "KJK_Engine/Events/KeyEvent.h"
+#include "KJK_Engine/Events/MouseEvent.h"
+
+namespace KJK
+{
+	static_assert(EventTypeCount <= 64, "Event type masks are stored in 64 bits");
+
+	namespace
+	{
+		//Build the table of category flags per event type from the event classes
+		template<typename... Events>
+		constexpr std::array<int, EventTypeCount> BuildCategoryTable()
+		{
+			std::array<int, EventTypeCount> table{};
+			((table[static_cast<uint32_t>(Events::GetStaticType())] = Events::GetStaticCategoryFlags()), ...);
+			return table;
+		}
+
+		//Category flags of every event type, computed at compile time
+		constexpr std::array<int, EventTypeCount> s_CategoryTable = BuildCategoryTable<
+			WindowCloseEvent, WindowResizeEvent, WindowFocusEvent, WindowLostFocusEvent, WindowMovedEvent,
+			AppTickEvent, AppUpdateEvent, AppRenderEvent,
+			KeyPressedEvent, KeyReleasedEvent, KeyTypedEvent,
+			MouseButtonPressedEvent, MouseButtonReleasedEvent, MouseMovedEvent, MouseScrolledEvent>();
+	}
+
+	//Getter for the categories an event type belongs to, known at compile time
+	int EventBus::GetCategoryFlags(EventType type)
+	{
+		return s_CategoryTable[static_cast<uint32_t>(type)];
+	}
+
+	//Subscribe a listener to every event in any of the given categories, higher priorities are called first
+	EventBus::ListenerHandle EventBus::SubscribeCategory(int categoryMask, const ListenerFn& func, int priority)
+	{
+		//Resolve the categories to event types once, so publishing never checks categories
+		uint64_t typeMask = 0;
+		for (uint32_t type = 0; type < EventTypeCount; type++)
+		{
+			if (s_CategoryTable[type] & categoryMask)
+				typeMask |= 1ull << type;
+		}
+
+		if (typeMask == 0)
+			KJK_CORE_WARN("Event listener subscribed to categories {0} that contain no event types!", categoryMask);
+
+		return AddListener(typeMask, ListenerFn(func), priority);
+	}
+
+	//Remove a subscription, safe to call from inside a listener
+	void EventBus::Unsubscribe(ListenerHandle handle)
+	{
+		//Listeners subscribed while publishing haven't been inserted yet
+		std::erase_if(m_DeferredListeners, [handle](const auto& deferred) { return deferred.second.Handle == handle; });
+
+		for (std::vector<Listener>& listeners : m_Listeners)
+		{
+			for (Listener& listener : listeners)
+			{
+				if (listener.Handle == handle)
+				{
+					listener.Active = false;
+					m_HasInactiveListeners = true;
+				}
+			}
+		}
+
+		//Lists that aren't being iterated can be compacted right away
+		if (m_PublishDepth == 0)
+			ApplyDeferredChanges();
+	}
+
+	//Call the listeners of the event's type in priority order until one of them handles it
+	void EventBus::Publish(Event& event)
+	{
+		m_PublishDepth++;
+
+		std::vector<Listener>& listeners = m_Listeners[static_cast<uint32_t>(event.GetType())];
+		for (const Listener& listener : listeners)
+		{
+			//Stop as soon as a listener has handled the event
+			if (event.IsHandled())
+				break;
+
+			if (listener.Active)
+				event.m_Handled = (*listener.Function)(event);
+		}
+
+		if (--m_PublishDepth == 0)
+			ApplyDeferredChanges();
+	}
+
+	//Publish all events of a queue in order and remove them from the queue
+	void EventBus::Publish(EventQueue& queue)
+	{
+		queue.Flush([this](Event& event)
+		{
+			Publish(event);
+		});
+	}
+
+	//Add a listener to the lists of every event type in the mask
+	EventBus::ListenerHandle EventBus::AddListener(uint64_t typeMask, ListenerFn&& func, int priority)
+	{
+		Listener listener;
+		listener.Handle = m_NextHandle++;
+		listener.Priority = priority;
+		listener.Function = std::make_shared<ListenerFn>(std::move(func));
+
+		//The lists can't change while they are being iterated
+		if (m_PublishDepth > 0)
+			m_DeferredListeners.emplace_back(typeMask, listener);
+		else
+			InsertListener(typeMask, listener);
+
+		return listener.Handle;
+	}
+
+	//Insert a listener into the lists of every event type in the mask, keeping them sorted by priority
+	void EventBus::InsertListener(uint64_t typeMask, const Listener& listener)
+	{
+		for (uint32_t type = 0; type < EventTypeCount; type++)
+		{
+			if (!(typeMask & (1ull << type)))
+				continue;
+
+			//Insert after all listeners with the same or a higher priority to keep subscription order
+			std::vector<Listener>& listeners = m_Listeners[type];
+			auto position = std::upper_bound(listeners.begin(), listeners.end(), listener.Priority, [](int priority, const Listener& other)
+			{
+				return priority > other.Priority;
+			});
+			listeners.insert(position, listener);
+		}
+	}
+
+	//Apply the subscription changes made while publishing
+	void EventBus::ApplyDeferredChanges()
+	{
+		if (m_HasInactiveListeners)
+		{
+			for (std::vector<Listener>& listeners : m_Listeners)
+			{
+				std::erase_if(listeners, [](const Listener& listener) { return !listener.Active; });
+			}
+			m_HasInactiveListeners = false;
+		}
+
+		for (const auto& [typeMask, listener] : m_DeferredListeners)
+		{
+			InsertListener(typeMask, listener);
+		}
+		m_DeferredListeners.clear();
+	}
+}
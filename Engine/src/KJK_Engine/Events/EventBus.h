@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Event.h"
+
+namespace KJK
+{
+	class EventQueue;
+
+	//Publishes events to the listeners subscribed to their type
+	//Listeners are kept in one list per event type, sorted by priority, so publishing only visits interested listeners
+	class EventBus
+	{
+	public:
+		//Handle identifying a subscription
+		using ListenerHandle = uint32_t;
+		//Function type for listeners, returns true if the event was handled
+		using ListenerFn = std::function<bool(Event&)>;
+
+		EventBus() = default;
+
+		//Disable copy semantics, handles are only valid for the bus that created them
+		EventBus(const EventBus& other) = delete;
+		EventBus& operator=(const EventBus& other) = delete;
+
+		//Subscribe a callable taking T& to events of type T, higher priorities are called first
+		template<typename T, typename F>
+		ListenerHandle Subscribe(F func, int priority = 0)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "Listeners can only subscribe to events");
+
+			return AddListener(1ull << static_cast<uint32_t>(T::GetStaticType()), [func](Event& event) mutable
+			{
+				return func(static_cast<T&>(event));
+			}, priority);
+		}
+
+		//Subscribe a listener to every event in any of the given categories, higher priorities are called first
+		ListenerHandle SubscribeCategory(int categoryMask, const ListenerFn& func, int priority = 0);
+		//Remove a subscription, safe to call from inside a listener
+		void Unsubscribe(ListenerHandle handle);
+
+		//Call the listeners of the event's type in priority order until one of them handles it
+		void Publish(Event& event);
+		//Publish all events of a queue in order and remove them from the queue
+		void Publish(EventQueue& queue);
+
+		//Getter for the number of listeners subscribed to an event type
+		inline uint32_t GetListenerCount(EventType type) const { return static_cast<uint32_t>(m_Listeners[static_cast<uint32_t>(type)].size()); }
+		//Getter for the categories an event type belongs to, known at compile time
+		static int GetCategoryFlags(EventType type);
+	private:
+		//Entry in a listener list
+		struct Listener
+		{
+			ListenerHandle Handle;
+			int Priority;
+			//Shared between the lists of a category subscription
+			std::shared_ptr<ListenerFn> Function;
+			//Cleared when the listener is removed during publishing
+			bool Active = true;
+		};
+
+		//Add a listener to the lists of every event type in the mask
+		ListenerHandle AddListener(uint64_t typeMask, ListenerFn&& func, int priority);
+		//Insert a listener into the lists of every event type in the mask, keeping them sorted by priority
+		void InsertListener(uint64_t typeMask, const Listener& listener);
+		//Apply the subscription changes made while publishing
+		void ApplyDeferredChanges();
+
+		//Listeners per event type, sorted from highest to lowest priority
+		std::array<std::vector<Listener>, EventTypeCount> m_Listeners;
+		ListenerHandle m_NextHandle = 1;
+
+		//Number of nested Publish calls, the listener lists can't change while it's not 0
+		uint32_t m_PublishDepth = 0;
+		//Subscriptions made while publishing and their event type masks
+		std::vector<std::pair<uint64_t, Listener>> m_DeferredListeners;
+		//Set when listeners were deactivated while publishing
+		bool m_HasInactiveListeners = false;
+	};
+}
@@ -0,0 +1,139 @@
+#include "EventQueue.h"
+
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/MemoryTracker.h"
+
+namespace KJK
+{
+	namespace
+	{
+		//Round a value up to a power of two alignment
+		inline size_t AlignUp(size_t value, size_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	//Create a queue with a fixed capacity in bytes
+	EventQueue::EventQueue(size_t capacity)
+		: m_Capacity(AlignUp(capacity, RecordAlignment))
+	{
+		KJK_MEMORY_SCOPE(MemoryCategory::Events);
+		m_Buffer = static_cast<std::byte*>(::operator new(m_Capacity, std::align_val_t(alignof(std::max_align_t))));
+	}
+
+	EventQueue::~EventQueue()
+	{
+		Clear();
+		::operator delete(m_Buffer, std::align_val_t(alignof(std::max_align_t)));
+	}
+
+	//Destroy all queued events without processing them
+	void EventQueue::Clear()
+	{
+		while (m_Count > 0)
+		{
+			PeekFront();
+			PopFront();
+		}
+		m_Read = 0;
+		m_Write = 0;
+		m_Used = 0;
+		m_NewestEvent = nullptr;
+	}
+
+	//Reserve a record for an event of the given size and alignment, returns the event memory
+	void* EventQueue::Allocate(size_t size, size_t alignment)
+	{
+		//Start from the beginning when the queue is empty to keep the free space contiguous
+		if (m_Used == 0)
+		{
+			m_Read = 0;
+			m_Write = 0;
+		}
+
+		//Records start aligned to the record alignment, so the event offset only depends on the start
+		size_t eventOffset = AlignUp(sizeof(RecordHeader), std::max(alignment, RecordAlignment));
+		size_t recordSize = AlignUp(eventOffset + size, RecordAlignment);
+
+		//Find a contiguous free region for the record
+		size_t recordStart = m_Write;
+		size_t padding = 0;
+		bool fits = false;
+		if (m_Used < m_Capacity && m_Write >= m_Read)
+		{
+			//Free space is the end of the buffer and the region before the oldest record
+			if (m_Capacity - m_Write >= recordSize)
+			{
+				fits = true;
+			}
+			else if (m_Read >= recordSize)
+			{
+				padding = m_Capacity - m_Write;
+				recordStart = 0;
+				fits = true;
+			}
+		}
+		else if (m_Used < m_Capacity)
+		{
+			//Free space is the gap between the newest and the oldest record
+			fits = m_Read - m_Write >= recordSize;
+		}
+
+		if (!fits)
+		{
+			//Only log the first drop to avoid flooding the log while the queue is full
+			if (m_Dropped++ == 0)
+				KJK_CORE_WARN("Event queue is full ({0} bytes, {1} events), dropping events!", m_Capacity, m_Count);
+			return nullptr;
+		}
+
+		//Mark the unused end of the buffer so flushing wraps around
+		if (padding > 0)
+		{
+			RecordHeader* paddingHeader = new (m_Buffer + m_Write) RecordHeader;
+			paddingHeader->Size = static_cast<uint32_t>(padding);
+			paddingHeader->EventOffset = 0;
+			m_Used += padding;
+		}
+
+		RecordHeader* header = new (m_Buffer + recordStart) RecordHeader;
+		header->Size = static_cast<uint32_t>(recordSize);
+		header->EventOffset = static_cast<uint32_t>(eventOffset);
+
+		m_Write = recordStart + recordSize;
+		if (m_Write == m_Capacity)
+			m_Write = 0;
+		m_Used += recordSize;
+		m_Count++;
+
+		return m_Buffer + recordStart + eventOffset;
+	}
+
+	//Getter for the oldest queued event, skipping the padding at the end of the buffer
+	Event* EventQueue::PeekFront()
+	{
+		RecordHeader* header = std::launder(reinterpret_cast<RecordHeader*>(m_Buffer + m_Read));
+		if (header->EventOffset == 0)
+		{
+			m_Used -= header->Size;
+			m_Read = 0;
+			header = std::launder(reinterpret_cast<RecordHeader*>(m_Buffer));
+		}
+
+		return std::launder(reinterpret_cast<Event*>(m_Buffer + m_Read + header->EventOffset));
+	}
+
+	//Destroy the oldest queued event and release its record
+	void EventQueue::PopFront()
+	{
+		RecordHeader* header = std::launder(reinterpret_cast<RecordHeader*>(m_Buffer + m_Read));
+		std::launder(reinterpret_cast<Event*>(m_Buffer + m_Read + header->EventOffset))->~Event();
+
+		m_Read += header->Size;
+		if (m_Read == m_Capacity)
+			m_Read = 0;
+		m_Used -= header->Size;
+		m_Count--;
+	}
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Event.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace KJK
+{
+	//Events that can merge a newer event of the same type into themselves
+	template<typename T>
+	concept CoalescableEvent = requires(T& event, const T& newer) { event.Coalesce(newer); };
+
+	//Queue storing events by value in a contiguous ring buffer
+	//Events are placement constructed into the buffer, so pushing and flushing never allocates
+	class EventQueue
+	{
+	public:
+		//Create a queue with a fixed capacity in bytes
+		EventQueue(size_t capacity = 64 * 1024);
+		~EventQueue();
+
+		//Disable copy semantics, the buffer holds live event objects
+		EventQueue(const EventQueue& other) = delete;
+		EventQueue& operator=(const EventQueue& other) = delete;
+
+		//Construct an event of type T in the queue, returns nullptr and counts the event as dropped if the queue is full
+		template<typename T, typename... Args>
+		T* Emplace(Args&&... args)
+		{
+			static_assert(std::is_base_of_v<Event, T>, "Only events can be pushed to an event queue");
+			static_assert(alignof(T) <= RecordAlignment, "Event alignment is too large for the event queue");
+
+			//Merge into the newest queued event if it has the same type, so a run of events costs one update
+			if constexpr (CoalescableEvent<T>)
+			{
+				if (m_Coalescing && m_NewestEvent && m_NewestEvent->GetType() == T::GetStaticType())
+				{
+					T& newest = static_cast<T&>(*m_NewestEvent);
+					newest.Coalesce(T(std::forward<Args>(args)...));
+					m_CoalescedCount++;
+					return &newest;
+				}
+			}
+
+			void* memory = Allocate(sizeof(T), alignof(T));
+			if (!memory)
+				return nullptr;
+
+			T* event = new (memory) T(std::forward<Args>(args)...);
+			m_NewestEvent = event;
+			return event;
+		}
+
+		//Copy or move an event into the queue, returns nullptr and counts the event as dropped if the queue is full
+		template<typename T>
+		std::decay_t<T>* Push(T&& event)
+		{
+			return Emplace<std::decay_t<T>>(std::forward<T>(event));
+		}
+
+		//Process all queued events in order with a callback function and destroy them
+		//Events pushed by the callback are kept for the next flush
+		template<typename F>
+		void Flush(F&& callback)
+		{
+			//Events pushed by the callback must not merge into an event that is being processed
+			m_NewestEvent = nullptr;
+
+			uint32_t count = m_Count;
+			while (count > 0)
+			{
+				Event* event = PeekFront();
+				callback(*event);
+				PopFront();
+				count--;
+			}
+		}
+
+		//Visit all queued events in order without removing them, the callback must not push to the queue
+		template<typename F>
+		void ForEach(F&& callback)
+		{
+			size_t position = m_Read;
+			for (uint32_t i = 0; i < m_Count; i++)
+			{
+				RecordHeader* header = std::launder(reinterpret_cast<RecordHeader*>(m_Buffer + position));
+				if (header->EventOffset == 0)
+				{
+					position = 0;
+					header = std::launder(reinterpret_cast<RecordHeader*>(m_Buffer));
+				}
+
+				callback(*std::launder(reinterpret_cast<Event*>(m_Buffer + position + header->EventOffset)));
+
+				position += header->Size;
+				if (position == m_Capacity)
+					position = 0;
+			}
+		}
+
+		//Dispatch all queued events of type T to the event function in one pass, the events stay queued
+		//Returns the number of events the function was called for
+		template<typename T, typename F>
+		uint32_t Dispatch(const F& func)
+		{
+			uint32_t dispatched = 0;
+			ForEach([&func, &dispatched](Event& event)
+			{
+				if (EventDispatcher::Dispatch<T>(event, func))
+					dispatched++;
+			});
+			return dispatched;
+		}
+
+		//Destroy all queued events without processing them
+		void Clear();
+
+		//Enable merging of runs of coalescable events, like mouse motion or window resizes, into a single event
+		inline void SetCoalescing(bool enabled) { m_Coalescing = enabled; m_NewestEvent = nullptr; }
+		//Check if runs of coalescable events are merged
+		inline bool IsCoalescing() const { return m_Coalescing; }
+		//Getter for the number of events merged into a queued event instead of being queued
+		inline uint64_t GetCoalescedCount() const { return m_CoalescedCount; }
+
+		//Getter for the number of queued events
+		inline uint32_t GetSize() const { return m_Count; }
+		//Check if there are no queued events
+		inline bool IsEmpty() const { return m_Count == 0; }
+		//Getter for the number of bytes in use, including record headers and padding
+		inline size_t GetUsedBytes() const { return m_Used; }
+		//Getter for the capacity of the buffer in bytes
+		inline size_t GetCapacity() const { return m_Capacity; }
+		//Getter for the number of events dropped because the queue was full
+		inline uint64_t GetDroppedCount() const { return m_Dropped; }
+	private:
+		//Alignment of every record in the buffer, events are placed at offsets that are multiples of it
+		static constexpr size_t RecordAlignment = alignof(uint64_t);
+
+		//Header in front of every event in the buffer
+		struct RecordHeader
+		{
+			//Size of the whole record, including the header and padding
+			uint32_t Size;
+			//Offset of the event from the start of the record, 0 marks padding at the end of the buffer
+			uint32_t EventOffset;
+		};
+
+		//Reserve a record for an event of the given size and alignment, returns the event memory
+		void* Allocate(size_t size, size_t alignment);
+		//Getter for the oldest queued event, skipping the padding at the end of the buffer
+		Event* PeekFront();
+		//Destroy the oldest queued event and release its record
+		void PopFront();
+
+		//Ring buffer storing the records
+		std::byte* m_Buffer = nullptr;
+		size_t m_Capacity = 0;
+		//Offsets of the oldest record and of the next free byte
+		size_t m_Read = 0;
+		size_t m_Write = 0;
+		//Number of bytes in use, including padding
+		size_t m_Used = 0;
+		//Number of queued events
+		uint32_t m_Count = 0;
+		//Number of events that didn't fit
+		uint64_t m_Dropped = 0;
+
+		//Merge runs of coalescable events, disabled by default
+		bool m_Coalescing = false;
+		//Newest queued event that later events may merge into, reset once processing starts
+		Event* m_NewestEvent = nullptr;
+		//Number of events merged into a queued event
+		uint64_t m_CoalescedCount = 0;
+	};
+}
@@ -9,21 +9,25 @@ namespace KJK
 	{
 	public:
 		inline int GetKeyCode() const { return m_KeyCode; }
+		//Getter for the physical key, the same on every keyboard layout and with any modifiers held
+		inline int GetScanCode() const { return m_ScanCode; }
 
 		EVENT_CLASS_CATEGORY(EventCategoryKeyboard | EventCategoryInput)
 	protected:
-		KeyEvent(int keycode)
-			: m_KeyCode(keycode) {}
+		KeyEvent(EventType type, int keycode, int scancode)
+			: Event(type, GetStaticCategoryFlags()), m_KeyCode(keycode), m_ScanCode(scancode) {}
 
 		//Key code of the key event
 		int m_KeyCode;
+		//Scan code of the key event, 0 for typed characters
+		int m_ScanCode;
 	};
 
 	class KeyPressedEvent : public KeyEvent
 	{
 	public:
-		KeyPressedEvent(int keycode, int repeatCount)
-			: KeyEvent(keycode), m_RepeatCount(repeatCount) {
+		KeyPressedEvent(int keycode, int repeatCount, int scancode = 0)
+			: KeyEvent(GetStaticType(), keycode, scancode), m_RepeatCount(repeatCount) {
 		}
 
 		inline int GetRepeatCount() const { return m_RepeatCount; }
@@ -43,8 +47,8 @@ namespace KJK
 	class KeyReleasedEvent : public KeyEvent
 	{
 	public:
-		KeyReleasedEvent(int keycode)
-			: KeyEvent(keycode) {
+		KeyReleasedEvent(int keycode, int scancode = 0)
+			: KeyEvent(GetStaticType(), keycode, scancode) {
 		}
 
 		std::string ToString() const override
@@ -61,7 +65,7 @@ namespace KJK
 	{
 	public:
 		KeyTypedEvent(int keycode, char32_t character)
-			: KeyEvent(keycode), m_KeyCharacter(character) {
+			: KeyEvent(GetStaticType(), keycode, 0), m_KeyCharacter(character) {
 		}
 
 		inline char32_t GetCharacter() const { return m_KeyCharacter; }
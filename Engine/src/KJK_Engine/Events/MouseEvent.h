@@ -7,11 +7,23 @@ namespace KJK
 	class MouseMovedEvent : public Event
 	{
 	public:
-		MouseMovedEvent(float x, float y)
-			: m_MouseX(x), m_MouseY(y) {}
+		MouseMovedEvent(float x, float y, float deltaX = 0.0f, float deltaY = 0.0f)
+			: Event(GetStaticType(), GetStaticCategoryFlags()), m_MouseX(x), m_MouseY(y), m_DeltaX(deltaX), m_DeltaY(deltaY) {}
 
 		inline float GetX() const { return m_MouseX; }
 		inline float GetY() const { return m_MouseY; }
+		//Getters for the relative motion since the previous event
+		inline float GetDeltaX() const { return m_DeltaX; }
+		inline float GetDeltaY() const { return m_DeltaY; }
+
+		//Merge a newer event into this one, keeping the latest position and summing the motion
+		void Coalesce(const MouseMovedEvent& newer)
+		{
+			m_MouseX = newer.m_MouseX;
+			m_MouseY = newer.m_MouseY;
+			m_DeltaX += newer.m_DeltaX;
+			m_DeltaY += newer.m_DeltaY;
+		}
 
 		std::string ToString() const override
 		{
@@ -24,18 +36,26 @@ namespace KJK
 		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryInput)
 	private:
 		float m_MouseX, m_MouseY;
+		float m_DeltaX, m_DeltaY;
 	};
 
 	class MouseScrolledEvent : public Event
 	{
 	public:
 		MouseScrolledEvent(float xOffset, float yOffset)
-			: m_XOffset(xOffset), m_YOffset(yOffset) {
+			: Event(GetStaticType(), GetStaticCategoryFlags()), m_XOffset(xOffset), m_YOffset(yOffset) {
 		}
 
 		inline float GetXOffset() const { return m_XOffset; }
 		inline float GetYOffset() const { return m_YOffset; }
 
+		//Merge a newer event into this one, summing the scroll offsets
+		void Coalesce(const MouseScrolledEvent& newer)
+		{
+			m_XOffset += newer.m_XOffset;
+			m_YOffset += newer.m_YOffset;
+		}
+
 		std::string ToString() const override
 		{
 			std::stringstream ss;
@@ -57,8 +77,8 @@ namespace KJK
 		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryInput | EventCategoryMouseButton)
 
 	protected:
-		MouseButtonEvent(int button)
-			: m_Button(button) {
+		MouseButtonEvent(EventType type, int button)
+			: Event(type, GetStaticCategoryFlags()), m_Button(button) {
 		}
 
 		//Mouse button code
@@ -69,7 +89,7 @@ namespace KJK
 	{
 	public:
 		MouseButtonPressedEvent(int button)
-			: MouseButtonEvent(button) {
+			: MouseButtonEvent(GetStaticType(), button) {
 		}
 
 		std::string ToString() const override
@@ -86,7 +106,7 @@ namespace KJK
 	{
 	public:
 		MouseButtonReleasedEvent(int button)
-			: MouseButtonEvent(button) {
+			: MouseButtonEvent(GetStaticType(), button) {
 		}
 
 		std::string ToString() const override
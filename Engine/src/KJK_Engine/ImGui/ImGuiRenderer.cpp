@@ -0,0 +1,78 @@
+#include "ImGuiRenderer.h"
+
+#include "KJK_Engine/Core/Logger.h"
+
+#include <imgui.h>
+#include <imgui_impl_opengl3.h>
+#include <imgui_impl_sdl3.h>
+
+namespace KJK
+{
+	namespace
+	{
+		bool s_Initialized = false;
+	}
+
+	//Create the ImGui context and the SDL and OpenGL backends, requires a current OpenGL context
+	void ImGuiRenderer::Init(SDL_Window* window, SDL_GLContext context)
+	{
+		IMGUI_CHECKVERSION();
+		ImGui::CreateContext();
+
+		//Don't write the window layout next to the executable
+		ImGuiIO& io = ImGui::GetIO();
+		io.IniFilename = nullptr;
+
+		ImGui::StyleColorsDark();
+
+		if (!ImGui_ImplSDL3_InitForOpenGL(window, context) || !ImGui_ImplOpenGL3_Init("#version 450"))
+		{
+			KJK_CORE_ERROR("Failed to initialize the ImGui backends!");
+			ImGui::DestroyContext();
+			return;
+		}
+
+		s_Initialized = true;
+		KJK_CORE_INFO("Initialized ImGui {0}", IMGUI_VERSION);
+	}
+
+	//Destroy the backends and the ImGui context, called before the OpenGL context is destroyed
+	void ImGuiRenderer::Shutdown()
+	{
+		if (!s_Initialized)
+			return;
+
+		ImGui_ImplOpenGL3_Shutdown();
+		ImGui_ImplSDL3_Shutdown();
+		ImGui::DestroyContext();
+		s_Initialized = false;
+	}
+
+	//Forward an SDL event to ImGui
+	void ImGuiRenderer::ProcessEvent(const SDL_Event& event)
+	{
+		if (s_Initialized)
+			ImGui_ImplSDL3_ProcessEvent(&event);
+	}
+
+	//Start a new ImGui frame, windows can be submitted until EndFrame
+	void ImGuiRenderer::BeginFrame()
+	{
+		ImGui_ImplOpenGL3_NewFrame();
+		ImGui_ImplSDL3_NewFrame();
+		ImGui::NewFrame();
+	}
+
+	//Render the submitted windows into the bound framebuffer
+	void ImGuiRenderer::EndFrame()
+	{
+		ImGui::Render();
+		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	}
+
+	//Check if ImGui was initialized
+	bool ImGuiRenderer::IsInitialized()
+	{
+		return s_Initialized;
+	}
+}
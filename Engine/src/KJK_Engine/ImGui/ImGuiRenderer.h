@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SDL3/SDL_events.h>
+#include <SDL3/SDL_video.h>
+
+namespace KJK
+{
+	//Dear ImGui setup for an SDL window with an OpenGL context
+	class ImGuiRenderer
+	{
+	public:
+		//Create the ImGui context and the SDL and OpenGL backends, requires a current OpenGL context
+		static void Init(SDL_Window* window, SDL_GLContext context);
+		//Destroy the backends and the ImGui context, called before the OpenGL context is destroyed
+		static void Shutdown();
+
+		//Forward an SDL event to ImGui, ignored until Init ran
+		static void ProcessEvent(const SDL_Event& event);
+
+		//Start a new ImGui frame, windows can be submitted until EndFrame
+		static void BeginFrame();
+		//Render the submitted windows into the bound framebuffer
+		static void EndFrame();
+
+		//Check if ImGui was initialized
+		static bool IsInitialized();
+	};
+}
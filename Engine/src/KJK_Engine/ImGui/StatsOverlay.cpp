@@ -0,0 +1,99 @@
+#include "StatsOverlay.h"
+
+#include "KJK_Engine/Core/MemoryTracker.h"
+#include "KJK_Engine/Core/Stats.h"
+
+#include <imgui.h>
+
+#include <cfloat>
+
+namespace KJK
+{
+	//Submit the overlay window, must be called between ImGuiRenderer::BeginFrame and EndFrame
+	void StatsOverlay::Draw()
+	{
+		//Passive window in the top left corner that never takes input from the application
+		ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Always);
+		ImGui::SetNextWindowBgAlpha(0.6f);
+		ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings
+			| ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoInputs;
+
+		if (!ImGui::Begin("Stats", nullptr, flags))
+		{
+			ImGui::End();
+			return;
+		}
+
+		ImGui::Text("Frame %llu", static_cast<unsigned long long>(Stats::GetFrameCount()));
+
+		//Graph of every gauge, so hitches stand out next to the percentiles
+		static std::array<float, StatHistory::Capacity> s_Values;
+		Stats::ForEach([](const std::string& name, StatType type, const StatHistory& history)
+		{
+			if (type != StatType::Gauge || history.GetSize() == 0)
+				return;
+
+			size_t count = history.CopyOrdered(s_Values.data());
+			ImGui::PlotLines(name.c_str(), s_Values.data(), static_cast<int>(count), 0, nullptr, 0.0f, FLT_MAX, ImVec2(320.0f, 50.0f));
+		});
+
+		//Table with the percentiles over the rolling window
+		if (ImGui::BeginTable("StatsTable", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+		{
+			ImGui::TableSetupColumn("Stat");
+			ImGui::TableSetupColumn("Last");
+			ImGui::TableSetupColumn("p50");
+			ImGui::TableSetupColumn("p95");
+			ImGui::TableSetupColumn("p99");
+			ImGui::TableSetupColumn("Max");
+			ImGui::TableHeadersRow();
+
+			Stats::ForEach([](const std::string& name, StatType type, const StatHistory& history)
+			{
+				StatSummary summary = history.Summarize();
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(name.c_str());
+				for (float value : { summary.Last, summary.P50, summary.P95, summary.P99, summary.Max })
+				{
+					ImGui::TableNextColumn();
+					ImGui::Text(type == StatType::Gauge ? "%.2f" : "%.0f", value);
+				}
+			});
+
+			ImGui::EndTable();
+		}
+
+		//Live memory per subsystem, GPU sizes are estimates from the tracked resources
+		if (ImGui::BeginTable("MemoryTable", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+		{
+			ImGui::TableSetupColumn("Memory");
+			ImGui::TableSetupColumn("CPU MiB");
+			ImGui::TableSetupColumn("Allocs");
+			ImGui::TableSetupColumn("GPU MiB");
+			ImGui::TableHeadersRow();
+
+			for (size_t i = 0; i < static_cast<size_t>(MemoryCategory::Count); i++)
+			{
+				MemoryCategory category = static_cast<MemoryCategory>(i);
+				MemoryCategoryStats memory = MemoryTracker::GetCategoryStats(category);
+				if (memory.CpuAllocations == 0 && memory.GpuResources == 0)
+					continue;
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(MemoryTracker::GetCategoryName(category));
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", static_cast<double>(memory.CpuBytes) / (1024.0 * 1024.0));
+				ImGui::TableNextColumn();
+				ImGui::Text("%lld", static_cast<long long>(memory.CpuAllocations));
+				ImGui::TableNextColumn();
+				ImGui::Text("%.2f", static_cast<double>(memory.GpuBytes) / (1024.0 * 1024.0));
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+}
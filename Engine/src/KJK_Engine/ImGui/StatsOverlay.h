@@ -0,0 +1,12 @@
+#pragma once
+
+namespace KJK
+{
+	//ImGui window showing the stats registry with percentiles and frame graphs, and the memory per subsystem
+	class StatsOverlay
+	{
+	public:
+		//Submit the overlay window, must be called between ImGuiRenderer::BeginFrame and EndFrame
+		static void Draw();
+	};
+}
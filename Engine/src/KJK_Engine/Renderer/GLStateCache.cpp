@@ -0,0 +1,402 @@
+#include "GLStateCache.h"
+
+#include <glad/glad.h>
+
+#include <array>
+
+namespace KJK
+{
+	namespace
+	{
+		//Value of state that isn't known, never a valid name or enum
+		constexpr uint32_t s_Unknown = UINT32_MAX;
+		//Texture units whose bindings are tracked, binds to higher units always reach the driver
+		constexpr uint32_t s_MaxTextureUnits = 32;
+
+		//Texture targets tracked per unit
+		constexpr std::array<GLenum, 5> s_TextureTargets = { GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_2D_ARRAY, GL_TEXTURE_3D };
+		//Capabilities tracked by Enable and Disable
+		constexpr std::array<GLenum, 6> s_Capabilities = { GL_BLEND, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_CULL_FACE, GL_MULTISAMPLE, GL_SCISSOR_TEST };
+
+		//Tracked state, s_Unknown where the state isn't known
+		struct State
+		{
+			uint32_t Program;
+			uint32_t VertexArray;
+			uint32_t ActiveTextureUnit;
+			std::array<std::array<uint32_t, s_TextureTargets.size()>, s_MaxTextureUnits> Textures;
+			uint32_t ReadFramebuffer;
+			uint32_t DrawFramebuffer;
+
+			//Capabilities are s_Unknown, GL_FALSE or GL_TRUE
+			std::array<uint32_t, s_Capabilities.size()> Capabilities;
+			uint32_t BlendSource;
+			uint32_t BlendDestination;
+			uint32_t BlendEquation;
+			uint32_t DepthFunction;
+			uint32_t DepthMask;
+			//The stencil function decides if the reference and mask are known, any mask is valid so none can mark it unknown
+			uint32_t StencilFunction;
+			int32_t StencilReference;
+			uint32_t StencilFunctionMask;
+			uint32_t StencilFail;
+			uint32_t StencilDepthFail;
+			uint32_t StencilDepthPass;
+			uint32_t StencilMask;
+			bool StencilMaskKnown;
+			uint32_t CullFace;
+			uint32_t FrontFace;
+		};
+
+		//Create a state where nothing is known, so the first call of every kind reaches the driver
+		State CreateUnknownState()
+		{
+			State state;
+			state.Program = s_Unknown;
+			state.VertexArray = s_Unknown;
+			state.ActiveTextureUnit = s_Unknown;
+			for (auto& targets : state.Textures)
+				targets.fill(s_Unknown);
+			state.ReadFramebuffer = s_Unknown;
+			state.DrawFramebuffer = s_Unknown;
+
+			state.Capabilities.fill(s_Unknown);
+			state.BlendSource = s_Unknown;
+			state.BlendDestination = s_Unknown;
+			state.BlendEquation = s_Unknown;
+			state.DepthFunction = s_Unknown;
+			state.DepthMask = s_Unknown;
+			state.StencilFunction = s_Unknown;
+			state.StencilReference = 0;
+			state.StencilFunctionMask = 0;
+			state.StencilFail = s_Unknown;
+			state.StencilDepthFail = s_Unknown;
+			state.StencilDepthPass = s_Unknown;
+			state.StencilMask = 0;
+			state.StencilMaskKnown = false;
+			state.CullFace = s_Unknown;
+			state.FrontFace = s_Unknown;
+			return state;
+		}
+
+		State s_State = CreateUnknownState();
+		GLStateCacheStats s_Stats;
+
+		//Index of a tracked texture target, or -1 if the target isn't tracked
+		inline int GetTextureTargetIndex(GLenum target)
+		{
+			for (size_t i = 0; i < s_TextureTargets.size(); i++)
+			{
+				if (s_TextureTargets[i] == target)
+					return static_cast<int>(i);
+			}
+			return -1;
+		}
+
+		//Index of a tracked capability, or -1 if the capability isn't tracked
+		inline int GetCapabilityIndex(GLenum capability)
+		{
+			for (size_t i = 0; i < s_Capabilities.size(); i++)
+			{
+				if (s_Capabilities[i] == capability)
+					return static_cast<int>(i);
+			}
+			return -1;
+		}
+
+		//Count a skipped call of a kind
+		inline void CountFiltered(uint64_t& kind)
+		{
+			kind++;
+			s_Stats.Filtered++;
+		}
+
+		//Make a texture unit active if it isn't already
+		inline void SetActiveTextureUnit(uint32_t unit)
+		{
+			if (s_State.ActiveTextureUnit == unit)
+				return;
+
+			glActiveTexture(GL_TEXTURE0 + unit);
+			s_State.ActiveTextureUnit = unit;
+			s_Stats.Issued++;
+		}
+
+		//Enable or disable a capability if it isn't set that way already
+		void SetCapability(GLenum capability, bool enabled)
+		{
+			int index = GetCapabilityIndex(capability);
+			uint32_t value = enabled ? GL_TRUE : GL_FALSE;
+			if (index >= 0 && s_State.Capabilities[index] == value)
+			{
+				CountFiltered(s_Stats.FilteredRenderStates);
+				return;
+			}
+
+			if (enabled)
+				glEnable(capability);
+			else
+				glDisable(capability);
+			if (index >= 0)
+				s_State.Capabilities[index] = value;
+			s_Stats.Issued++;
+		}
+	}
+
+	void GLStateCache::Init()
+	{
+		s_Stats = GLStateCacheStats();
+		Invalidate();
+	}
+
+	void GLStateCache::Shutdown()
+	{
+		Invalidate();
+	}
+
+	void GLStateCache::Invalidate()
+	{
+		s_State = CreateUnknownState();
+	}
+
+	void GLStateCache::UseProgram(uint32_t program)
+	{
+		if (s_State.Program == program)
+		{
+			CountFiltered(s_Stats.FilteredPrograms);
+			return;
+		}
+
+		glUseProgram(program);
+		s_State.Program = program;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::BindVertexArray(uint32_t vertexArray)
+	{
+		if (s_State.VertexArray == vertexArray)
+		{
+			CountFiltered(s_Stats.FilteredVertexArrays);
+			return;
+		}
+
+		glBindVertexArray(vertexArray);
+		s_State.VertexArray = vertexArray;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::BindTexture(uint32_t unit, uint32_t target, uint32_t texture)
+	{
+		int targetIndex = GetTextureTargetIndex(target);
+		bool tracked = unit < s_MaxTextureUnits && targetIndex >= 0;
+		if (tracked && s_State.Textures[unit][targetIndex] == texture)
+		{
+			CountFiltered(s_Stats.FilteredTextures);
+			return;
+		}
+
+		SetActiveTextureUnit(unit);
+		glBindTexture(target, texture);
+		if (tracked)
+			s_State.Textures[unit][targetIndex] = texture;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::BindFramebuffer(uint32_t target, uint32_t framebuffer)
+	{
+		bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+		bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+		if ((!read || s_State.ReadFramebuffer == framebuffer) && (!draw || s_State.DrawFramebuffer == framebuffer))
+		{
+			CountFiltered(s_Stats.FilteredFramebuffers);
+			return;
+		}
+
+		glBindFramebuffer(target, framebuffer);
+		if (read)
+			s_State.ReadFramebuffer = framebuffer;
+		if (draw)
+			s_State.DrawFramebuffer = framebuffer;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::DeleteProgram(uint32_t program)
+	{
+		glDeleteProgram(program);
+
+		//A current program is only flagged for deletion, but its replacement must not be filtered
+		if (s_State.Program == program)
+			s_State.Program = s_Unknown;
+	}
+
+	void GLStateCache::DeleteVertexArray(uint32_t vertexArray)
+	{
+		glDeleteVertexArrays(1, &vertexArray);
+
+		if (s_State.VertexArray == vertexArray)
+			s_State.VertexArray = 0;
+	}
+
+	void GLStateCache::DeleteTexture(uint32_t texture)
+	{
+		glDeleteTextures(1, &texture);
+
+		for (auto& targets : s_State.Textures)
+		{
+			for (uint32_t& bound : targets)
+			{
+				if (bound == texture)
+					bound = 0;
+			}
+		}
+	}
+
+	void GLStateCache::DeleteFramebuffer(uint32_t framebuffer)
+	{
+		glDeleteFramebuffers(1, &framebuffer);
+
+		if (s_State.ReadFramebuffer == framebuffer)
+			s_State.ReadFramebuffer = 0;
+		if (s_State.DrawFramebuffer == framebuffer)
+			s_State.DrawFramebuffer = 0;
+	}
+
+	void GLStateCache::Enable(uint32_t capability)
+	{
+		SetCapability(capability, true);
+	}
+
+	void GLStateCache::Disable(uint32_t capability)
+	{
+		SetCapability(capability, false);
+	}
+
+	void GLStateCache::BlendFunc(uint32_t source, uint32_t destination)
+	{
+		if (s_State.BlendSource == source && s_State.BlendDestination == destination)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glBlendFunc(source, destination);
+		s_State.BlendSource = source;
+		s_State.BlendDestination = destination;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::BlendEquation(uint32_t mode)
+	{
+		if (s_State.BlendEquation == mode)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glBlendEquation(mode);
+		s_State.BlendEquation = mode;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::DepthFunc(uint32_t function)
+	{
+		if (s_State.DepthFunction == function)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glDepthFunc(function);
+		s_State.DepthFunction = function;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::DepthMask(bool enabled)
+	{
+		uint32_t value = enabled ? GL_TRUE : GL_FALSE;
+		if (s_State.DepthMask == value)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glDepthMask(static_cast<GLboolean>(value));
+		s_State.DepthMask = value;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::StencilFunc(uint32_t function, int32_t reference, uint32_t mask)
+	{
+		if (s_State.StencilFunction == function && s_State.StencilReference == reference && s_State.StencilFunctionMask == mask)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glStencilFunc(function, reference, mask);
+		s_State.StencilFunction = function;
+		s_State.StencilReference = reference;
+		s_State.StencilFunctionMask = mask;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::StencilOp(uint32_t stencilFail, uint32_t depthFail, uint32_t depthPass)
+	{
+		if (s_State.StencilFail == stencilFail && s_State.StencilDepthFail == depthFail && s_State.StencilDepthPass == depthPass)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glStencilOp(stencilFail, depthFail, depthPass);
+		s_State.StencilFail = stencilFail;
+		s_State.StencilDepthFail = depthFail;
+		s_State.StencilDepthPass = depthPass;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::StencilMask(uint32_t mask)
+	{
+		if (s_State.StencilMaskKnown && s_State.StencilMask == mask)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glStencilMask(mask);
+		s_State.StencilMask = mask;
+		s_State.StencilMaskKnown = true;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::CullFace(uint32_t mode)
+	{
+		if (s_State.CullFace == mode)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glCullFace(mode);
+		s_State.CullFace = mode;
+		s_Stats.Issued++;
+	}
+
+	void GLStateCache::FrontFace(uint32_t mode)
+	{
+		if (s_State.FrontFace == mode)
+		{
+			CountFiltered(s_Stats.FilteredRenderStates);
+			return;
+		}
+
+		glFrontFace(mode);
+		s_State.FrontFace = mode;
+		s_Stats.Issued++;
+	}
+
+	const GLStateCacheStats& GLStateCache::GetStats()
+	{
+		return s_Stats;
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+namespace KJK
+{
+	//Counters of the state cache since it was initialized
+	struct GLStateCacheStats
+	{
+		//Calls passed on to the driver, including texture unit switches made to bind a texture
+		uint64_t Issued = 0;
+		//Calls skipped because the state was already set
+		uint64_t Filtered = 0;
+
+		//Skipped calls by kind, they add up to Filtered
+		uint64_t FilteredPrograms = 0;
+		uint64_t FilteredVertexArrays = 0;
+		uint64_t FilteredTextures = 0;
+		uint64_t FilteredFramebuffers = 0;
+		uint64_t FilteredRenderStates = 0;
+	};
+
+	//Shadow of the OpenGL state that skips calls setting state that is already set
+	//Tracks the program, the vertex array, the textures per unit, the framebuffers and the blend, depth, stencil and cull state
+	//State changed by direct OpenGL calls isn't seen, so tracked state has to be changed through the cache or forgotten with Invalidate
+	//Objects have to be deleted through the cache as well, so a recycled name isn't mistaken for the deleted object
+	//Only used on the thread owning the OpenGL context
+	class GLStateCache
+	{
+	public:
+		//Forget all state and reset the counters, called once the OpenGL context is current
+		static void Init();
+		//Forget all state, called before the OpenGL context is destroyed
+		static void Shutdown();
+
+		//Forget all state, the next call of every kind reaches the driver
+		//Needed after code outside the cache changed tracked state or another context was made current
+		static void Invalidate();
+
+		//Make a program current
+		static void UseProgram(uint32_t program);
+		//Bind a vertex array
+		static void BindVertexArray(uint32_t vertexArray);
+		//Bind a texture to a target of a texture unit, the unit is an index starting at 0 instead of GL_TEXTURE0
+		//Switches the active texture unit only when the binding changes
+		static void BindTexture(uint32_t unit, uint32_t target, uint32_t texture);
+		//Bind a framebuffer to GL_FRAMEBUFFER, GL_READ_FRAMEBUFFER or GL_DRAW_FRAMEBUFFER
+		static void BindFramebuffer(uint32_t target, uint32_t framebuffer);
+
+		//Delete a program, the next UseProgram always reaches the driver
+		static void DeleteProgram(uint32_t program);
+		//Delete a vertex array, bindings of it fall back to 0 like in OpenGL
+		static void DeleteVertexArray(uint32_t vertexArray);
+		//Delete a texture, bindings of it fall back to 0 like in OpenGL
+		static void DeleteTexture(uint32_t texture);
+		//Delete a framebuffer, bindings of it fall back to 0 like in OpenGL
+		static void DeleteFramebuffer(uint32_t framebuffer);
+
+		//Enable a capability, GL_BLEND, GL_DEPTH_TEST, GL_STENCIL_TEST, GL_CULL_FACE, GL_MULTISAMPLE and GL_SCISSOR_TEST are tracked
+		//Other capabilities always reach the driver
+		static void Enable(uint32_t capability);
+		//Disable a capability, tracked like in Enable
+		static void Disable(uint32_t capability);
+
+		//Set the blend factors
+		static void BlendFunc(uint32_t source, uint32_t destination);
+		//Set the blend equation
+		static void BlendEquation(uint32_t mode);
+		//Set the depth comparison function
+		static void DepthFunc(uint32_t function);
+		//Enable or disable writing to the depth buffer
+		static void DepthMask(bool enabled);
+		//Set the stencil test function, reference value and mask
+		static void StencilFunc(uint32_t function, int32_t reference, uint32_t mask);
+		//Set the stencil operations
+		static void StencilOp(uint32_t stencilFail, uint32_t depthFail, uint32_t depthPass);
+		//Set the stencil write mask
+		static void StencilMask(uint32_t mask);
+		//Set the faces that are culled
+		static void CullFace(uint32_t mode);
+		//Set the winding of front faces
+		static void FrontFace(uint32_t mode);
+
+		//Getter for the counters since the cache was initialized
+		static const GLStateCacheStats& GetStats();
+	};
+}
@@ -0,0 +1,243 @@
+#include "GpuProfiler.h"
+
+#include "KJK_Engine/Core/Clock.h"
+#include "KJK_Engine/Core/Logger.h"
+
+#include <glad/glad.h>
+
+namespace KJK
+{
+	namespace
+	{
+		//Number of frames whose queries are in flight, results are read at the latest when the slot is reused
+		constexpr uint32_t s_FrameLatency = 4;
+		//Number of passes that can be measured per frame
+		constexpr uint32_t s_MaxPassesPerFrame = 64;
+
+		//Pass recorded during a frame
+		struct PassRecord
+		{
+			const char* Name;
+			uint32_t Depth;
+			uint64_t CpuStartNs;
+			uint64_t CpuEndNs;
+			bool Ended;
+		};
+
+		//Queries and passes of a frame in the ring
+		struct FrameQueries
+		{
+			//Start and end timestamp query of every pass
+			GLuint Queries[s_MaxPassesPerFrame * 2] = {};
+			std::vector<PassRecord> Passes;
+			//Query issued last, queries complete in order so all results are available once this one is
+			GLuint LastQuery = 0;
+			uint64_t FrameIndex = 0;
+			//Set while queries were issued whose results haven't been read
+			bool Pending = false;
+		};
+
+		bool s_Initialized = false;
+		std::array<FrameQueries, s_FrameLatency> s_Frames;
+		uint64_t s_FrameIndex = 0;
+		//Passes of the current frame that haven't ended yet
+		std::vector<uint32_t> s_OpenPasses;
+
+		std::vector<GpuPassTiming> s_Results;
+		uint64_t s_ResultFrameIndex = 0;
+		uint64_t s_DroppedFrames = 0;
+		bool s_WarnedPassLimit = false;
+
+		//Getter for the ring slot of the current frame
+		inline FrameQueries& CurrentFrame()
+		{
+			return s_Frames[s_FrameIndex % s_FrameLatency];
+		}
+
+		//Read the results of a frame if the GPU finished it, returns false without waiting otherwise
+		bool TryResolve(FrameQueries& frame)
+		{
+			GLint available = 0;
+			glGetQueryObjectiv(frame.LastQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (!available)
+				return false;
+
+			s_Results.clear();
+			for (uint32_t i = 0; i < frame.Passes.size(); i++)
+			{
+				const PassRecord& pass = frame.Passes[i];
+				if (!pass.Ended)
+					continue;
+
+				GLuint64 startNs = 0;
+				GLuint64 endNs = 0;
+				glGetQueryObjectui64v(frame.Queries[i * 2], GL_QUERY_RESULT, &startNs);
+				glGetQueryObjectui64v(frame.Queries[i * 2 + 1], GL_QUERY_RESULT, &endNs);
+
+				GpuPassTiming timing;
+				timing.Name = pass.Name;
+				timing.Depth = pass.Depth;
+				timing.GpuMs = static_cast<float>(static_cast<double>(endNs - startNs) / 1000000.0);
+				timing.CpuMs = static_cast<float>(static_cast<double>(pass.CpuEndNs - pass.CpuStartNs) / 1000000.0);
+				s_Results.push_back(timing);
+			}
+
+			s_ResultFrameIndex = frame.FrameIndex;
+			frame.Pending = false;
+			return true;
+		}
+	}
+
+	//Create the query ring, requires a current OpenGL context
+	void GpuProfiler::Init()
+	{
+		//Timestamp queries report 0 counter bits when the driver doesn't support them
+		GLint counterBits = 0;
+		glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+		if (counterBits == 0)
+		{
+			KJK_CORE_WARN("Timestamp queries are not supported, GPU profiling is disabled");
+			return;
+		}
+
+		for (FrameQueries& frame : s_Frames)
+		{
+			glGenQueries(s_MaxPassesPerFrame * 2, frame.Queries);
+			frame.Passes.reserve(s_MaxPassesPerFrame);
+			frame.Pending = false;
+		}
+		s_OpenPasses.reserve(s_MaxPassesPerFrame);
+		s_Results.reserve(s_MaxPassesPerFrame);
+		s_Initialized = true;
+
+		KJK_CORE_INFO("Initialized the GPU profiler with {0} frames of query latency", s_FrameLatency);
+	}
+
+	//Delete all queries, called before the OpenGL context is destroyed
+	void GpuProfiler::Shutdown()
+	{
+		if (!s_Initialized)
+			return;
+
+		for (FrameQueries& frame : s_Frames)
+		{
+			glDeleteQueries(s_MaxPassesPerFrame * 2, frame.Queries);
+			frame.Passes.clear();
+			frame.Pending = false;
+		}
+		s_OpenPasses.clear();
+		s_Results.clear();
+		s_Initialized = false;
+
+		if (s_DroppedFrames > 0)
+			KJK_CORE_WARN("GPU profiler dropped the results of {0} frames", s_DroppedFrames);
+	}
+
+	//Mark the start of a new frame, reads the results of older frames that are available
+	void GpuProfiler::BeginFrame()
+	{
+		if (!s_Initialized)
+			return;
+
+		if (!s_OpenPasses.empty())
+		{
+			KJK_CORE_WARN("{0} GPU passes were not ended before the next frame", s_OpenPasses.size());
+			s_OpenPasses.clear();
+		}
+
+		s_FrameIndex++;
+
+		//Read the finished frames oldest first, the oldest one is dropped if its slot is needed before the GPU finished it
+		for (uint32_t age = s_FrameLatency; age >= 1; age--)
+		{
+			if (age > s_FrameIndex)
+				continue;
+
+			FrameQueries& frame = s_Frames[(s_FrameIndex - age) % s_FrameLatency];
+			if (!frame.Pending || TryResolve(frame))
+				continue;
+
+			if (age == s_FrameLatency)
+			{
+				frame.Pending = false;
+				s_DroppedFrames++;
+				continue;
+			}
+
+			//Newer frames can't be finished before an older one
+			break;
+		}
+
+		FrameQueries& frame = CurrentFrame();
+		frame.Passes.clear();
+		frame.FrameIndex = s_FrameIndex;
+	}
+
+	//Start a pass in the current frame, passes can be nested, returns the pass index
+	uint32_t GpuProfiler::BeginPass(const char* name)
+	{
+		if (!s_Initialized)
+			return InvalidPass;
+
+		FrameQueries& frame = CurrentFrame();
+		if (frame.Passes.size() >= s_MaxPassesPerFrame)
+		{
+			if (!s_WarnedPassLimit)
+			{
+				s_WarnedPassLimit = true;
+				KJK_CORE_WARN("More than {0} GPU passes in a frame, the remaining ones are not measured", s_MaxPassesPerFrame);
+			}
+			return InvalidPass;
+		}
+
+		uint32_t pass = static_cast<uint32_t>(frame.Passes.size());
+		frame.Passes.push_back({ name, static_cast<uint32_t>(s_OpenPasses.size()), Clock::GetTimeNs(), 0, false });
+		glQueryCounter(frame.Queries[pass * 2], GL_TIMESTAMP);
+		frame.LastQuery = frame.Queries[pass * 2];
+		frame.Pending = true;
+
+		s_OpenPasses.push_back(pass);
+		return pass;
+	}
+
+	//Finish a pass started with BeginPass
+	void GpuProfiler::EndPass(uint32_t pass)
+	{
+		FrameQueries& frame = CurrentFrame();
+		if (pass == InvalidPass || pass >= frame.Passes.size() || frame.Passes[pass].Ended)
+			return;
+
+		glQueryCounter(frame.Queries[pass * 2 + 1], GL_TIMESTAMP);
+		frame.LastQuery = frame.Queries[pass * 2 + 1];
+		frame.Passes[pass].CpuEndNs = Clock::GetTimeNs();
+		frame.Passes[pass].Ended = true;
+
+		auto open = std::find(s_OpenPasses.begin(), s_OpenPasses.end(), pass);
+		if (open != s_OpenPasses.end())
+			s_OpenPasses.erase(open);
+	}
+
+	//Getter for the pass timings of the most recent frame whose results arrived, in the order the passes started
+	const std::vector<GpuPassTiming>& GpuProfiler::GetResults()
+	{
+		return s_Results;
+	}
+
+	//Getter for the index of the frame being recorded, results of this frame carry the same index
+	uint64_t GpuProfiler::GetFrameIndex()
+	{
+		return s_FrameIndex;
+	}
+
+	//Getter for the index of the frame the results belong to
+	uint64_t GpuProfiler::GetResultFrameIndex()
+	{
+		return s_ResultFrameIndex;
+	}
+
+	//Getter for the number of frames whose results were dropped because the GPU fell too far behind
+	uint64_t GpuProfiler::GetDroppedFrameCount()
+	{
+		return s_DroppedFrames;
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "KJK_Engine/Core/Profiler.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace KJK
+{
+	//GPU and CPU time of a render pass in a resolved frame
+	struct GpuPassTiming
+	{
+		//Name of the pass
+		const char* Name = "";
+		//Number of enclosing passes
+		uint32_t Depth = 0;
+		//Time the GPU spent between the start and the end of the pass, in milliseconds
+		float GpuMs = 0.0f;
+		//Time the CPU spent submitting the pass, in milliseconds
+		float CpuMs = 0.0f;
+	};
+
+	//Per pass GPU profiler built on OpenGL timestamp queries
+	//Queries of the last few frames stay in flight in a ring, results are read once available so the pipeline never stalls
+	class GpuProfiler
+	{
+	public:
+		//Index returned for passes that couldn't be recorded
+		static constexpr uint32_t InvalidPass = UINT32_MAX;
+
+		//Create the query ring, requires a current OpenGL context
+		static void Init();
+		//Delete all queries, called before the OpenGL context is destroyed
+		static void Shutdown();
+
+		//Mark the start of a new frame, reads the results of older frames that are available
+		static void BeginFrame();
+
+		//Start a pass in the current frame, passes can be nested, returns the pass index
+		static uint32_t BeginPass(const char* name);
+		//Finish a pass started with BeginPass
+		static void EndPass(uint32_t pass);
+
+		//Getter for the pass timings of the most recent frame whose results arrived, in the order the passes started
+		static const std::vector<GpuPassTiming>& GetResults();
+		//Getter for the index of the frame being recorded, results of this frame carry the same index
+		static uint64_t GetFrameIndex();
+		//Getter for the index of the frame the results belong to
+		static uint64_t GetResultFrameIndex();
+		//Getter for the number of frames whose results were dropped because the GPU fell too far behind
+		static uint64_t GetDroppedFrameCount();
+	};
+
+	//Pass measuring the GPU and CPU time of the commands issued in a scope, the name has to outlive the results
+	class GpuProfileScope
+	{
+	public:
+		inline GpuProfileScope(const char* name)
+			: m_Pass(GpuProfiler::BeginPass(name))
+		{
+		}
+
+		inline ~GpuProfileScope()
+		{
+			GpuProfiler::EndPass(m_Pass);
+		}
+
+		//Disable copy semantics
+		GpuProfileScope(const GpuProfileScope& other) = delete;
+		GpuProfileScope& operator=(const GpuProfileScope& other) = delete;
+	private:
+		uint32_t m_Pass;
+	};
+}
+
+#if KJK_ENABLE_PROFILER
+	//Measure the GPU time of the commands issued in the rest of the current scope
+	#define KJK_PROFILE_GPU(name) ::KJK::GpuProfileScope KJK_PROFILE_CONCAT(kjkGpuProfileScope, __LINE__)(name)
+#else
+	#define KJK_PROFILE_GPU(name)
+#endif
@@ -0,0 +1,233 @@
+#include "ProgramCache.h"
+
+#include "KJK_Engine/Core/Hash.h"
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/Profiler.h"
+
+#include <glad/glad.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace KJK
+{
+	namespace
+	{
+		//Identifies cache files and their layout, bump the version when the layout changes
+		constexpr uint32_t s_FileMagic = 0x504B4A4B; //"KJKP"
+		constexpr uint32_t s_FileVersion = 1;
+		//Larger binaries are treated as corrupt files
+		constexpr uint32_t s_MaxBinarySize = 64 * 1024 * 1024;
+
+		//Header in front of the binary in a cache file
+		struct FileHeader
+		{
+			uint32_t Magic;
+			uint32_t Version;
+			uint64_t Key;
+			uint32_t Format;
+			uint32_t Length;
+		};
+
+		bool s_Enabled = false;
+		std::filesystem::path s_Directory;
+		//Hash of the driver strings, part of every key
+		uint64_t s_DriverHash = 0;
+		ProgramCacheStats s_Stats;
+
+		//Hash an OpenGL string, which can be null on broken contexts
+		uint64_t HashGLString(uint64_t hash, GLenum name)
+		{
+			const char* value = reinterpret_cast<const char*>(glGetString(name));
+			if (value == nullptr)
+				return hash;
+			return HashFNV1a(value, std::strlen(value) + 1, hash);
+		}
+
+		//Path of the cache file of a key
+		std::filesystem::path GetFilePath(uint64_t key)
+		{
+			char name[32];
+			std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+			return s_Directory / name;
+		}
+
+		//Delete a cache file that can't be used, so it's replaced by the next compile
+		void RemoveFile(const std::filesystem::path& path)
+		{
+			std::error_code error;
+			std::filesystem::remove(path, error);
+		}
+	}
+
+	bool ProgramCache::Init(const std::string& directory)
+	{
+		s_Enabled = false;
+		s_Stats = ProgramCacheStats();
+
+		//Drivers without any binary format can't store programs
+		GLint formatCount = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+		if (formatCount <= 0)
+		{
+			KJK_CORE_WARN("The OpenGL driver doesn't support program binaries, the program cache is disabled");
+			return false;
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(directory, error);
+		if (error)
+		{
+			KJK_CORE_ERROR("Failed to create the program cache directory {0}: {1}", directory, error.message());
+			return false;
+		}
+
+		//Binaries only load on the driver that wrote them
+		s_DriverHash = FNV1aOffsetBasis;
+		s_DriverHash = HashGLString(s_DriverHash, GL_VENDOR);
+		s_DriverHash = HashGLString(s_DriverHash, GL_RENDERER);
+		s_DriverHash = HashGLString(s_DriverHash, GL_VERSION);
+
+		s_Directory = directory;
+		s_Enabled = true;
+		return true;
+	}
+
+	void ProgramCache::Shutdown()
+	{
+		s_Enabled = false;
+		s_Directory.clear();
+	}
+
+	bool ProgramCache::IsEnabled()
+	{
+		return s_Enabled;
+	}
+
+	uint64_t ProgramCache::ComputeKey(const std::vector<uint32_t>& stageTypes, const std::vector<std::string>& sources)
+	{
+		uint64_t key = HashFNV1a(&s_DriverHash, sizeof(s_DriverHash));
+		for (size_t i = 0; i < stageTypes.size() && i < sources.size(); i++)
+		{
+			//The length separates the sources, so moving code between stages changes the key
+			uint64_t length = sources[i].size();
+			key = HashFNV1a(&stageTypes[i], sizeof(stageTypes[i]), key);
+			key = HashFNV1a(&length, sizeof(length), key);
+			key = HashFNV1a(sources[i].data(), sources[i].size(), key);
+		}
+		return key;
+	}
+
+	uint32_t ProgramCache::Load(uint64_t key)
+	{
+		KJK_PROFILE_FUNCTION();
+
+		if (!s_Enabled)
+			return 0;
+
+		std::filesystem::path path = GetFilePath(key);
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+		{
+			s_Stats.Misses++;
+			return 0;
+		}
+
+		//Files from another version or cut short by a crash count as rejected
+		FileHeader header{};
+		std::vector<char> binary;
+		if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.Magic == s_FileMagic && header.Version == s_FileVersion
+			&& header.Key == key && header.Length > 0 && header.Length <= s_MaxBinarySize)
+		{
+			binary.resize(header.Length);
+			if (!file.read(binary.data(), header.Length))
+				binary.clear();
+		}
+		file.close();
+
+		GLuint program = 0;
+		GLint linked = GL_FALSE;
+		if (!binary.empty())
+		{
+			program = glCreateProgram();
+			glProgramBinary(program, header.Format, binary.data(), static_cast<GLsizei>(binary.size()));
+			glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		}
+
+		//Drivers may refuse binaries at any time, the program is compiled again then
+		if (linked != GL_TRUE)
+		{
+			if (program != 0)
+				glDeleteProgram(program);
+			RemoveFile(path);
+			s_Stats.Rejected++;
+			KJK_CORE_WARN("Rejected the cached program binary {0}, compiling the program again", path.generic_string());
+			return 0;
+		}
+
+		s_Stats.Hits++;
+		return program;
+	}
+
+	void ProgramCache::Store(uint64_t key, uint32_t program)
+	{
+		KJK_PROFILE_FUNCTION();
+
+		if (!s_Enabled)
+			return;
+
+		GLint length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0 || static_cast<uint32_t>(length) > s_MaxBinarySize)
+		{
+			KJK_CORE_WARN("Program {0} has no binary to cache", program);
+			return;
+		}
+
+		std::vector<char> binary(length);
+		GLsizei written = 0;
+		GLenum format = 0;
+		glGetProgramBinary(program, length, &written, &format, binary.data());
+		if (written <= 0)
+		{
+			KJK_CORE_WARN("Failed to get the binary of program {0}", program);
+			return;
+		}
+
+		FileHeader header{ s_FileMagic, s_FileVersion, key, format, static_cast<uint32_t>(written) };
+
+		//Write next to the final file and rename it, so a crash never leaves a partial binary behind
+		std::filesystem::path path = GetFilePath(key);
+		std::filesystem::path temporaryPath = path;
+		temporaryPath += ".tmp";
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(binary.data(), written);
+			if (!file)
+			{
+				KJK_CORE_WARN("Failed to write the program binary {0}", temporaryPath.generic_string());
+				file.close();
+				RemoveFile(temporaryPath);
+				return;
+			}
+		}
+
+		std::error_code error;
+		std::filesystem::rename(temporaryPath, path, error);
+		if (error)
+		{
+			KJK_CORE_WARN("Failed to store the program binary {0}: {1}", path.generic_string(), error.message());
+			RemoveFile(temporaryPath);
+			return;
+		}
+		s_Stats.Stored++;
+	}
+
+	const ProgramCacheStats& ProgramCache::GetStats()
+	{
+		return s_Stats;
+	}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace KJK
+{
+	//Counters of the program cache since it was initialized
+	struct ProgramCacheStats
+	{
+		//Programs created from a stored binary
+		uint32_t Hits = 0;
+		//Programs without a stored binary that had to be compiled
+		uint32_t Misses = 0;
+		//Stored binaries the driver refused, usually after a driver update, these are compiled as well
+		uint32_t Rejected = 0;
+		//Binaries written after a program was compiled
+		uint32_t Stored = 0;
+	};
+
+	//On disk cache of linked OpenGL program binaries, so later runs skip compiling and linking
+	//Binaries are keyed by the stage types, the stage sources and the driver, edited sources or another driver never load a stale binary
+	//Only used on the thread owning the OpenGL context
+	class ProgramCache
+	{
+	public:
+		//Store the binaries in a directory, requires a current OpenGL context
+		//Returns false and leaves the cache disabled if the driver can't provide program binaries
+		static bool Init(const std::string& directory);
+		//Disable the cache, the stored binaries stay on disk for the next run
+		static void Shutdown();
+
+		//Check if the cache was initialized and the driver supports program binaries
+		static bool IsEnabled();
+
+		//Compute the key of a program from the types and sources of its stages, in stage order
+		static uint64_t ComputeKey(const std::vector<uint32_t>& stageTypes, const std::vector<std::string>& sources);
+
+		//Create a linked program from the stored binary of a key, returns 0 if there is none or the driver rejected it
+		static uint32_t Load(uint64_t key);
+		//Store the binary of a linked program under a key, the program has to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+		static void Store(uint64_t key, uint32_t program);
+
+		//Getter for the counters since the cache was initialized
+		static const ProgramCacheStats& GetStats();
+	};
+}
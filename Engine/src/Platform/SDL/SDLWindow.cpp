@@ -0,0 +1,205 @@
+#include "SDLWindow.h"
+
+#include "KJK_Engine/Core/Logger.h"
+#include "KJK_Engine/Core/Profiler.h"
+#include "KJK_Engine/Core/Stats.h"
+#include "KJK_Engine/Events/ApplicationEvent.h"
+#include "KJK_Engine/Events/KeyEvent.h"
+#include "KJK_Engine/Events/MouseEvent.h"
+
+namespace KJK
+{
+	Window* Window::Create(const WindowProps& props)
+	{
+		SDLWindow* window = new SDLWindow(props);
+		if (!window->IsValid())
+		{
+			delete window;
+			return nullptr;
+		}
+		return window;
+	}
+
+	SDLWindow::SDLWindow(const WindowProps& props)
+		: m_Width(props.Width), m_Height(props.Height)
+	{
+		//Merge runs of mouse motion and resizes, a fast mouse or a window drag costs one event per update
+		m_Events.SetCoalescing(true);
+
+		if (!SDL_InitSubSystem(SDL_INIT_VIDEO))
+		{
+			KJK_CORE_ERROR("Failed to initialize SDL video: {0}", SDL_GetError());
+			return;
+		}
+		m_VideoInitialized = true;
+
+		//Use OpenGL 4.5 core with a stencil buffer
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 5);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+		SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
+		SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
+
+		m_Window = SDL_CreateWindow(props.Title.c_str(), static_cast<int>(props.Width), static_cast<int>(props.Height), SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE);
+		if (m_Window == nullptr)
+		{
+			KJK_CORE_ERROR("Failed to create window: {0}", SDL_GetError());
+			return;
+		}
+
+		m_Context = SDL_GL_CreateContext(m_Window);
+		if (m_Context == nullptr)
+		{
+			KJK_CORE_ERROR("Failed to create OpenGL context: {0}", SDL_GetError());
+			return;
+		}
+
+		//Load OpenGL functions using GLAD
+		if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress))
+		{
+			KJK_CORE_ERROR("Failed to initialize GLAD! SDL error: {0}", SDL_GetError());
+			SDL_GL_DestroyContext(m_Context);
+			m_Context = nullptr;
+			return;
+		}
+
+		KJK_CORE_INFO("Created window {0} ({1}x{2}) on {3}", props.Title, props.Width, props.Height, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+
+		SetVSyncMode(props.VSync);
+	}
+
+	SDLWindow::~SDLWindow()
+	{
+		if (m_Context != nullptr)
+			SDL_GL_DestroyContext(m_Context);
+		if (m_Window != nullptr)
+			SDL_DestroyWindow(m_Window);
+		if (m_VideoInitialized)
+			SDL_QuitSubSystem(SDL_INIT_VIDEO);
+	}
+
+	void SDLWindow::OnUpdate()
+	{
+		KJK_PROFILE_FUNCTION();
+
+		//Gather the pending OS events once, then take them out of SDL's queue a batch at a time
+		SDL_PumpEvents();
+
+		SDL_Event batch[s_EventBatchSize];
+		int count = 0;
+		do
+		{
+			count = SDL_PeepEvents(batch, s_EventBatchSize, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+			for (int i = 0; i < count; i++)
+			{
+				const SDL_Event& event = batch[i];
+				if (m_NativeEventCallback)
+					m_NativeEventCallback(event);
+
+				//Keep the size current for the getters before the callback sees the resize
+				if (event.type == SDL_EVENT_WINDOW_RESIZED)
+				{
+					m_Width = static_cast<unsigned int>(event.window.data1);
+					m_Height = static_cast<unsigned int>(event.window.data2);
+				}
+
+				TranslateEvent(event, m_Events);
+			}
+		}
+		while (count == s_EventBatchSize);
+
+		//Deliver the translated events in order, they are destroyed in place afterwards
+		KJK_STAT_ADD("Window events", m_Events.GetSize());
+		if (m_EventCallback)
+			m_Events.Flush(m_EventCallback);
+		else
+			m_Events.Clear();
+	}
+
+	void SDLWindow::SwapBuffers()
+	{
+		KJK_PROFILE_FUNCTION();
+		SDL_GL_SwapWindow(m_Window);
+	}
+
+	void SDLWindow::SetVSyncMode(VSyncMode mode)
+	{
+		//Adaptive sync is a negative swap interval, not every driver supports it
+		int interval = mode == VSyncMode::Adaptive ? -1 : (mode == VSyncMode::On ? 1 : 0);
+		if (!SDL_GL_SetSwapInterval(interval))
+		{
+			if (mode != VSyncMode::Adaptive)
+			{
+				KJK_CORE_ERROR("Failed to set the swap interval to {0}: {1}", interval, SDL_GetError());
+				return;
+			}
+
+			KJK_CORE_WARN("Adaptive vsync isn't supported, falling back to vsync: {0}", SDL_GetError());
+			mode = VSyncMode::On;
+			if (!SDL_GL_SetSwapInterval(1))
+			{
+				KJK_CORE_ERROR("Failed to enable vsync: {0}", SDL_GetError());
+				return;
+			}
+		}
+
+		m_VSyncMode = mode;
+	}
+
+	bool SDLWindow::TranslateEvent(const SDL_Event& event, EventQueue& queue)
+	{
+		switch (event.type)
+		{
+		case SDL_EVENT_QUIT:
+		case SDL_EVENT_WINDOW_CLOSE_REQUESTED:
+			queue.Emplace<WindowCloseEvent>();
+			return true;
+		case SDL_EVENT_WINDOW_RESIZED:
+			queue.Emplace<WindowResizeEvent>(event.window.data1, event.window.data2);
+			return true;
+		case SDL_EVENT_WINDOW_MOVED:
+			queue.Emplace<WindowMovedEvent>(event.window.data1, event.window.data2);
+			return true;
+		case SDL_EVENT_WINDOW_FOCUS_GAINED:
+			queue.Emplace<WindowFocusEvent>();
+			return true;
+		case SDL_EVENT_WINDOW_FOCUS_LOST:
+			queue.Emplace<WindowLostFocusEvent>();
+			return true;
+		case SDL_EVENT_KEY_DOWN:
+			queue.Emplace<KeyPressedEvent>(static_cast<int>(event.key.key), event.key.repeat ? 1 : 0, static_cast<int>(event.key.scancode));
+			return true;
+		case SDL_EVENT_KEY_UP:
+			queue.Emplace<KeyReleasedEvent>(static_cast<int>(event.key.key), static_cast<int>(event.key.scancode));
+			return true;
+		case SDL_EVENT_TEXT_INPUT:
+		{
+			//One typed event per code point of the UTF-8 text
+			const char* text = event.text.text;
+			size_t length = SDL_strlen(text);
+			while (length > 0)
+			{
+				Uint32 character = SDL_StepUTF8(&text, &length);
+				if (character == 0)
+					break;
+				queue.Emplace<KeyTypedEvent>(0, static_cast<char32_t>(character));
+			}
+			return true;
+		}
+		case SDL_EVENT_MOUSE_MOTION:
+			queue.Emplace<MouseMovedEvent>(event.motion.x, event.motion.y, event.motion.xrel, event.motion.yrel);
+			return true;
+		case SDL_EVENT_MOUSE_WHEEL:
+			queue.Emplace<MouseScrolledEvent>(event.wheel.x, event.wheel.y);
+			return true;
+		case SDL_EVENT_MOUSE_BUTTON_DOWN:
+			queue.Emplace<MouseButtonPressedEvent>(static_cast<int>(event.button.button));
+			return true;
+		case SDL_EVENT_MOUSE_BUTTON_UP:
+			queue.Emplace<MouseButtonReleasedEvent>(static_cast<int>(event.button.button));
+			return true;
+		default:
+			return false;
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "KJK_Engine/Core/Window.h"
+#include "KJK_Engine/Events/EventQueue.h"
+
+namespace KJK
+{
+	//Window backed by SDL3 with an OpenGL 4.5 core context
+	//System events are drained in batches and translated into engine events stored by value, so delivering them never allocates
+	class SDLWindow : public Window
+	{
+	public:
+		//Function type for callbacks receiving the untranslated SDL events, like the ImGui backend
+		using NativeEventCallbackFn = std::function<void(const SDL_Event&)>;
+
+		SDLWindow(const WindowProps& props);
+		virtual ~SDLWindow();
+
+		//Disable copy semantics, the window owns the SDL window and context
+		SDLWindow(const SDLWindow& other) = delete;
+		SDLWindow& operator=(const SDLWindow& other) = delete;
+
+		void OnUpdate() override;
+		void SwapBuffers() override;
+
+		inline unsigned int GetWidth() const override { return m_Width; }
+		inline unsigned int GetHeight() const override { return m_Height; }
+
+		inline void SetEventCallback(const EventCallbackFn& callback) override { m_EventCallback = callback; }
+		void SetVSyncMode(VSyncMode mode) override;
+		inline VSyncMode GetVSyncMode() const override { return m_VSyncMode; }
+
+		inline void* GetNativeWindow() const override { return m_Window; }
+
+		//Check if the window and its context were created
+		inline bool IsValid() const { return m_Context != nullptr; }
+		//Getter for the SDL window
+		inline SDL_Window* GetSDLWindow() const { return m_Window; }
+		//Getter for the OpenGL context
+		inline SDL_GLContext GetGLContext() const { return m_Context; }
+
+		//Setter for the callback receiving every SDL event before it is translated
+		inline void SetNativeEventCallback(const NativeEventCallbackFn& callback) { m_NativeEventCallback = callback; }
+
+		//Getter for the number of engine events dropped because the queue was full
+		inline uint64_t GetDroppedEventCount() const { return m_Events.GetDroppedCount(); }
+
+		//Translate an SDL event into engine events in the queue, returns false for events without an engine equivalent
+		static bool TranslateEvent(const SDL_Event& event, EventQueue& queue);
+	private:
+		//Number of SDL events fetched from SDL per call
+		static constexpr int s_EventBatchSize = 64;
+
+		SDL_Window* m_Window = nullptr;
+		SDL_GLContext m_Context = nullptr;
+		//Check if this window initialized the SDL video subsystem and has to release it
+		bool m_VideoInitialized = false;
+
+		//Size of the window in pixels, updated by the resize events
+		unsigned int m_Width;
+		unsigned int m_Height;
+		VSyncMode m_VSyncMode = VSyncMode::Off;
+
+		EventCallbackFn m_EventCallback;
+		NativeEventCallbackFn m_NativeEventCallback;
+
+		//Engine events translated during an update, runs of mouse motion and resizes are merged
+		EventQueue m_Events;
+	};
+}
@@ -17,50 +17,15 @@ uniform Material material;
 uniform sampler2D texture_diffuse1;
 uniform sampler2D texture_specular1;
 
-struct DirLight
-{
-	vec3 direction;
+#include "include/Lights.glsl"
 
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-};
 in DirLight dirLightView;
 vec4 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);
 
-struct PointLight
-{
-	vec3 position;
-
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-
-	float constant;
-	float linear;
-	float quadratic;
-};
-#define NR_POINT_LIGHTS 1
 in PointLight pointLightsView[NR_POINT_LIGHTS];
 uniform PointLight pointLightsWorld[NR_POINT_LIGHTS];
 vec4 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
-struct SpotLight
-{
-	vec3 position;
-	vec3 direction;
-
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-
-	float constant;
-	float linear;
-	float quadratic;
-
-	float cutOff;
-	float outerCutOff;
-};
 in SpotLight spotLightView;
 vec4 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
 
@@ -0,0 +1,45 @@
+//Light structs shared by the lit shaders
+
+//Number of point lights, variants can define their own count
+#ifndef NR_POINT_LIGHTS
+	#define NR_POINT_LIGHTS 1
+#endif
+
+struct DirLight
+{
+	vec3 direction;
+
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+};
+
+struct PointLight
+{
+	vec3 position;
+
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+
+	float constant;
+	float linear;
+	float quadratic;
+};
+
+struct SpotLight
+{
+	vec3 position;
+	vec3 direction;
+
+	vec4 ambient;
+	vec4 diffuse;
+	vec4 specular;
+
+	float constant;
+	float linear;
+	float quadratic;
+
+	float cutOff;
+	float outerCutOff;
+};
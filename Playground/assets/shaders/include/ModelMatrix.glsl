@@ -0,0 +1,9 @@
+//Model matrix of the drawn object, a per instance vertex attribute in variants defining INSTANCED
+
+#ifdef INSTANCED
+	layout (location = 3) in mat4 instanceMatrix;
+	#define MODEL_MATRIX instanceMatrix
+#else
+	uniform mat4 model;
+	#define MODEL_MATRIX model
+#endif
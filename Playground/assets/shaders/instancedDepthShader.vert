@@ -1,14 +0,0 @@
-#version 450 core
-layout (location = 0) in vec3 aPos;
-layout (location = 2) in vec2 aTexCoords;
-layout (location = 3) in mat4 instanceMatrix;
-
-out vec2 vsTexCoords;
-
-uniform mat4 lightSpaceMatrix;
-
-void main()
-{
-	gl_Position = lightSpaceMatrix * instanceMatrix * vec4(aPos, 1.0);
-	vsTexCoords = aTexCoords;
-}
\ No newline at end of file
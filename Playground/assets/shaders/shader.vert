@@ -16,51 +16,16 @@ layout (std140, binding = 0) uniform Matrices
 	uniform mat4 projection;
 	uniform mat4 view;
 };
-uniform mat4 model;
+#include "include/ModelMatrix.glsl"
 
-struct DirLight
-{
-	vec3 direction;
+#include "include/Lights.glsl"
 
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-};
 uniform DirLight dirLight;
 out DirLight dirLightView;
 
-struct PointLight
-{
-	vec3 position;
-
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-
-	float constant;
-	float linear;
-	float quadratic;
-};
-#define NR_POINT_LIGHTS 1
 uniform PointLight pointLights[NR_POINT_LIGHTS];
 out PointLight pointLightsView[NR_POINT_LIGHTS];
 
-struct SpotLight
-{
-	vec3 position;
-	vec3 direction;
-
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-
-	float constant;
-	float linear;
-	float quadratic;
-
-	float cutOff;
-	float outerCutOff;
-};
 uniform SpotLight spotLight;
 out SpotLight spotLightView;
 
@@ -69,10 +34,10 @@ out vec4 fragPosLightSpace;
 
 void main()
 {
-	gl_Position = projection * view * model * vec4(aPos, 1.0);
+	gl_Position = projection * view * MODEL_MATRIX * vec4(aPos, 1.0);
 	texCoords = aTexCoords * textureScale;
-	normal = mat3(transpose(inverse(view * model))) * aNormal;
-	fragPos = vec3(view * model * vec4(aPos, 1.0));
+	normal = mat3(transpose(inverse(view * MODEL_MATRIX))) * aNormal;
+	fragPos = vec3(view * MODEL_MATRIX * vec4(aPos, 1.0));
 
 	DirLight dirLightV = dirLight;
 	dirLightV.direction = vec3(view * vec4(dirLight.direction, 0.0));
@@ -90,6 +55,6 @@ void main()
 	spotLightV.direction = vec3(view * vec4(spotLight.direction, 0.0));
 	spotLightView = spotLightV;
 
-	fragPosLightSpace = lightSpaceMatrix * model * vec4(aPos, 1.0);
-	fragPosWorld = vec3(model * vec4(aPos, 1.0));
+	fragPosLightSpace = lightSpaceMatrix * MODEL_MATRIX * vec4(aPos, 1.0);
+	fragPosWorld = vec3(MODEL_MATRIX * vec4(aPos, 1.0));
 }
\ No newline at end of file
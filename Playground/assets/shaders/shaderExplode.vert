@@ -19,49 +19,14 @@ layout (std140, binding = 0) uniform Matrices
 };
 uniform mat4 model;
 
-struct DirLight
-{
-	vec3 direction;
+#include "include/Lights.glsl"
 
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-};
 uniform DirLight dirLight;
 out DirLight vsDirLightView;
 
-struct PointLight
-{
-	vec3 position;
-
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-
-	float constant;
-	float linear;
-	float quadratic;
-};
-#define NR_POINT_LIGHTS 1
 uniform PointLight pointLights[NR_POINT_LIGHTS];
 out PointLight vsPointLightsView[NR_POINT_LIGHTS];
 
-struct SpotLight
-{
-	vec3 position;
-	vec3 direction;
-
-	vec4 ambient;
-	vec4 diffuse;
-	vec4 specular;
-
-	float constant;
-	float linear;
-	float quadratic;
-
-	float cutOff;
-	float outerCutOff;
-};
 uniform SpotLight spotLight;
 out SpotLight vsSpotLightView;
 
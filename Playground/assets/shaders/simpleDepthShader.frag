@@ -1,6 +1,16 @@
 #version 450 core
 
+#ifdef ALPHA_TEST
+in vec2 texCoords;
+uniform sampler2D texture_diffuse1;
+#endif
+
 void main()
 {
-	//Do nothing
+#ifdef ALPHA_TEST
+	//Discard transparent fragments
+	float alpha = texture(texture_diffuse1, texCoords).a;
+	if(alpha < 0.5)
+		discard;
+#endif
 }
\ No newline at end of file
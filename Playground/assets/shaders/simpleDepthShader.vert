@@ -5,10 +5,10 @@ layout (location = 2) in vec2 aTexCoords;
 out vec2 texCoords;
 
 uniform mat4 lightSpaceMatrix;
-uniform mat4 model;
+#include "include/ModelMatrix.glsl"
 
 void main()
 {
-	gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+	gl_Position = lightSpaceMatrix * MODEL_MATRIX * vec4(aPos, 1.0);
 	texCoords = aTexCoords;
 }
\ No newline at end of file
@@ -4,8 +4,20 @@ in vec4 FragPos;
 uniform vec3 lightPos;
 uniform float far_plane;
 
+#ifdef ALPHA_TEST
+in vec2 texCoords;
+uniform sampler2D texture_diffuse1;
+#endif
+
 void main()
 {
+#ifdef ALPHA_TEST
+	//Discard transparent fragments
+	float alpha = texture(texture_diffuse1, texCoords).a;
+	if(alpha < 0.5)
+		discard;
+#endif
+
 	//Get the distance between the fragment and the light source
 	float lightDistance = length(FragPos.xyz - lightPos);
 
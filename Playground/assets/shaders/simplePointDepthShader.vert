@@ -4,10 +4,10 @@ layout (location = 2) in vec2 aTexCoords;
 
 out vec2 vsTexCoords;
 
-uniform mat4 model;
+#include "include/ModelMatrix.glsl"
 
 void main()
 {
-	gl_Position = model * vec4(aPos, 1.0);
+	gl_Position = MODEL_MATRIX * vec4(aPos, 1.0);
 	vsTexCoords = aTexCoords;
 }
\ No newline at end of file
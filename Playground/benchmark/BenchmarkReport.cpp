@@ -0,0 +1,217 @@
+#include "BenchmarkReport.h"
+
+#include <KJK_Engine/Core/Logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <string_view>
+
+namespace
+{
+	//Escape a string for a JSON string literal
+	std::string escapeJson(const std::string& text)
+	{
+		std::string escaped;
+		escaped.reserve(text.size());
+		for (char c : text)
+		{
+			switch (c)
+			{
+			case '"': escaped += "\\\""; break;
+			case '\\': escaped += "\\\\"; break;
+			case '\n': escaped += "\\n"; break;
+			case '\t': escaped += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+					escaped += fmt::format("\\u{0:04x}", static_cast<unsigned int>(c));
+				else
+					escaped += c;
+				break;
+			}
+		}
+		return escaped;
+	}
+
+	//Append the mean, the extremes and the nearest rank percentiles of the samples as a JSON object
+	void appendSummary(std::string& out, const std::vector<float>& samples)
+	{
+		if (samples.empty())
+		{
+			out += "null";
+			return;
+		}
+
+		std::vector<float> sorted(samples);
+		std::sort(sorted.begin(), sorted.end());
+
+		double total = 0.0;
+		for (float value : sorted)
+			total += value;
+
+		auto percentile = [&](double share)
+		{
+			size_t rank = static_cast<size_t>(std::ceil(share * static_cast<double>(sorted.size())));
+			return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+		};
+
+		fmt::format_to(std::back_inserter(out), "{{\"mean\": {0:.4f}, \"min\": {1:.4f}, \"p50\": {2:.4f}, \"p95\": {3:.4f}, \"p99\": {4:.4f}, \"max\": {5:.4f}}}",
+			total / static_cast<double>(sorted.size()), sorted.front(), percentile(0.50), percentile(0.95), percentile(0.99), sorted.back());
+	}
+}
+
+bool parseBenchmarkSettings(int argc, char* args[], BenchmarkSettings& settings)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string_view option(args[i]);
+		if (option == "--help" || i + 1 >= argc)
+		{
+			std::fprintf(stderr,
+				"Usage: %s [options]\n"
+				"  --frames N     Measured frames per scene (default %u)\n"
+				"  --warmup N     Frames rendered before measuring (default %u)\n"
+				"  --width N      Framebuffer width (default %d)\n"
+				"  --height N     Framebuffer height (default %d)\n"
+				"  --seed N       Seed of the asteroid placement (default %u)\n"
+				"  --asteroids N  Number of asteroids\n"
+				"  --output PATH  Also write the JSON report to a file\n",
+				args[0], settings.frames, settings.warmupFrames, settings.width, settings.height, settings.asteroidSeed);
+			return false;
+		}
+
+		//Every option takes a value
+		const char* value = args[++i];
+		if (option == "--output")
+		{
+			settings.outputPath = value;
+			continue;
+		}
+
+		char* end = nullptr;
+		unsigned long number = std::strtoul(value, &end, 10);
+		if (end == value || *end != '\0' || number > 1000000)
+		{
+			std::fprintf(stderr, "Invalid value %s for %s\n", value, args[i - 1]);
+			return false;
+		}
+
+		if (option == "--frames" && number > 0)
+			settings.frames = static_cast<unsigned int>(number);
+		else if (option == "--warmup")
+			settings.warmupFrames = static_cast<unsigned int>(number);
+		else if (option == "--width" && number > 0)
+			settings.width = static_cast<int>(number);
+		else if (option == "--height" && number > 0)
+			settings.height = static_cast<int>(number);
+		else if (option == "--seed")
+			settings.asteroidSeed = static_cast<unsigned int>(number);
+		else if (option == "--asteroids" && number > 0)
+			settings.asteroidCount = static_cast<unsigned int>(number);
+		else
+		{
+			std::fprintf(stderr, "Invalid option %s %s, see --help\n", args[i - 1], value);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void BenchmarkReport::BeginScene(const std::string& name)
+{
+	mScenes.emplace_back();
+	mScenes.back().name = name;
+}
+
+void BenchmarkReport::AddFrame(float frameMs, float cpuMs, uint64_t gpuFrameIndex)
+{
+	if (mScenes.empty())
+		return;
+
+	SceneSamples& scene = mScenes.back();
+	scene.frameMs.push_back(frameMs);
+	scene.cpuMs.push_back(cpuMs);
+	mSceneByGpuFrame[gpuFrameIndex] = mScenes.size() - 1;
+}
+
+void BenchmarkReport::AddGpuResults(uint64_t gpuFrameIndex, const std::vector<KJK::GpuPassTiming>& passes)
+{
+	auto it = mSceneByGpuFrame.find(gpuFrameIndex);
+	if (it == mSceneByGpuFrame.end())
+		return;
+
+	//Every frame is only counted once
+	SceneSamples& scene = mScenes[it->second];
+	mSceneByGpuFrame.erase(it);
+
+	float frameGpuMs = 0.0f;
+	for (const KJK::GpuPassTiming& pass : passes)
+	{
+		if (pass.Depth == 0)
+			frameGpuMs += pass.GpuMs;
+
+		//Keep the passes in the order they first ran
+		auto samples = std::find_if(scene.passes.begin(), scene.passes.end(), [&](const PassSamples& existing)
+		{
+			return existing.name == pass.Name && existing.depth == pass.Depth;
+		});
+		if (samples == scene.passes.end())
+		{
+			samples = scene.passes.emplace(scene.passes.end());
+			samples->name = pass.Name;
+			samples->depth = pass.Depth;
+		}
+
+		samples->gpuMs.push_back(pass.GpuMs);
+		samples->cpuMs.push_back(pass.CpuMs);
+	}
+	scene.gpuMs.push_back(frameGpuMs);
+}
+
+std::string BenchmarkReport::ToJson(const BenchmarkSettings& settings) const
+{
+	std::string out;
+	auto inserter = std::back_inserter(out);
+
+	out += "{\n";
+	fmt::format_to(inserter, "  \"renderer\": \"{0}\",\n", escapeJson(settings.renderer));
+	fmt::format_to(inserter, "  \"version\": \"{0}\",\n", escapeJson(settings.version));
+	fmt::format_to(inserter, "  \"width\": {0},\n  \"height\": {1},\n", settings.width, settings.height);
+	fmt::format_to(inserter, "  \"warmupFrames\": {0},\n  \"frames\": {1},\n", settings.warmupFrames, settings.frames);
+	fmt::format_to(inserter, "  \"asteroidSeed\": {0},\n  \"asteroidCount\": {1},\n", settings.asteroidSeed, settings.asteroidCount);
+	out += "  \"scenes\": [";
+
+	for (size_t i = 0; i < mScenes.size(); i++)
+	{
+		const SceneSamples& scene = mScenes[i];
+		fmt::format_to(inserter, "{0}\n    {{\n", i == 0 ? "" : ",");
+		fmt::format_to(inserter, "      \"name\": \"{0}\",\n", escapeJson(scene.name));
+		fmt::format_to(inserter, "      \"frames\": {0},\n", scene.frameMs.size());
+		out += "      \"frameMs\": ";
+		appendSummary(out, scene.frameMs);
+		out += ",\n      \"cpuMs\": ";
+		appendSummary(out, scene.cpuMs);
+		fmt::format_to(inserter, ",\n      \"gpuFrames\": {0},\n", scene.gpuMs.size());
+		out += "      \"gpuMs\": ";
+		appendSummary(out, scene.gpuMs);
+		out += ",\n      \"passes\": [";
+
+		for (size_t j = 0; j < scene.passes.size(); j++)
+		{
+			const PassSamples& pass = scene.passes[j];
+			fmt::format_to(inserter, "{0}\n        {{\"name\": \"{1}\", \"depth\": {2}, \"gpuMs\": ", j == 0 ? "" : ",", escapeJson(pass.name), pass.depth);
+			appendSummary(out, pass.gpuMs);
+			out += ", \"cpuMs\": ";
+			appendSummary(out, pass.cpuMs);
+			out += "}";
+		}
+
+		out += scene.passes.empty() ? "]\n    }" : "\n      ]\n    }";
+	}
+
+	out += mScenes.empty() ? "]\n}\n" : "\n  ]\n}\n";
+	return out;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <KJK_Engine/Renderer/GpuProfiler.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Fixed settings of a benchmark run, written into the report so results can be compared
+struct BenchmarkSettings
+{
+	//Resolution of the offscreen framebuffers
+	int width{ 1280 };
+	int height{ 720 };
+	//Frames rendered before measuring, so caches, shader compilation and the GPU query ring settle
+	unsigned int warmupFrames{ 60 };
+	//Frames measured per scene
+	unsigned int frames{ 600 };
+	//Seed of the asteroid placement
+	unsigned int asteroidSeed{ 1 };
+	//Number of instanced asteroids, 0 keeps the Playground's amount
+	unsigned int asteroidCount{ 0 };
+	//File the report is written to besides the standard output, nothing is written when empty
+	std::string outputPath;
+	//OpenGL renderer and version strings
+	std::string renderer;
+	std::string version;
+};
+
+//Read the settings from the command line, returns false and prints the usage on invalid arguments
+bool parseBenchmarkSettings(int argc, char* args[], BenchmarkSettings& settings);
+
+//Collects the CPU and GPU frame times of the benchmarked scenes and writes them as JSON
+class BenchmarkReport
+{
+public:
+	//Start collecting the frames of a scene
+	void BeginScene(const std::string& name);
+
+	//Add a measured frame, the frame time includes waiting for the GPU while the CPU time is the submission work before it
+	void AddFrame(float frameMs, float cpuMs, uint64_t gpuFrameIndex);
+	//Add the GPU pass timings of a resolved frame, frames that weren't measured are ignored
+	void AddGpuResults(uint64_t gpuFrameIndex, const std::vector<KJK::GpuPassTiming>& passes);
+
+	//Format the settings and the statistics of every scene as JSON
+	std::string ToJson(const BenchmarkSettings& settings) const;
+private:
+	//Samples of a render pass
+	struct PassSamples
+	{
+		std::string name;
+		unsigned int depth{ 0 };
+		std::vector<float> gpuMs;
+		std::vector<float> cpuMs;
+	};
+
+	//Samples of a scene
+	struct SceneSamples
+	{
+		std::string name;
+		std::vector<float> frameMs;
+		std::vector<float> cpuMs;
+		//GPU time of the top level passes of each resolved frame
+		std::vector<float> gpuMs;
+		std::vector<PassSamples> passes;
+	};
+
+	std::vector<SceneSamples> mScenes;
+	//Scene each measured GPU frame belongs to, results arrive a few frames late
+	std::unordered_map<uint64_t, size_t> mSceneByGpuFrame;
+};
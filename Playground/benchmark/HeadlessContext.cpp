@@ -0,0 +1,138 @@
+#include "HeadlessContext.h"
+
+#include <KJK_Engine/Core/Logger.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstring>
+
+namespace
+{
+	//EGL display and context of the benchmark
+	EGLDisplay gEGLDisplay = EGL_NO_DISPLAY;
+	EGLContext gEGLContext = EGL_NO_CONTEXT;
+
+	//Check if a space separated extension string contains an extension
+	bool hasExtension(const char* extensions, const char* name)
+	{
+		if (extensions == nullptr)
+			return false;
+
+		size_t length = std::strlen(name);
+		for (const char* start = std::strstr(extensions, name); start != nullptr; start = std::strstr(start + length, name))
+		{
+			bool startsWord = start == extensions || start[-1] == ' ';
+			bool endsWord = start[length] == ' ' || start[length] == '\0';
+			if (startsWord && endsWord)
+				return true;
+		}
+		return false;
+	}
+
+	//Get the surfaceless display, falling back to the default display on drivers without the Mesa platform
+	EGLDisplay getDisplay()
+	{
+		const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+		if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+		{
+			auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+			if (getPlatformDisplay != nullptr)
+			{
+				EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+				if (display != EGL_NO_DISPLAY)
+					return display;
+			}
+		}
+
+		KJK_WARN("EGL surfaceless platform is unavailable, using the default display");
+		return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+}
+
+bool createHeadlessContext()
+{
+	//Initialize the display
+	gEGLDisplay = getDisplay();
+	EGLint major = 0;
+	EGLint minor = 0;
+	if (gEGLDisplay == EGL_NO_DISPLAY || !eglInitialize(gEGLDisplay, &major, &minor))
+	{
+		KJK_ERROR("Failed to initialize the EGL display: {0:#x}", eglGetError());
+		return false;
+	}
+	KJK_INFO("Initialized EGL {0}.{1} from {2}", major, minor, eglQueryString(gEGLDisplay, EGL_VENDOR));
+
+	//Rendering only goes to framebuffer objects, so the context needs no surface at all
+	if (!hasExtension(eglQueryString(gEGLDisplay, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context"))
+	{
+		KJK_ERROR("EGL display doesn't support surfaceless contexts!");
+		return false;
+	}
+
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		KJK_ERROR("Failed to bind the desktop OpenGL API: {0:#x}", eglGetError());
+		return false;
+	}
+
+	//Pick any config that can render desktop OpenGL, the default surface type asks for windows which surfaceless displays don't have
+	EGLint configAttributes[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+	EGLConfig config = nullptr;
+	EGLint configCount = 0;
+	if (!eglChooseConfig(gEGLDisplay, configAttributes, &config, 1, &configCount) || configCount == 0)
+	{
+		KJK_ERROR("Failed to find an EGL config for desktop OpenGL: {0:#x}", eglGetError());
+		return false;
+	}
+
+	//Use OpenGL 4.5 core like the windowed Playground
+	EGLint contextAttributes[] =
+	{
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 5,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE
+	};
+	gEGLContext = eglCreateContext(gEGLDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+	if (gEGLContext == EGL_NO_CONTEXT)
+	{
+		KJK_ERROR("Failed to create the OpenGL context: {0:#x}", eglGetError());
+		return false;
+	}
+
+	if (!eglMakeCurrent(gEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, gEGLContext))
+	{
+		KJK_ERROR("Failed to make the OpenGL context current: {0:#x}", eglGetError());
+		return false;
+	}
+
+	//Load OpenGL functions using GLAD
+	if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)))
+	{
+		KJK_ERROR("Failed to initialize GLAD!");
+		return false;
+	}
+
+	KJK_INFO("Created a headless OpenGL context: {0}, {1}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)), reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+	return true;
+}
+
+void destroyHeadlessContext()
+{
+	if (gEGLDisplay == EGL_NO_DISPLAY)
+		return;
+
+	eglMakeCurrent(gEGLDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	if (gEGLContext != EGL_NO_CONTEXT)
+		eglDestroyContext(gEGLDisplay, gEGLContext);
+	eglTerminate(gEGLDisplay);
+
+	gEGLContext = EGL_NO_CONTEXT;
+	gEGLDisplay = EGL_NO_DISPLAY;
+}
+
+void* getHeadlessProcAddress(const char* name)
+{
+	return reinterpret_cast<void*>(eglGetProcAddress(name));
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+//Offscreen OpenGL 4.5 core context without a window, display server or GPU
+//Uses an EGL surfaceless display, which Mesa's llvmpipe provides on build machines
+
+//Create the context, make it current and load the OpenGL functions
+bool createHeadlessContext();
+//Destroy the context and release the EGL display
+void destroyHeadlessContext();
+//Get the address of an OpenGL function of the headless context, for functions the loader doesn't provide
+void* getHeadlessProcAddress(const char* name);
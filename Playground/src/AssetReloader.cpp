@@ -0,0 +1,232 @@
+#include "AssetReloader.h"
+
+#include <KJK_Engine/Core/FileWatcher.h>
+#include <KJK_Engine/Core/Logger.h>
+#include <KJK_Engine/Core/Profiler.h>
+
+#include <cctype>
+#include <filesystem>
+
+namespace
+{
+	//Normalize a path so paths written differently compare equal
+	std::string normalizePath(const std::string& path)
+	{
+		return std::filesystem::path(path).lexically_normal().generic_string();
+	}
+
+	//Check if a path is an image file
+	bool isImage(const std::filesystem::path& path)
+	{
+		std::string extension = path.extension().string();
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+	}
+}
+
+AssetReloader::PendingReload::~PendingReload()
+{
+	if (surface != nullptr)
+		SDL_DestroySurface(surface);
+}
+
+AssetReloader::~AssetReloader()
+{
+	//The jobs write into the pending loads
+	for (const auto& reload : mPending)
+		KJK::JobSystem::Wait(reload->counter);
+}
+
+void AssetReloader::AddShader(Shader& shader)
+{
+	mShaders.push_back(&shader);
+}
+
+void AssetReloader::AddModel(BaseModel& model)
+{
+	mBaseModels.push_back(&model);
+}
+
+void AssetReloader::AddModel(Model& model, const ReloadCallbackFn& onReload)
+{
+	mModels.push_back(ModelEntry{ &model, onReload });
+}
+
+void AssetReloader::Update()
+{
+	KJK_PROFILE_FUNCTION();
+
+	//Swap in the finished loads, later loads of the same asset win
+	bool shadersReloaded = false;
+	for (auto it = mPending.begin(); it != mPending.end();)
+	{
+		if (!(*it)->counter.IsDone())
+		{
+			++it;
+			continue;
+		}
+
+		if (applyReload(**it))
+			shadersReloaded = true;
+		it = mPending.erase(it);
+	}
+
+	//Rebuilt programs have to get their uniforms set again
+	if (shadersReloaded && mShadersReloaded)
+		mShadersReloaded();
+
+	//Start the loads for the files that changed since the last frame
+	KJK::FileWatcher::DispatchChanges([this](const std::string& path)
+	{
+		onFileChanged(path);
+	});
+}
+
+void AssetReloader::onFileChanged(const std::string& path)
+{
+	std::string changed = normalizePath(path);
+	std::filesystem::path changedPath(changed);
+	size_t started = mPending.size();
+
+	//Shaders using the file as a stage source or including it
+	for (Shader* shader : mShaders)
+	{
+		bool used = std::any_of(shader->GetStages().begin(), shader->GetStages().end(), [&changed](const ShaderStage& stage) { return normalizePath(stage.path) == changed; })
+			|| std::any_of(shader->GetIncludes().begin(), shader->GetIncludes().end(), [&changed](const std::string& include) { return normalizePath(include) == changed; });
+		if (used)
+			startReload(AssetType::Shader, changed, shader, nullptr);
+	}
+
+	//Model files and their materials, textures are handled below
+	bool usedAsTexture = false;
+	for (const ModelEntry& entry : mModels)
+	{
+		const std::string directory = normalizePath(entry.model->GetDirectory());
+		if (normalizePath(entry.model->GetPath()) == changed || (changedPath.parent_path() == directory && changedPath.extension() == ".mtl"))
+			startReload(AssetType::Model, entry.model->GetPath(), nullptr, entry.model);
+		else if (isImage(changedPath) && changed.compare(0, directory.size() + 1, directory + '/') == 0)
+			usedAsTexture = true;
+	}
+
+	//Textures are decoded once and refilled for every model using the file
+	for (BaseModel* model : mBaseModels)
+	{
+		if (normalizePath(model->getDiffusePath()) == changed || normalizePath(model->getSpecularPath()) == changed)
+			usedAsTexture = true;
+	}
+	if (usedAsTexture)
+		startReload(AssetType::Texture, changed, nullptr, nullptr);
+
+	if (mPending.size() != started)
+		KJK_INFO("{0} changed, reloading {1} assets", changed, mPending.size() - started);
+}
+
+void AssetReloader::startReload(AssetType type, const std::string& path, Shader* shader, Model* model)
+{
+	//A newer load of the same asset replaces the result of older ones
+	for (const auto& pending : mPending)
+	{
+		if (pending->type == type && pending->shader == shader && pending->model == model && (type != AssetType::Texture || pending->path == path))
+			pending->stale = true;
+	}
+
+	auto reload = std::make_unique<PendingReload>();
+	reload->type = type;
+	reload->path = path;
+	reload->shader = shader;
+	reload->model = model;
+
+	PendingReload* job = reload.get();
+	mPending.push_back(std::move(reload));
+	KJK::JobSystem::Execute(job->counter, [job]()
+	{
+		load(*job);
+	});
+}
+
+bool AssetReloader::applyReload(PendingReload& reload)
+{
+	if (reload.stale)
+		return false;
+
+	if (!reload.loaded)
+	{
+		KJK_WARN("Failed to load {0}, keeping the previous version", reload.path);
+		return false;
+	}
+
+	switch (reload.type)
+	{
+	case AssetType::Shader:
+		//A shader that fails to build keeps running the previous program
+		if (!reload.shader->Reload(reload.sources, reload.includes))
+			return false;
+		KJK_INFO("Reloaded shader program {0} after {1} changed", reload.shader->ID, reload.path);
+		return true;
+	case AssetType::Texture:
+	{
+		//The texture names stay the same, so meshes and materials pick up the new image
+		bool used = false;
+		for (BaseModel* model : mBaseModels)
+			used |= model->reloadTexture(reload.path, reload.surface, reload.hasAlpha);
+		for (const ModelEntry& entry : mModels)
+			used |= entry.model->ReloadTexture(reload.path, reload.surface);
+
+		if (used)
+			KJK_INFO("Reloaded texture {0}", reload.path);
+		return false;
+	}
+	case AssetType::Model:
+		if (!reload.model->Reload(reload.scene))
+			return false;
+		for (const ModelEntry& entry : mModels)
+		{
+			if (entry.model == reload.model && entry.onReload)
+				entry.onReload();
+		}
+		return false;
+	}
+
+	return false;
+}
+
+void AssetReloader::load(PendingReload& reload)
+{
+	KJK_PROFILE_FUNCTION();
+
+	switch (reload.type)
+	{
+	case AssetType::Shader:
+		reload.loaded = reload.shader->ReadSources(reload.sources, reload.includes);
+		break;
+	case AssetType::Texture:
+	{
+		SDL_Surface* surface = IMG_Load(reload.path.c_str());
+		if (surface == nullptr)
+		{
+			KJK_ERROR("Failed to load texture image: {0}", SDL_GetError());
+			break;
+		}
+
+		//Convert to the format the textures are filled with, keeping track of the alpha channel for the wrap mode
+		const SDL_PixelFormatDetails* details = SDL_GetPixelFormatDetails(surface->format);
+		reload.hasAlpha = (details && details->Amask != 0);
+		reload.surface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ABGR8888);
+		SDL_DestroySurface(surface);
+
+		if (reload.surface == nullptr)
+		{
+			KJK_ERROR("Failed to convert surface to standard format: {0}", SDL_GetError());
+			break;
+		}
+		reload.loaded = true;
+		break;
+	}
+	case AssetType::Model:
+		//The importer owns the scene until the meshes are rebuilt from it, the path is a copy as the model may be replaced meanwhile
+		reload.importer = std::make_unique<Assimp::Importer>();
+		reload.scene = Model::ImportScene(*reload.importer, reload.path);
+		reload.loaded = reload.scene != nullptr;
+		break;
+	}
+}
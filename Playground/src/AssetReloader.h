@@ -0,0 +1,100 @@
+#pragma once
+
+#include <KJK_Engine/Core/JobSystem.h>
+
+#include "Shader.h"
+#include "BaseModel.h"
+#include "Model.h"
+
+//Reloads shaders, textures and models when their files change on disk
+//Changed files are read and decoded on the job system, the new versions replace the old ones at the next frame boundary
+class AssetReloader
+{
+public:
+	//Function type for callbacks after assets were replaced
+	using ReloadCallbackFn = std::function<void()>;
+
+	AssetReloader() = default;
+	//Destructor waits for the loads still running
+	~AssetReloader();
+
+	//Disable copy semantics, running loads point into the reloader
+	AssetReloader(const AssetReloader& other) = delete;
+	AssetReloader& operator=(const AssetReloader& other) = delete;
+
+	//Register a shader, it's rebuilt when one of its stage sources or included files changes
+	void AddShader(Shader& shader);
+	//Register a model with textures from files, the textures are refilled in place
+	void AddModel(BaseModel& model);
+	//Register a model file, it's rebuilt when the file or a material changes and its textures are refilled in place
+	void AddModel(Model& model, const ReloadCallbackFn& onReload = nullptr);
+
+	//Setter for the callback after shaders were rebuilt, the new programs start without any uniforms set
+	inline void SetShadersReloadedCallback(const ReloadCallbackFn& callback) { mShadersReloaded = callback; }
+
+	//Swap in the finished loads and start loads for the files changed since the last call
+	//Called at a frame boundary on the thread owning the OpenGL context
+	void Update();
+
+	//Getter for the number of loads still running
+	inline size_t GetPendingCount() const { return mPending.size(); }
+private:
+	//Kinds of reloadable assets
+	enum class AssetType
+	{
+		Shader,
+		Texture,
+		Model
+	};
+
+	//Load running on the job system
+	struct PendingReload
+	{
+		AssetType type;
+		//File that changed, the model file for models
+		std::string path;
+		//Shader or model to replace, textures go to every model using the file
+		Shader* shader = nullptr;
+		Model* model = nullptr;
+		//Set when the asset changed again while loading, the result is outdated then
+		bool stale = false;
+		//Counter of the load job
+		KJK::JobCounter counter;
+
+		//Results of the load
+		bool loaded = false;
+		std::vector<std::string> sources;
+		std::vector<std::string> includes;
+		SDL_Surface* surface = nullptr;
+		bool hasAlpha = false;
+		std::unique_ptr<Assimp::Importer> importer;
+		const aiScene* scene = nullptr;
+
+		~PendingReload();
+	};
+
+	//Registered model file with the callback after it was rebuilt
+	struct ModelEntry
+	{
+		Model* model;
+		ReloadCallbackFn onReload;
+	};
+
+	std::vector<Shader*> mShaders;
+	std::vector<BaseModel*> mBaseModels;
+	std::vector<ModelEntry> mModels;
+	ReloadCallbackFn mShadersReloaded;
+
+	//Loads in the order they were started
+	std::vector<std::unique_ptr<PendingReload>> mPending;
+
+	//Start the loads for the assets using a changed file
+	void onFileChanged(const std::string& path);
+	//Start a load on the job system, marking older loads of the same asset as outdated
+	void startReload(AssetType type, const std::string& path, Shader* shader, Model* model);
+	//Replace an asset with a finished load, returns true for rebuilt shaders
+	bool applyReload(PendingReload& reload);
+
+	//Read or decode the changed file, runs on a job system thread
+	static void load(PendingReload& reload);
+};
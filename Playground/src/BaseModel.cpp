@@ -1,6 +1,9 @@
 #include "BaseModel.h"
 
 #include <KJK_Engine/Core/Logger.h>
+#include <KJK_Engine/Core/MemoryTracker.h>
+#include <KJK_Engine/Core/Stats.h>
+#include <KJK_Engine/Renderer/GLStateCache.h>
 
 BaseModel::BaseModel(const char* diffuseTexturePath, const char* specularTexturePath)
 	:position(0.0f, 0.0f, 0.0f), scale(1.0f, 1.0f, 1.0f), rotation(0.0f, 0.0f, 0.0f), mVAO(0), mVBO(0), mEBO(0), mDiffuseId(0), mSpecularId(0)
@@ -11,20 +14,33 @@ BaseModel::~BaseModel()
 {
 	//Delete the buffers/arrays
 	if (mVAO != 0)
-		glDeleteVertexArrays(1, &mVAO);
+		KJK::GLStateCache::DeleteVertexArray(mVAO);
 	if (mVBO != 0)
+	{
 		glDeleteBuffers(1, &mVBO);
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, mVBO);
+	}
 	if (mEBO != 0)
+	{
 		glDeleteBuffers(1, &mEBO);
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, mEBO);
+	}
 	//Delete textures
 	if (mDiffuseId != 0)
-		glDeleteTextures(1, &mDiffuseId);
+	{
+		KJK::GLStateCache::DeleteTexture(mDiffuseId);
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Texture, mDiffuseId);
+	}
 	if (mSpecularId != 0)
-		glDeleteTextures(1, &mSpecularId);
+	{
+		KJK::GLStateCache::DeleteTexture(mSpecularId);
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Texture, mSpecularId);
+	}
 }
 
 BaseModel::BaseModel(BaseModel&& other) noexcept
-	: position(other.position), scale(other.scale), rotation(other.rotation), mVAO(other.mVAO), mVBO(other.mVBO), mEBO(other.mEBO), mDiffuseId(other.mDiffuseId), mSpecularId(other.mSpecularId), vertices(std::move(other.vertices)), indices(std::move(other.indices))
+	: position(other.position), scale(other.scale), rotation(other.rotation), mVAO(other.mVAO), mVBO(other.mVBO), mEBO(other.mEBO), mDiffuseId(other.mDiffuseId), mSpecularId(other.mSpecularId), vertices(std::move(other.vertices)), indices(std::move(other.indices)),
+	  mDiffusePath(std::move(other.mDiffusePath)), mSpecularPath(std::move(other.mSpecularPath))
 {
 	//Invalidate other's resources
 	other.mVAO = 0;
@@ -40,17 +56,29 @@ BaseModel& BaseModel::operator=(BaseModel&& other) noexcept
 	{
 		//Delete existing resources
 		if (mVAO != 0)
-			glDeleteVertexArrays(1, &mVAO);
+			KJK::GLStateCache::DeleteVertexArray(mVAO);
 		if (mVBO != 0)
+		{
 			glDeleteBuffers(1, &mVBO);
+			KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, mVBO);
+		}
 		if (mEBO != 0)
+		{
 			glDeleteBuffers(1, &mEBO);
+			KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, mEBO);
+		}
 
 		//Delete textures
 		if (mDiffuseId != 0)
-			glDeleteTextures(1, &mDiffuseId);
+		{
+			KJK::GLStateCache::DeleteTexture(mDiffuseId);
+			KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Texture, mDiffuseId);
+		}
 		if (mSpecularId != 0)
-			glDeleteTextures(1, &mSpecularId);
+		{
+			KJK::GLStateCache::DeleteTexture(mSpecularId);
+			KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Texture, mSpecularId);
+		}
 
 		//Move data from other
 		position = other.position;
@@ -63,6 +91,8 @@ BaseModel& BaseModel::operator=(BaseModel&& other) noexcept
 		mSpecularId = other.mSpecularId;
 		vertices = std::move(other.vertices);
 		indices = std::move(other.indices);
+		mDiffusePath = std::move(other.mDiffusePath);
+		mSpecularPath = std::move(other.mSpecularPath);
 
 		//Invalidate other's resources
 		other.mVAO = 0;
@@ -94,27 +124,25 @@ void BaseModel::Draw(const Shader& shader, glm::mat4 model) const
 	shader.SetFloat("textureScale", textureScale);
 
 	//Bind the diffuse texture
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, mDiffuseId);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, mDiffuseId);
 
 	//Set the diffuse sampler uniform
 	shader.SetInt("material.diffuse", 0);
 
 	//Bind the specular texture
-	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, mSpecularId);
+	KJK::GLStateCache::BindTexture(1, GL_TEXTURE_2D, mSpecularId);
 
 	//Set the specular sampler uniform
 	shader.SetInt("material.specular", 1);
 
-	//Bind the VAO
-	glBindVertexArray(mVAO);
+	//Bind the VAO, left bound after the draw
+	KJK::GLStateCache::BindVertexArray(mVAO);
 
 	//Draw the model
 	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
-
-	//Unbind the VAO
-	glBindVertexArray(0);
+	KJK_STAT_ADD("Draw calls", 1);
+	KJK_STAT_ADD("Triangles", indices.size() / 3);
+	KJK_STAT_ADD("Texture binds", 2);
 }
 
 void BaseModel::setBufferData(const std::vector<BaseVertex>& verts, const std::vector<GLuint>& inds)
@@ -123,15 +151,20 @@ void BaseModel::setBufferData(const std::vector<BaseVertex>& verts, const std::v
 	vertices = verts;
 	indices = inds;
 
+	//Bind the VAO first, the EBO binding is stored in whichever VAO is bound
+	KJK::GLStateCache::BindVertexArray(mVAO);
+
 	//Bind the VBO
 	glBindBuffer(GL_ARRAY_BUFFER, mVBO);
 	//Update VBO data
 	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(BaseVertex), &vertices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, mVBO, KJK::MemoryCategory::Meshes, vertices.size() * sizeof(BaseVertex));
 
 	//Bind the EBO
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEBO);
 	//Update EBO data
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, mEBO, KJK::MemoryCategory::Meshes, indices.size() * sizeof(GLuint));
 }
 
 void BaseModel::setup(const char* diffuseTexturePath, const char* specularTexturePath)
@@ -139,13 +172,15 @@ void BaseModel::setup(const char* diffuseTexturePath, const char* specularTextur
 	//Load the textures
 	mDiffuseId = textureFromFile(diffuseTexturePath);
 	mSpecularId = textureFromFile(specularTexturePath);
+	mDiffusePath = diffuseTexturePath;
+	mSpecularPath = specularTexturePath;
 
 	//Initialize vertices and indices
 	initializeBuffers();
 
 	//Generate and bind VAO
 	glGenVertexArrays(1, &mVAO);
-	glBindVertexArray(mVAO);
+	KJK::GLStateCache::BindVertexArray(mVAO);
 
 	//Generate and bind VBO
 	glGenBuffers(1, &mVBO);
@@ -157,9 +192,11 @@ void BaseModel::setup(const char* diffuseTexturePath, const char* specularTextur
 
 	//Fill VBO with vertex data
 	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(BaseVertex), &vertices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, mVBO, KJK::MemoryCategory::Meshes, vertices.size() * sizeof(BaseVertex));
 
 	//Fill EBO with index data
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, mEBO, KJK::MemoryCategory::Meshes, indices.size() * sizeof(GLuint));
 
 	//Set the vertex attribute position pointer
 	glEnableVertexAttribArray(0);
@@ -174,11 +211,13 @@ void BaseModel::setup(const char* diffuseTexturePath, const char* specularTextur
 	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(BaseVertex), (void*)offsetof(BaseVertex, texCoords));
 
 	//Unbind the VAO
-	glBindVertexArray(0);
+	KJK::GLStateCache::BindVertexArray(0);
 }
 
 GLuint BaseModel::textureFromFile(const char* path)
 {
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Textures);
+
 	//Generate a texture ID
 	GLuint textureID{};
 	glGenTextures(1, &textureID);
@@ -192,7 +231,7 @@ GLuint BaseModel::textureFromFile(const char* path)
 	else
 	{
 		//Bind the texture
-		glBindTexture(GL_TEXTURE_2D, textureID);
+		KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, textureID);
 
 		//Check if the surface has an alpha channel
 		const SDL_PixelFormatDetails* details = SDL_GetPixelFormatDetails(surface->format);
@@ -212,19 +251,7 @@ GLuint BaseModel::textureFromFile(const char* path)
 		else
 		{
 			//Generate the texture using the loaded surface data
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB_ALPHA, formattedSurface->w, formattedSurface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, formattedSurface->pixels);
-
-			//Get the texture wrap mode from the alpha channel presence
-			GLenum wrapMode = hasAlpha ? GL_CLAMP_TO_EDGE : GL_REPEAT;
-
-			//Set the texture wrapping/filtering parameters
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-			//Generate mipmaps
-			glGenerateMipmap(GL_TEXTURE_2D);
+			uploadTexture(textureID, formattedSurface, hasAlpha);
 
 			//Free the formatted surface
 			SDL_DestroySurface(formattedSurface);
@@ -236,3 +263,45 @@ GLuint BaseModel::textureFromFile(const char* path)
 	//Return the success flag
 	return textureID;
 }
+
+void BaseModel::uploadTexture(GLuint textureID, SDL_Surface* formattedSurface, bool hasAlpha)
+{
+	//Bind the texture
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, textureID);
+
+	//Generate the texture using the surface data
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB_ALPHA, formattedSurface->w, formattedSurface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, formattedSurface->pixels);
+
+	//Get the texture wrap mode from the alpha channel presence
+	GLenum wrapMode = hasAlpha ? GL_CLAMP_TO_EDGE : GL_REPEAT;
+
+	//Set the texture wrapping/filtering parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapMode);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapMode);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	//Generate mipmaps
+	glGenerateMipmap(GL_TEXTURE_2D);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Texture, textureID, KJK::MemoryCategory::Textures,
+		KJK::MemoryTracker::EstimateTextureSize(formattedSurface->w, formattedSurface->h, 4, true));
+}
+
+bool BaseModel::reloadTexture(const std::string& path, SDL_Surface* formattedSurface, bool hasAlpha)
+{
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Textures);
+
+	//The texture IDs stay the same, so nothing referencing them has to change
+	bool reloaded = false;
+	if (mDiffuseId != 0 && mDiffusePath == path)
+	{
+		uploadTexture(mDiffuseId, formattedSurface, hasAlpha);
+		reloaded = true;
+	}
+	if (mSpecularId != 0 && mSpecularPath == path)
+	{
+		uploadTexture(mSpecularId, formattedSurface, hasAlpha);
+		reloaded = true;
+	}
+	return reloaded;
+}
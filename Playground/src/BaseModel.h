@@ -60,11 +60,20 @@ public:
 
 	//Setters for vertices and indices
 	void setBufferData(const std::vector<BaseVertex>& verts, const std::vector<GLuint>& inds);
+
+	//Getters for the texture file paths, empty if the model has no textures from files
+	inline const std::string& getDiffusePath() const { return mDiffusePath; }
+	inline const std::string& getSpecularPath() const { return mSpecularPath; }
+
+	//Replace the image of the textures loaded from a file in place with an ABGR8888 surface, returns false if no texture uses the file
+	bool reloadTexture(const std::string& path, SDL_Surface* formattedSurface, bool hasAlpha);
 protected:
 	//OpenGL object IDs
 	GLuint mVAO, mVBO, mEBO;
 	//Texture IDs
 	GLuint mDiffuseId, mSpecularId;
+	//Texture file paths
+	std::string mDiffusePath, mSpecularPath;
 
 	//Initializes all the buffer objects/arrays
 	void setup(const char* diffuseTexturePath, const char* specularTexturePath);
@@ -74,4 +83,6 @@ protected:
 
 	//Load a texture from file
 	GLuint textureFromFile(const char* path);
+	//Fill a texture with an ABGR8888 surface
+	void uploadTexture(GLuint textureID, SDL_Surface* formattedSurface, bool hasAlpha);
 };
\ No newline at end of file
@@ -35,89 +35,88 @@ glm::mat4 Camera::GetViewMatrix() const
 	return glm::lookAt(position, position + direction, up);
 }
 
-void Camera::HandleInput(const SDL_Event& e, float deltaTime, bool isMouseCaptured, const bool* keyboardState)
+void Camera::HandleInput(const KJK::InputSnapshot& input, float deltaTime, bool isMouseCaptured)
 {
-	//Handle keyboard input for camera movement
-	if(e.type == SDL_EVENT_KEY_DOWN)
-	{
-
-	}
 	//Handle mouse movement for camera orientation
-	else if (isMouseCaptured && e.type == SDL_EVENT_MOUSE_MOTION)
+	if (isMouseCaptured && (input.MouseDelta.x != 0.0f || input.MouseDelta.y != 0.0f))
 	{
-		//Get mouse movement deltas
-		float xoffset = static_cast<float>(e.motion.xrel);
-		float yoffset = static_cast<float>(e.motion.yrel);
-
-		//Add the sensitivity factor
-		xoffset *= sensitivity;
-		yoffset *= sensitivity;
-
-		//Convert the direction vector to yaw and pitch angles
-		float yaw = glm::degrees(atan2(direction.z, direction.x));
-		float pitch = glm::degrees(asin(direction.y));
-
-		//Update yaw and pitch based on mouse movement
-		yaw += xoffset;
-		pitch -= yoffset;
-
-		//Constrain the pitch angle to prevent flipping
-		if (pitch > 89.0f)
-			pitch = 89.0f;
-		if (pitch < -89.0f)
-			pitch = -89.0f;
-
-		//Convert yaw and pitch back to a direction vector
-		glm::vec3 newDirection{};
-		newDirection.x = cos(glm::radians(pitch)) * cos(glm::radians(yaw));
-		newDirection.y = sin(glm::radians(pitch));
-		newDirection.z = cos(glm::radians(pitch)) * sin(glm::radians(yaw));
-		direction = glm::normalize(newDirection);
-
-		//Recalculate the right and up vectors
-		right = glm::normalize(glm::cross(direction, glm::vec3(0.0f, 1.0f, 0.0f)));
-		up = glm::normalize(glm::cross(right, direction));
+		//Rotate by the mouse movement of the whole frame
+		ProcessMouseMovement(input.MouseDelta.x, input.MouseDelta.y);
 	}
 	//Handle mouse wheel for zooming (FOV adjustment)
-	else if (e.type == SDL_EVENT_MOUSE_WHEEL)
+	if (input.Scroll.y != 0.0f)
 	{
-		//Get the scroll amount
-		float scroll = static_cast<float>(e.wheel.y);
-
-		//Adjust the FoV based on scroll input
-		fov -= scroll * scrollSensitivity;
-		if (fov < 1.0f)
-			fov = 1.0f;
-		if (fov > 179.0f)
-			fov = 179.0f;
+		//Zoom by the scroll amount
+		ProcessMouseScroll(input.Scroll.y);
 	}
 
-	//Handle continuous keyboard state for smoother movement
-	if (keyboardState)
+	//Handle the held keys for smooth movement, by physical key so the layout and held modifiers don't matter
+	if(input.IsKeyDown(SDL_SCANCODE_W)) //Move forwards
+	{
+		position += direction * speed * deltaTime;
+	}
+	if(input.IsKeyDown(SDL_SCANCODE_S)) //Move backwards
+	{
+		position -= direction * speed * deltaTime;
+	}
+	if(input.IsKeyDown(SDL_SCANCODE_A)) //Move left
 	{
-		if(keyboardState[SDL_SCANCODE_W]) //Move forwards
-		{
-			position += direction * speed * deltaTime;
-		}
-		if(keyboardState[SDL_SCANCODE_S]) //Move backwards
-		{
-			position -= direction * speed * deltaTime;
-		}
-		if(keyboardState[SDL_SCANCODE_A]) //Move left
-		{
-			position -= right * speed * deltaTime;
-		}
-		if(keyboardState[SDL_SCANCODE_D]) //Move right
-		{
-			position += right * speed * deltaTime;
-		}
-		if(keyboardState[SDL_SCANCODE_LSHIFT]) //Move down
-		{
-			position -= glm::vec3(0.0f, 1.0f, 0.0f) * speed * deltaTime;
-		}
-		if(keyboardState[SDL_SCANCODE_SPACE]) //Move up
-		{
-			position += glm::vec3(0.0f, 1.0f, 0.0f) * speed * deltaTime;
-		}
+		position -= right * speed * deltaTime;
 	}
+	if(input.IsKeyDown(SDL_SCANCODE_D)) //Move right
+	{
+		position += right * speed * deltaTime;
+	}
+	if(input.IsKeyDown(SDL_SCANCODE_LSHIFT)) //Move down
+	{
+		position -= glm::vec3(0.0f, 1.0f, 0.0f) * speed * deltaTime;
+	}
+	if(input.IsKeyDown(SDL_SCANCODE_SPACE)) //Move up
+	{
+		position += glm::vec3(0.0f, 1.0f, 0.0f) * speed * deltaTime;
+	}
+}
+
+//Rotate the camera by a mouse movement in pixels
+void Camera::ProcessMouseMovement(float xoffset, float yoffset)
+{
+	//Add the sensitivity factor
+	xoffset *= sensitivity;
+	yoffset *= sensitivity;
+
+	//Convert the direction vector to yaw and pitch angles
+	float yaw = glm::degrees(atan2(direction.z, direction.x));
+	float pitch = glm::degrees(asin(direction.y));
+
+	//Update yaw and pitch based on mouse movement
+	yaw += xoffset;
+	pitch -= yoffset;
+
+	//Constrain the pitch angle to prevent flipping
+	if (pitch > 89.0f)
+		pitch = 89.0f;
+	if (pitch < -89.0f)
+		pitch = -89.0f;
+
+	//Convert yaw and pitch back to a direction vector
+	glm::vec3 newDirection{};
+	newDirection.x = cos(glm::radians(pitch)) * cos(glm::radians(yaw));
+	newDirection.y = sin(glm::radians(pitch));
+	newDirection.z = cos(glm::radians(pitch)) * sin(glm::radians(yaw));
+	direction = glm::normalize(newDirection);
+
+	//Recalculate the right and up vectors
+	right = glm::normalize(glm::cross(direction, glm::vec3(0.0f, 1.0f, 0.0f)));
+	up = glm::normalize(glm::cross(right, direction));
+}
+
+//Zoom the camera by a mouse wheel movement
+void Camera::ProcessMouseScroll(float yoffset)
+{
+	//Adjust the FoV based on scroll input
+	fov -= yoffset * scrollSensitivity;
+	if (fov < 1.0f)
+		fov = 1.0f;
+	if (fov > 179.0f)
+		fov = 179.0f;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <KJK_Engine/Core/Input.h>
+
 class Camera
 {
 public:
@@ -33,6 +35,12 @@ public:
 	//Returns the view matrix
 	glm::mat4 GetViewMatrix() const;
 
-	//Handle user input
-	void HandleInput(const SDL_Event& e, float deltaTime, bool isMouseCaptured, const bool* keyboardState);
+	//Handle the user input of a frame
+	void HandleInput(const KJK::InputSnapshot& input, float deltaTime, bool isMouseCaptured);
+
+	//Rotate the camera by a mouse movement in pixels
+	void ProcessMouseMovement(float xoffset, float yoffset);
+
+	//Zoom the camera by a mouse wheel movement
+	void ProcessMouseScroll(float yoffset);
 };
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "CubeModel.h"
 
 #include <KJK_Engine/Core/Logger.h>
+#include <KJK_Engine/Core/MemoryTracker.h>
+#include <KJK_Engine/Core/Stats.h>
+#include <KJK_Engine/Renderer/GLStateCache.h>
 
 CubeModel::CubeModel(const char* diffuseTexturePath, const char* specularTexturePath, bool is2d, std::vector<std::string> facePath)
 	: BaseModel(diffuseTexturePath, specularTexturePath), mCubemapID(0)
@@ -25,7 +28,8 @@ CubeModel::~CubeModel()
 	//Delete the cubemap texture
 	if (mCubemapID != 0)
 	{
-		glDeleteTextures(1, &mCubemapID);
+		KJK::GLStateCache::DeleteTexture(mCubemapID);
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Texture, mCubemapID);
 	}
 }
 
@@ -72,8 +76,8 @@ void CubeModel::Draw(const Shader& shader, glm::mat4 model) const
 	if (mCubemapID != 0)
 	{
 		//Bind the cubemap texture
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, mCubemapID);
+		KJK::GLStateCache::BindTexture(0, GL_TEXTURE_CUBE_MAP, mCubemapID);
+		KJK_STAT_ADD("Texture binds", 1);
 
 		//Set the cubemap sampler uniform
 		shader.SetInt("skybox", 0);
@@ -81,28 +85,26 @@ void CubeModel::Draw(const Shader& shader, glm::mat4 model) const
 	else
 	{
 		//Bind the diffuse texture
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, mDiffuseId);
+		KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, mDiffuseId);
 
 		//Set the diffuse sampler uniform
 		shader.SetInt("material.diffuse", 0);
 
 		//Bind the specular texture
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, mSpecularId);
+		KJK::GLStateCache::BindTexture(1, GL_TEXTURE_2D, mSpecularId);
+		KJK_STAT_ADD("Texture binds", 2);
 
 		//Set the specular sampler uniform
 		shader.SetInt("material.specular", 1);
 	}
 
-	//Bind the VAO
-	glBindVertexArray(mVAO);
+	//Bind the VAO, left bound after the draw
+	KJK::GLStateCache::BindVertexArray(mVAO);
 
 	//Draw the model
 	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
-
-	//Unbind the VAO
-	glBindVertexArray(0);
+	KJK_STAT_ADD("Draw calls", 1);
+	KJK_STAT_ADD("Triangles", indices.size() / 3);
 }
 
 void CubeModel::initializeBuffers()
@@ -175,7 +177,7 @@ void CubeModel::setupCubeModel(std::vector<std::string> facePaths)
 
 	//Generate and bind VAO
 	glGenVertexArrays(1, &mVAO);
-	glBindVertexArray(mVAO);
+	KJK::GLStateCache::BindVertexArray(mVAO);
 
 	//Generate and bind VBO
 	glGenBuffers(1, &mVBO);
@@ -187,9 +189,11 @@ void CubeModel::setupCubeModel(std::vector<std::string> facePaths)
 
 	//Fill VBO with vertex data
 	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(BaseVertex), &vertices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, mVBO, KJK::MemoryCategory::Meshes, vertices.size() * sizeof(BaseVertex));
 
 	//Fill EBO with index data
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, mEBO, KJK::MemoryCategory::Meshes, indices.size() * sizeof(GLuint));
 
 	//Set the vertex attribute position pointer
 	glEnableVertexAttribArray(0);
@@ -204,15 +208,20 @@ void CubeModel::setupCubeModel(std::vector<std::string> facePaths)
 	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(BaseVertex), (void*)offsetof(BaseVertex, texCoords));
 
 	//Unbind the VAO
-	glBindVertexArray(0);
+	KJK::GLStateCache::BindVertexArray(0);
 }
 
 GLuint CubeModel::loadCubemap(std::vector<std::string> faces)
 {
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Textures);
+
 	//Generate a texture ID
 	GLuint textureID;
 	glGenTextures(1, &textureID);
 
+	//Size of the loaded faces for the memory tracker
+	size_t textureBytes = 0;
+
 	for(GLuint i = 0; i < faces.size(); i++)
 	{
 		//Load the texture image
@@ -224,7 +233,7 @@ GLuint CubeModel::loadCubemap(std::vector<std::string> faces)
 		else
 		{
 			//Bind the texture
-			glBindTexture(GL_TEXTURE_CUBE_MAP, textureID);
+			KJK::GLStateCache::BindTexture(0, GL_TEXTURE_CUBE_MAP, textureID);
 
 			//Convert the surface to a standard format
 			SDL_Surface* formattedSurface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ABGR8888);
@@ -241,6 +250,7 @@ GLuint CubeModel::loadCubemap(std::vector<std::string> faces)
 			{
 				//Generate the texture using the loaded surface data
 				glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, formattedSurface->w, formattedSurface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, formattedSurface->pixels);
+				textureBytes += KJK::MemoryTracker::EstimateTextureSize(formattedSurface->w, formattedSurface->h, 4, true);
 
 				//Free the formatted surface
 				SDL_DestroySurface(formattedSurface);
@@ -258,6 +268,7 @@ GLuint CubeModel::loadCubemap(std::vector<std::string> faces)
 
 	//Generate mipmaps
 	glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Texture, textureID, KJK::MemoryCategory::Textures, textureBytes);
 
 	return textureID;
 }
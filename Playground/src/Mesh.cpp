@@ -1,31 +1,48 @@
 #include "Mesh.h"
 
+#include <KJK_Engine/Core/MemoryTracker.h>
+#include <KJK_Engine/Core/BinaryTrace.h>
+#include <KJK_Engine/Core/Profiler.h>
+#include <KJK_Engine/Core/Stats.h>
+#include <KJK_Engine/Renderer/GLStateCache.h>
+
 Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<GLuint>& indices, const std::vector<Texture>& textures, const Material& material)
 	: vertices(vertices), indices(indices), textures(textures), material(material)
 {
 	setupMesh();
+	setupSamplerNames();
 }
 
 Mesh::~Mesh()
 {
 	//Delete the buffers/arrays
 	if (mVAO != 0)
-		glDeleteVertexArrays(1, &mVAO);
+		KJK::GLStateCache::DeleteVertexArray(mVAO);
 	if (mVBO != 0)
+	{
 		glDeleteBuffers(1, &mVBO);
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, mVBO);
+	}
 	if (mEBO != 0)
+	{
 		glDeleteBuffers(1, &mEBO);
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, mEBO);
+	}
 
 	//Delete textures
 	for (const auto& texture : textures)
 	{
 		if (texture.id != 0)
-			glDeleteTextures(1, &texture.id);
+		{
+			KJK::GLStateCache::DeleteTexture(texture.id);
+			KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Texture, texture.id);
+		}
 	}
 }
 
 Mesh::Mesh(Mesh&& other) noexcept
-	: vertices(std::move(other.vertices)), indices(std::move(other.indices)), textures(std::move(other.textures)), material(other.material), mVAO(other.mVAO), mVBO(other.mVBO), mEBO(other.mEBO)
+	: vertices(std::move(other.vertices)), indices(std::move(other.indices)), textures(std::move(other.textures)), material(other.material), mVAO(other.mVAO), mVBO(other.mVBO), mEBO(other.mEBO),
+	mSamplerNames(std::move(other.mSamplerNames))
 {
 	//Invalidate other's resources
 	other.mVAO = 0;
@@ -39,17 +56,26 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept
 	{
 		//Delete existing resources
 		if (mVAO != 0)
-			glDeleteVertexArrays(1, &mVAO);
+			KJK::GLStateCache::DeleteVertexArray(mVAO);
 		if (mVBO != 0)
+		{
 			glDeleteBuffers(1, &mVBO);
+			KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, mVBO);
+		}
 		if (mEBO != 0)
+		{
 			glDeleteBuffers(1, &mEBO);
+			KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, mEBO);
+		}
 
 		//Delete textures
 		for (const auto& texture : textures)
 		{
 			if (texture.id != 0)
-				glDeleteTextures(1, &texture.id);
+			{
+				KJK::GLStateCache::DeleteTexture(texture.id);
+				KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Texture, texture.id);
+			}
 		}
 
 		//Move data from other
@@ -60,6 +86,7 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept
 		mVAO = other.mVAO;
 		mVBO = other.mVBO;
 		mEBO = other.mEBO;
+		mSamplerNames = std::move(other.mSamplerNames);
 
 		//Reset other
 		other.mVAO = 0;
@@ -72,35 +99,16 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept
 
 void Mesh::Draw(const Shader& shader) const
 {
-	//Declare counters for each texture type
-	GLuint diffuseNr = 1;
-	GLuint specularNr = 1;
-	GLuint normalNr = 1;
-	GLuint heightNr = 1;
+	KJK_PROFILE_FUNCTION();
 
 	//Iterate over all textures
 	for (GLuint i = 0; i < textures.size(); i++)
 	{
-		//Activate proper texture unit before binding
-		glActiveTexture(GL_TEXTURE0 + i);
-
-		//Retrieve texture number (the N in diffuse_textureN)
-		std::string number;
-		std::string name = textures[i].type;
-		if (name == "texture_diffuse")
-			number = std::to_string(diffuseNr++);
-		else if (name == "texture_specular")
-			number = std::to_string(specularNr++);
-		else if (name == "texture_normal")
-			number = std::to_string(normalNr++);
-		else if (name == "texture_height")
-			number = std::to_string(heightNr++);
-
 		//Set the sampler to the correct texture unit
-		shader.SetInt((name + number).c_str(), i);
+		shader.SetInt(mSamplerNames[i].c_str(), i);
 
-		//Bind the texture
-		glBindTexture(GL_TEXTURE_2D, textures[i].id);
+		//Bind the texture to its unit, skipped if it's still bound from the last draw
+		KJK::GLStateCache::BindTexture(i, GL_TEXTURE_2D, textures[i].id);
 	}
 
 	//Set the default texture scale uniform
@@ -109,17 +117,43 @@ void Mesh::Draw(const Shader& shader) const
 	//Set the material shininess uniform
 	shader.SetFloat("material.shininess", material.shininess);
 
-	//Set the active texture back to default
-	glActiveTexture(GL_TEXTURE0);
+	//Bind the VAO, it stays bound after the draw so drawing the mesh again skips the bind
+	KJK::GLStateCache::BindVertexArray(mVAO);
+
+	//Trace the draw call, formatting is deferred to the trace decoder
+	KJK_BTRACE("Draw VAO {} with {} indices and {} textures", mVAO, indices.size(), textures.size());
 
-	//Bind the VAO
-	glBindVertexArray(mVAO);
-	
 	//Draw the mesh
 	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+	KJK_STAT_ADD("Draw calls", 1);
+	KJK_STAT_ADD("Triangles", indices.size() / 3);
+	KJK_STAT_ADD("Texture binds", textures.size());
+}
+
+void Mesh::setupSamplerNames()
+{
+	//Declare counters for each texture type
+	GLuint diffuseNr = 1;
+	GLuint specularNr = 1;
+	GLuint normalNr = 1;
+	GLuint heightNr = 1;
 
-	//Unbind the VAO
-	glBindVertexArray(0);
+	//Retrieve texture number (the N in diffuse_textureN)
+	//The names are built once, so drawing only looks them up in the shader's uniform table
+	mSamplerNames.reserve(textures.size());
+	for (const Texture& texture : textures)
+	{
+		std::string name = texture.type;
+		if (name == "texture_diffuse")
+			name += std::to_string(diffuseNr++);
+		else if (name == "texture_specular")
+			name += std::to_string(specularNr++);
+		else if (name == "texture_normal")
+			name += std::to_string(normalNr++);
+		else if (name == "texture_height")
+			name += std::to_string(heightNr++);
+		mSamplerNames.push_back(std::move(name));
+	}
 }
 
 void Mesh::setupMesh()
@@ -130,17 +164,19 @@ void Mesh::setupMesh()
 	glGenBuffers(1, &mEBO);
 
 	//Bind VAO
-	glBindVertexArray(mVAO);
+	KJK::GLStateCache::BindVertexArray(mVAO);
 
 	//Bind VBO
 	glBindBuffer(GL_ARRAY_BUFFER, mVBO);
 	//Fill VBO with vertex data
 	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, mVBO, KJK::MemoryCategory::Meshes, vertices.size() * sizeof(Vertex));
 
 	//Bind EBO
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mEBO);
 	//Fill EBO with index data
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, mEBO, KJK::MemoryCategory::Meshes, indices.size() * sizeof(GLuint));
 
 	//Set the vertex attribute position pointer
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
@@ -171,5 +207,5 @@ void Mesh::setupMesh()
 	glEnableVertexAttribArray(6);
 
 	//Unbind VAO
-	glBindVertexArray(0);
+	KJK::GLStateCache::BindVertexArray(0);
 }
@@ -57,6 +57,11 @@ private:
 	//Render data
 	GLuint mVAO, mVBO, mEBO;
 
+	//Sampler uniform names of the textures (texture_diffuse1, texture_specular1, etc.)
+	std::vector<std::string> mSamplerNames;
+
 	//Initializes all the buffer objects/arrays
 	void setupMesh();
+	//Names the sampler uniform of every texture, numbered per texture type
+	void setupSamplerNames();
 };
\ No newline at end of file
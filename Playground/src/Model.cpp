@@ -1,7 +1,12 @@
 #include "Model.h"
 #include <KJK_Engine/Core/Logger.h>
+#include <KJK_Engine/Core/Profiler.h>
+#include <KJK_Engine/Core/MemoryTracker.h>
+#include <KJK_Engine/Renderer/GLStateCache.h>
 #include "CubeModel.h"
 
+#include <filesystem>
+
 Model::Model(const std::string& path)
 {
 	loadModel(path);
@@ -19,10 +24,10 @@ void Model::Draw(const Shader& shader) const
 	}
 }
 
-bool Model::loadModel(const std::string& path)
+const aiScene* Model::ImportScene(Assimp::Importer& importer, const std::string& path)
 {
-	//Create an instance of the Assimp Importer class
-	Assimp::Importer importer;
+	KJK_PROFILE_FUNCTION();
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Models);
 
 	//Read the model file into a scene object
 	const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace);
@@ -31,10 +36,66 @@ bool Model::loadModel(const std::string& path)
 	if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
 	{
 		KJK_ERROR("ASSIMP error: {0}", importer.GetErrorString());
+		return nullptr;
+	}
+
+	return scene;
+}
+
+bool Model::Reload(const aiScene* scene)
+{
+	KJK_PROFILE_FUNCTION();
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Models);
+
+	if (scene == nullptr)
+	{
+		KJK_WARN("Keeping the previous version of model {0}", mPath);
 		return false;
 	}
 
+	//Build the new version next to the current one, then replace it, the old meshes delete their textures
+	Model reloaded;
+	reloaded.mPath = mPath;
+	reloaded.mDirectory = mDirectory;
+	reloaded.processNode(scene->mRootNode, scene);
+	*this = std::move(reloaded);
+
+	KJK_INFO("Reloaded model at path: {0}", mPath);
+	return true;
+}
+
+bool Model::ReloadTexture(const std::string& path, SDL_Surface* formattedSurface)
+{
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Textures);
+
+	//Meshes share the loaded textures by ID, so filling them in place updates every mesh
+	bool reloaded = false;
+	for (const Texture& texture : mLoadedTextures)
+	{
+		if (std::filesystem::path(mDirectory + '/' + texture.path).lexically_normal() == std::filesystem::path(path).lexically_normal())
+		{
+			uploadTexture(texture.id, formattedSurface);
+			reloaded = true;
+		}
+	}
+	return reloaded;
+}
+
+bool Model::loadModel(const std::string& path)
+{
+	KJK_PROFILE_FUNCTION();
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Models);
+
+	//Create an instance of the Assimp Importer class
+	Assimp::Importer importer;
+
+	//Read the model file into a scene object
+	const aiScene* scene = ImportScene(importer, path);
+	if (scene == nullptr)
+		return false;
+
 	//Retrieve the directory path of the filepath
+	mPath = path;
 	mDirectory = path.substr(0, path.find_last_of('/'));
 
 	//Process the root node recursively
@@ -61,6 +122,8 @@ void Model::processNode(aiNode* node, const aiScene* scene)
 
 Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene)
 {
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Meshes);
+
 	//Declare vectors to hold the mesh data
 	std::vector<Vertex> vertices;
 	std::vector<GLuint> indices;
@@ -210,6 +273,8 @@ std::vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType
 
 GLuint Model::TextureFromFile(const char* path)
 {
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Textures);
+
 	//Generate the full filepath
 	std::string filename = std::string(path);
 	filename = mDirectory + '/' + filename;
@@ -227,7 +292,7 @@ GLuint Model::TextureFromFile(const char* path)
 	else
 	{
 		//Bind the texture
-		glBindTexture(GL_TEXTURE_2D, textureID);
+		KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, textureID);
 
 		//Convert the surface to a standard format
 		SDL_Surface* formattedSurface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_ABGR8888);
@@ -243,16 +308,7 @@ GLuint Model::TextureFromFile(const char* path)
 		else
 		{
 			//Generate the texture using the loaded surface data
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, formattedSurface->w, formattedSurface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, formattedSurface->pixels);
-
-			//Set the texture wrapping/filtering parameters
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-			//Generate mipmaps
-			glGenerateMipmap(GL_TEXTURE_2D);
+			uploadTexture(textureID, formattedSurface);
 
 			//Free the formatted surface
 			SDL_DestroySurface(formattedSurface);
@@ -264,3 +320,23 @@ GLuint Model::TextureFromFile(const char* path)
 	//Return the success flag
 	return textureID;
 }
+
+void Model::uploadTexture(GLuint textureID, SDL_Surface* formattedSurface)
+{
+	//Bind the texture
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, textureID);
+
+	//Generate the texture using the surface data
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, formattedSurface->w, formattedSurface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, formattedSurface->pixels);
+
+	//Set the texture wrapping/filtering parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+	//Generate mipmaps
+	glGenerateMipmap(GL_TEXTURE_2D);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Texture, textureID, KJK::MemoryCategory::Textures,
+		KJK::MemoryTracker::EstimateTextureSize(formattedSurface->w, formattedSurface->h, 4, true));
+}
@@ -28,9 +28,27 @@ public:
 
 	//Getter for meshes
 	inline const std::vector<Mesh>& GetMeshes() const { return mMeshes; }
+	//Getter for the model file path
+	inline const std::string& GetPath() const { return mPath; }
+	//Getter for the directory holding the model file, its materials and textures
+	inline const std::string& GetDirectory() const { return mDirectory; }
+
+	//Read a model file into a scene owned by the importer, doesn't touch OpenGL so it can run on any thread
+	static const aiScene* ImportScene(Assimp::Importer& importer, const std::string& path);
+	//Replace all meshes and textures with the ones of a scene imported from the model file again
+	bool Reload(const aiScene* scene);
+	//Replace the image of a loaded texture in place with an ABGR8888 surface, returns false if the model doesn't use the file
+	bool ReloadTexture(const std::string& path, SDL_Surface* formattedSurface);
 private:
+	//The microbenchmarks convert meshes directly, without a model file
+	friend class ModelBenchmarkAccess;
+
+	//Empty model for the benchmarks
+	Model() = default;
+
 	//Model data
 	std::vector<Mesh> mMeshes;
+	std::string mPath;
 	std::string mDirectory;
 
 	//List of loaded textures to avoid loading duplicates
@@ -49,4 +67,6 @@ private:
 
 	//Load a texture from file
 	GLuint TextureFromFile(const char* path);
+	//Fill a texture with an ABGR8888 surface
+	void uploadTexture(GLuint textureID, SDL_Surface* formattedSurface);
 };
\ No newline at end of file
@@ -3,84 +3,97 @@
 #include <KJK>
 #include <glm/gtc/type_ptr.hpp>
 
-Shader::Shader(const GLchar* vertexPath, const GLchar* fragmentPath)
-{
-	//Create a shader program
-	ID = glCreateProgram();
+#include <cstring>
 
-	//Load and compile the vertex shader
-	GLuint vertex = loadAndCompileShader(vertexPath, GL_VERTEX_SHADER);
-	//Load and compile the fragment shader
-	GLuint fragment = loadAndCompileShader(fragmentPath, GL_FRAGMENT_SHADER);
+//Tokens of GL_KHR_parallel_shader_compile, the loader may be generated without the extension
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+	#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+	#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 
-	//Attach the shaders to the program
-	glAttachShader(ID, vertex);
-	glAttachShader(ID, fragment);
-	//Link the shader program
-	glLinkProgram(ID);
+namespace
+{
+	//Set when the driver compiles on its own threads and reports the completion status
+	bool gParallelCompile = false;
 
-	//Check for linking errors
-	GLint programLinked = GL_TRUE;
-	glGetProgramiv(ID, GL_LINK_STATUS, &programLinked);
-	if (programLinked != GL_TRUE)
+	//Check if the current context supports an extension
+	bool hasExtension(const char* name)
 	{
-		KJK_ERROR("Error linking program {0}!", ID);
-		printProgramLog(ID);
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+		for (GLint i = 0; i < count; i++)
+		{
+			const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+			if (extension != nullptr && std::strcmp(extension, name) == 0)
+				return true;
+		}
+		return false;
 	}
-
-	//Delete the shaders as they're linked into the program now and are no longer necessary
-	glDeleteShader(vertex);
-	glDeleteShader(fragment);
 }
 
-Shader::Shader(const GLchar* vertexPath, const GLchar* geometryPath, const GLchar* fragmentPath)
+Shader::Shader(const GLchar* vertexPath, const GLchar* fragmentPath, ShaderBuildMode mode, const ShaderDefines& defines)
+	: ID(0), mStages{ { GL_VERTEX_SHADER, vertexPath }, { GL_FRAGMENT_SHADER, fragmentPath } }, mDefines(defines)
 {
-	//Create a shader program
-	ID = glCreateProgram();
-
-	//Load and compile the vertex shader
-	GLuint vertex = loadAndCompileShader(vertexPath, GL_VERTEX_SHADER);
-	//Load and compile the geometry shader
-	GLuint geometry = loadAndCompileShader(geometryPath, GL_GEOMETRY_SHADER);
-	//Load and compile the fragment shader
-	GLuint fragment = loadAndCompileShader(fragmentPath, GL_FRAGMENT_SHADER);
-
-	//Attach the shaders to the program
-	glAttachShader(ID, vertex);
-	glAttachShader(ID, geometry);
-	glAttachShader(ID, fragment);
-	//Link the shader program
-	glLinkProgram(ID);
-
-	//Check for linking errors
-	GLint programLinked = GL_TRUE;
-	glGetProgramiv(ID, GL_LINK_STATUS, &programLinked);
-	if (programLinked != GL_TRUE)
+	//Load, compile and link the vertex and fragment shaders
+	std::vector<std::string> sources;
+	ReadSources(sources, mIncludes);
+	if (mode == ShaderBuildMode::Deferred)
 	{
-		KJK_ERROR("Error linking program {0}!", ID);
-		printProgramLog(ID);
+		ID = submitProgram(sources, mPendingShaders, mPendingCacheKey);
+		if (!IsPending())
+			reflectUniforms();
 	}
+	else
+	{
+		ID = buildProgram(sources);
+		reflectUniforms();
+	}
+}
 
-	//Delete the shaders as they're linked into the program now and are no longer necessary
-	glDeleteShader(vertex);
-	glDeleteShader(geometry);
-	glDeleteShader(fragment);
+Shader::Shader(const GLchar* vertexPath, const GLchar* geometryPath, const GLchar* fragmentPath, ShaderBuildMode mode, const ShaderDefines& defines)
+	: ID(0), mStages{ { GL_VERTEX_SHADER, vertexPath }, { GL_GEOMETRY_SHADER, geometryPath }, { GL_FRAGMENT_SHADER, fragmentPath } }, mDefines(defines)
+{
+	//Load, compile and link the vertex, geometry and fragment shaders
+	std::vector<std::string> sources;
+	ReadSources(sources, mIncludes);
+	if (mode == ShaderBuildMode::Deferred)
+	{
+		ID = submitProgram(sources, mPendingShaders, mPendingCacheKey);
+		if (!IsPending())
+			reflectUniforms();
+	}
+	else
+	{
+		ID = buildProgram(sources);
+		reflectUniforms();
+	}
 }
 
 Shader::~Shader()
 {
+	for (GLuint shader : mPendingShaders)
+		glDeleteShader(shader);
+
 	if (ID != 0)
 	{
-		glDeleteProgram(ID);
+		KJK::GLStateCache::DeleteProgram(ID);
 		ID = 0;
 	}
 }
 
 Shader::Shader(Shader&& other) noexcept
+	: mStages(std::move(other.mStages)), mDefines(std::move(other.mDefines)), mIncludes(std::move(other.mIncludes)), mPendingShaders(std::move(other.mPendingShaders)), mPendingCacheKey(other.mPendingCacheKey), mUniforms(std::move(other.mUniforms)), mUniformNames(std::move(other.mUniformNames)),
+	mUniformSlots(std::move(other.mUniformSlots)), mUniformBlocks(std::move(other.mUniformBlocks))
 {
 	//Transfer ownership of the shader program ID
 	ID = other.ID;
 	other.ID = 0;
+#ifdef KJK_DEBUG
+	mMissingUniforms = std::move(other.mMissingUniforms);
+	other.mMissingUniforms.clear();
+#endif
 }
 
 Shader& Shader::operator=(Shader&& other) noexcept
@@ -88,13 +101,29 @@ Shader& Shader::operator=(Shader&& other) noexcept
 	if(this != &other)
 	{
 		//Delete the existing shader program
+		for (GLuint shader : mPendingShaders)
+			glDeleteShader(shader);
 		if (ID != 0)
 		{
-			glDeleteProgram(ID);
+			KJK::GLStateCache::DeleteProgram(ID);
 		}
 		//Transfer ownership of the shader program ID
 		ID = other.ID;
 		other.ID = 0;
+		mStages = std::move(other.mStages);
+		mDefines = std::move(other.mDefines);
+		mIncludes = std::move(other.mIncludes);
+		mPendingShaders = std::move(other.mPendingShaders);
+		other.mPendingShaders.clear();
+		mPendingCacheKey = other.mPendingCacheKey;
+		mUniforms = std::move(other.mUniforms);
+		mUniformNames = std::move(other.mUniformNames);
+		mUniformSlots = std::move(other.mUniformSlots);
+		mUniformBlocks = std::move(other.mUniformBlocks);
+#ifdef KJK_DEBUG
+		mMissingUniforms = std::move(other.mMissingUniforms);
+		other.mMissingUniforms.clear();
+#endif
 	}
 
 	return *this;
@@ -103,40 +132,197 @@ Shader& Shader::operator=(Shader&& other) noexcept
 //Use the shader program
 void Shader::Use() const
 {
-	glUseProgram(ID);
+	//Skipped if the program is already current
+	KJK::GLStateCache::UseProgram(ID);
+}
+
+//Let the driver compile shaders on its own threads
+bool Shader::EnableParallelCompile(GLADloadproc loadProc)
+{
+	//The ARB version of the extension uses the same tokens
+	const char* function = nullptr;
+	if (hasExtension("GL_KHR_parallel_shader_compile"))
+		function = "glMaxShaderCompilerThreadsKHR";
+	else if (hasExtension("GL_ARB_parallel_shader_compile"))
+		function = "glMaxShaderCompilerThreadsARB";
+
+	using MaxShaderCompilerThreadsFn = void (APIENTRY*)(GLuint count);
+	auto maxShaderCompilerThreads = function != nullptr ? reinterpret_cast<MaxShaderCompilerThreadsFn>(loadProc(function)) : nullptr;
+	if (maxShaderCompilerThreads == nullptr)
+	{
+		KJK_INFO("The OpenGL driver doesn't support parallel shader compilation");
+		gParallelCompile = false;
+		return false;
+	}
+
+	//Let the driver pick the number of threads
+	maxShaderCompilerThreads(0xFFFFFFFF);
+	gParallelCompile = true;
+
+	GLint threads = 0;
+	glGetIntegerv(GL_MAX_SHADER_COMPILER_THREADS_KHR, &threads);
+	KJK_INFO("Compiling shaders in parallel, the driver allows {0} threads", threads == -1 ? std::string("any number of") : std::to_string(threads));
+	return true;
+}
+
+//Check if finishing the program won't wait for the driver
+bool Shader::IsReady() const
+{
+	if (!IsPending())
+		return true;
+
+	//Without the extension the status can't be polled, the driver finishes the work once the status is checked
+	if (!gParallelCompile)
+		return true;
+
+	GLint completed = GL_FALSE;
+	glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
+}
+
+//Check the compile and link status of a deferred build
+bool Shader::Finish()
+{
+	if (!IsPending())
+		return ID != 0;
+
+	ID = finishProgram(ID, mPendingShaders, mPendingCacheKey);
+	mPendingCacheKey = 0;
+	reflectUniforms();
+	return ID != 0;
+}
+
+//Read and preprocess the sources of all stages in stage order
+bool Shader::ReadSources(std::vector<std::string>& sources, std::vector<std::string>& includes) const
+{
+	bool success = true;
+	includes.clear();
+	sources.resize(mStages.size());
+	for (size_t i = 0; i < mStages.size(); i++)
+	{
+		if (!ShaderPreprocessor::Process(mStages[i].path, mDefines, sources[i], includes))
+			success = false;
+	}
+	return success;
+}
+
+//Build the program again from new stage sources
+bool Shader::Reload(const std::vector<std::string>& sources, const std::vector<std::string>& includes)
+{
+	//A build still in flight is replaced by the new one, its result decides if there's a previous program to keep
+	Finish();
+
+	GLuint program = buildProgram(sources);
+	if (program == 0)
+	{
+		KJK_WARN("Keeping the previous version of program {0}", ID);
+		return false;
+	}
+
+	//Replace the program, the caller has to set its uniforms again
+	if (ID != 0)
+		KJK::GLStateCache::DeleteProgram(ID);
+	ID = program;
+	mIncludes = includes;
+	reflectUniforms();
+	return true;
+}
+
+//Get the location of a uniform from the reflected uniforms
+GLint Shader::GetUniformLocation(const char* name) const
+{
+	const UniformInfo* uniform = FindUniform(name);
+	return uniform != nullptr ? uniform->location : -1;
+}
+
+//Get the reflected information of a uniform
+const UniformInfo* Shader::FindUniform(const char* name) const
+{
+	uint64_t hash = hashName(name);
+	if (!mUniformSlots.empty())
+	{
+		//Linear probing, the table always has empty slots to stop at
+		size_t mask = mUniformSlots.size() - 1;
+		for (size_t slot = hash & mask; mUniformSlots[slot].index != EmptySlot; slot = (slot + 1) & mask)
+		{
+			const UniformSlot& entry = mUniformSlots[slot];
+			if (entry.hash == hash && mUniformNames[entry.index] == name)
+				return &mUniforms[entry.index];
+		}
+	}
+
+#ifdef KJK_DEBUG
+	//Warn once per name, uniforms the compiler optimized out are missing as well
+	if (std::find(mMissingUniforms.begin(), mMissingUniforms.end(), hash) == mMissingUniforms.end())
+	{
+		mMissingUniforms.push_back(hash);
+		KJK_WARN("Program {0} has no active uniform {1}", ID, name);
+	}
+#endif
+	return nullptr;
 }
 
 //Set a boolean uniform variable in the shader
-void Shader::SetBool(const std::string& name, bool value) const
+void Shader::SetBool(const char* name, bool value) const
 {
-	glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+	glUniform1i(GetUniformLocation(name), (int)value);
 }
 
 //Set an integer uniform variable in the shader
-void Shader::SetInt(const std::string& name, int value) const
+void Shader::SetInt(const char* name, int value) const
 {
-	glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+	glUniform1i(GetUniformLocation(name), value);
 }
 
 //Set a float uniform variable in the shader
-void Shader::SetFloat(const std::string& name, float value) const
+void Shader::SetFloat(const char* name, float value) const
+{
+	glUniform1f(GetUniformLocation(name), value);
+}
+
+void Shader::SetMat4(const char* name, const glm::mat4& mat) const
+{
+	glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+void Shader::SetVec3(const char* name, const glm::vec3& vec) const
+{
+	glUniform3fv(GetUniformLocation(name), 1, glm::value_ptr(vec));
+}
+
+void Shader::SetVec4(const char* name, const glm::vec4& vec) const
+{
+	glUniform4fv(GetUniformLocation(name), 1, glm::value_ptr(vec));
+}
+
+void Shader::Set(UniformHandle<bool> uniform, bool value) const
 {
-	glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+	glUniform1i(uniform.location, (int)value);
 }
 
-void Shader::SetMat4(const std::string& name, const glm::mat4& mat) const
+void Shader::Set(UniformHandle<int> uniform, int value) const
 {
-	glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+	glUniform1i(uniform.location, value);
 }
 
-void Shader::SetVec3(const std::string& name, const glm::vec3& vec) const
+void Shader::Set(UniformHandle<float> uniform, float value) const
 {
-	glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(vec));
+	glUniform1f(uniform.location, value);
 }
 
-void Shader::SetVec4(const std::string& name, const glm::vec4& vec) const
+void Shader::Set(UniformHandle<glm::mat4> uniform, const glm::mat4& mat) const
 {
-	glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(vec));
+	glUniformMatrix4fv(uniform.location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+void Shader::Set(UniformHandle<glm::vec3> uniform, const glm::vec3& vec) const
+{
+	glUniform3fv(uniform.location, 1, glm::value_ptr(vec));
+}
+
+void Shader::Set(UniformHandle<glm::vec4> uniform, const glm::vec4& vec) const
+{
+	glUniform4fv(uniform.location, 1, glm::value_ptr(vec));
 }
 
 //Prints out the shader log for a shader object
@@ -203,55 +389,207 @@ void Shader::printProgramLog(GLuint program)
 	}
 }
 
-GLuint Shader::loadAndCompileShader(const GLchar* shaderPath, GLenum type)
+GLuint Shader::compileShader(const std::string& code, GLenum type)
+{
+	KJK_MEMORY_SCOPE(KJK::MemoryCategory::Shaders);
+
+	//Convert the string to a GLchar pointer
+	const GLchar* shaderCode = code.c_str();
+
+	//Declare the shader ID variable
+	GLuint shader{ 0 };
+
+	//Create and compile the shader
+	shader = glCreateShader(type);
+	glShaderSource(shader, 1, &shaderCode, NULL);
+	glCompileShader(shader);
+
+	//Return the shader Id, its status is checked after linking so the driver can compile meanwhile
+	return shader;
+}
+
+GLuint Shader::buildProgram(const std::vector<std::string>& sources)
+{
+	std::vector<GLuint> shaders;
+	uint64_t cacheKey = 0;
+	GLuint program = submitProgram(sources, shaders, cacheKey);
+	return finishProgram(program, shaders, cacheKey);
+}
+
+GLuint Shader::submitProgram(const std::vector<std::string>& sources, std::vector<GLuint>& shaders, uint64_t& cacheKey)
 {
-	//Declare variables for reading the shader file
-	std::string code;
-	std::ifstream shaderFile;
-	//Ensure ifstream object can throw exceptions
-	shaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	try
+	shaders.clear();
+	cacheKey = 0;
+
+	//Programs built before from the same sources on the same driver are loaded from the program cache
+	if (KJK::ProgramCache::IsEnabled())
 	{
-		//Open the shader file
-		shaderFile.open(shaderPath);
+		std::vector<uint32_t> stageTypes;
+		for (const ShaderStage& stage : mStages)
+			stageTypes.push_back(stage.type);
+		cacheKey = KJK::ProgramCache::ComputeKey(stageTypes, sources);
+
+		GLuint cachedProgram = KJK::ProgramCache::Load(cacheKey);
+		if (cachedProgram != 0)
+			return cachedProgram;
+	}
+
+	//Create a shader program
+	GLuint program = glCreateProgram();
+
+	//Compile every stage and attach it to the program
+	for (size_t i = 0; i < mStages.size() && i < sources.size(); i++)
+	{
+		GLuint shader = compileShader(sources[i], mStages[i].type);
+		glAttachShader(program, shader);
+		shaders.push_back(shader);
+	}
+
+	//Link the shader program, keeping its binary retrievable for the program cache
+	if (cacheKey != 0)
+		glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(program);
+
+	return program;
+}
 
-		//Declare a string stream to hold shader code
-		std::stringstream gShaderStream;
+GLuint Shader::finishProgram(GLuint program, std::vector<GLuint>& shaders, uint64_t cacheKey)
+{
+	//Programs from the program cache were linked when they were loaded
+	if (shaders.empty())
+		return program;
 
-		//Read file's buffer contents into streams
-		gShaderStream << shaderFile.rdbuf();
+	//Check for shader compile errors, querying the status waits for the driver
+	for (size_t i = 0; i < shaders.size(); i++)
+	{
+		GLint shaderCompiled = GL_FALSE;
+		glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &shaderCompiled);
+		if (shaderCompiled != GL_TRUE)
+		{
+			KJK_ERROR("Unable to compile the shader {0} - {1}!", shaders[i], mStages[i].path);
+			PrintShaderLog(shaders[i]);
+		}
+	}
 
-		//Close the file handler
-		shaderFile.close();
+	//Check for linking errors
+	GLint programLinked = GL_TRUE;
+	glGetProgramiv(program, GL_LINK_STATUS, &programLinked);
+	if (programLinked != GL_TRUE)
+	{
+		KJK_ERROR("Error linking program {0}!", program);
+		printProgramLog(program);
+	}
+
+	//Delete the shaders as they're linked into the program now and are no longer necessary
+	for (GLuint shader : shaders)
+		glDeleteShader(shader);
+	shaders.clear();
 
-		//Convert the stream into a string
-		code = gShaderStream.str();
+	//A failed program can't be used
+	if (programLinked != GL_TRUE)
+	{
+		glDeleteProgram(program);
+		return 0;
 	}
-	catch (std::ifstream::failure& e)
+
+	if (cacheKey != 0)
+		KJK::ProgramCache::Store(cacheKey, program);
+
+	return program;
+}
+
+void Shader::reflectUniforms()
+{
+	mUniforms.clear();
+	mUniformNames.clear();
+	mUniformSlots.clear();
+	mUniformBlocks.clear();
+#ifdef KJK_DEBUG
+	mMissingUniforms.clear();
+#endif
+
+	if (ID == 0)
+		return;
+
+	//Active uniforms, named by their first element for arrays
+	GLint uniformCount = 0;
+	GLint maxNameLength = 0;
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &uniformCount);
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+	std::vector<GLchar> nameBuffer(std::max(maxNameLength, 1));
+	for (GLint i = 0; i < uniformCount; i++)
 	{
-		KJK_ERROR("ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: {0}", e.what());
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(ID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &size, &type, nameBuffer.data());
+		std::string name(nameBuffer.data(), length);
+
+		//Members of uniform blocks have no location, they're set through their buffer
+		GLint location = glGetUniformLocation(ID, name.c_str());
+		if (location < 0)
+			continue;
+		addUniform(name, UniformInfo{ location, type, size });
+
+		//Make arrays reachable by their base name and by every element, elements don't need consecutive locations
+		if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+		{
+			std::string baseName = name.substr(0, name.size() - 3);
+			addUniform(baseName, UniformInfo{ location, type, size });
+			for (GLint element = 1; element < size; element++)
+			{
+				std::string elementName = baseName + '[' + std::to_string(element) + ']';
+				GLint elementLocation = glGetUniformLocation(ID, elementName.c_str());
+				if (elementLocation >= 0)
+					addUniform(elementName, UniformInfo{ elementLocation, type, 1 });
+			}
+		}
 	}
 
-	//Convert the string to a GLchar pointer
-	const GLchar* shaderCode = code.c_str();
+	//Build the table at most half full, so lookups of missing names end quickly
+	size_t slotCount = 16;
+	while (slotCount < mUniforms.size() * 2)
+		slotCount *= 2;
+	mUniformSlots.assign(slotCount, UniformSlot{ 0, EmptySlot });
 
-	//Declare the shader ID variable
-	GLuint shader{ 0 };
+	size_t mask = slotCount - 1;
+	for (uint32_t index = 0; index < (uint32_t)mUniforms.size(); index++)
+	{
+		uint64_t hash = hashName(mUniformNames[index].c_str());
+		size_t slot = hash & mask;
+		while (mUniformSlots[slot].index != EmptySlot)
+			slot = (slot + 1) & mask;
+		mUniformSlots[slot] = UniformSlot{ hash, index };
+	}
 
-	//Create and compile a geometry shader
-	shader = glCreateShader(type);
-	glShaderSource(shader, 1, &shaderCode, NULL);
-	glCompileShader(shader);
+	//Active uniform blocks with the binding points they read from
+	GLint blockCount = 0;
+	GLint maxBlockNameLength = 0;
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxBlockNameLength);
 
-	//Check for geometry shader compile errors
-	GLint shaderCompiled = GL_FALSE;
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &shaderCompiled);
-	if (shaderCompiled != GL_TRUE)
+	nameBuffer.resize(std::max(maxBlockNameLength, 1));
+	for (GLint i = 0; i < blockCount; i++)
 	{
-		KJK_ERROR("Unable to compile the shader {0} - {1}!", shader, shaderPath);
-		PrintShaderLog(shader);
+		GLsizei length = 0;
+		glGetActiveUniformBlockName(ID, (GLuint)i, (GLsizei)nameBuffer.size(), &length, nameBuffer.data());
+
+		UniformBlockInfo block{ std::string(nameBuffer.data(), length), (GLuint)i, 0, 0 };
+		glGetActiveUniformBlockiv(ID, block.index, GL_UNIFORM_BLOCK_BINDING, &block.binding);
+		glGetActiveUniformBlockiv(ID, block.index, GL_UNIFORM_BLOCK_DATA_SIZE, &block.dataSize);
+		mUniformBlocks.push_back(std::move(block));
 	}
+}
 
-	//Return the shader Id
-	return shader;
+void Shader::addUniform(const std::string& name, const UniformInfo& info)
+{
+	mUniformNames.push_back(name);
+	mUniforms.push_back(info);
+}
+
+uint64_t Shader::hashName(const char* name)
+{
+	//FNV-1a, uniform names are short
+	return KJK::HashFNV1a(name);
 }
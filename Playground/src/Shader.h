@@ -1,16 +1,60 @@
 #pragma once
 
+#include "ShaderPreprocessor.h"
+
+//Source file of a shader stage
+struct ShaderStage
+{
+	GLenum type; //Stage type (vertex, geometry, fragment)
+	std::string path; //File path of the stage source
+};
+
+//How a shader program is built by its constructor
+enum class ShaderBuildMode
+{
+	Immediate, //Compile and link right away, checking for errors before the constructor returns
+	Deferred //Submit the stages to the driver and check for errors when the program is first used
+};
+
+//Active uniform found when the program was linked
+struct UniformInfo
+{
+	GLint location; //Location the uniform is set at
+	GLenum type; //GLSL type (GL_FLOAT_VEC3, GL_SAMPLER_2D, etc.)
+	GLint size; //Number of array elements, 1 for single values
+};
+
+//Active uniform block found when the program was linked
+struct UniformBlockInfo
+{
+	std::string name; //Block name
+	GLuint index; //Block index in the program
+	GLint binding; //Buffer binding point the block reads from
+	GLint dataSize; //Size of the block data in bytes
+};
+
+//Uniform location resolved once and kept by the caller, typed by the value it's set with
+//Locations belong to one build of a program, so handles have to be resolved again after a reload
+template<typename T>
+struct UniformHandle
+{
+	GLint location = -1;
+
+	//Check if the program has the uniform
+	inline bool IsValid() const { return location >= 0; }
+};
+
 class Shader
 {
 public:
 	//Program ID
 	GLuint ID;
 
-	//Constructor reads and builds the shader
-	Shader(const GLchar* vertexPath, const GLchar* fragmentPath);
+	//Constructor reads and builds the shader, the defines are injected into every stage to select a variant
+	Shader(const GLchar* vertexPath, const GLchar* fragmentPath, ShaderBuildMode mode = ShaderBuildMode::Immediate, const ShaderDefines& defines = {});
 
 	//Constructor for 3 shader stages (vertex, geometry, fragment)
-	Shader(const GLchar* vertexPath, const GLchar* geometryPath, const GLchar* fragmentPath);
+	Shader(const GLchar* vertexPath, const GLchar* geometryPath, const GLchar* fragmentPath, ShaderBuildMode mode = ShaderBuildMode::Immediate, const ShaderDefines& defines = {});
 
 	~Shader();
 
@@ -25,26 +69,128 @@ public:
 	//Use the shader program
 	void Use() const;
 
+	//Let the driver compile shaders on its own threads if it supports GL_KHR_parallel_shader_compile, requires a current OpenGL context
+	//Returns false if the driver compiles on the calling thread, deferred builds still overlap compiling with other loading then
+	static bool EnableParallelCompile(GLADloadproc loadProc);
+
+	//Check if a deferred build still has to be finished
+	inline bool IsPending() const { return !mPendingShaders.empty(); }
+	//Check if finishing the program won't wait for the driver, always true for programs that aren't pending
+	bool IsReady() const;
+	//Check the compile and link status of a deferred build, waiting for the driver if it's still compiling
+	//Returns false if the program failed to build, its ID is 0 then
+	bool Finish();
+
+	//Getter for the source files of the program's stages
+	inline const std::vector<ShaderStage>& GetStages() const { return mStages; }
+	//Getter for the files included by the stages, the program has to be rebuilt when they change as well
+	inline const std::vector<std::string>& GetIncludes() const { return mIncludes; }
+	//Getter for the defines selecting the variant
+	inline const ShaderDefines& GetDefines() const { return mDefines; }
+
+	//Read and preprocess the sources of all stages in stage order, collecting the included files
+	//Doesn't touch OpenGL so it can run on any thread
+	bool ReadSources(std::vector<std::string>& sources, std::vector<std::string>& includes) const;
+	//Build the program again from new stage sources, the current program is kept if they fail to compile or link
+	bool Reload(const std::vector<std::string>& sources, const std::vector<std::string>& includes);
+
+	//Get the location of a uniform from the uniforms reflected at link time, -1 if the program has no such uniform
+	GLint GetUniformLocation(const char* name) const;
+	//Get the reflected information of a uniform, nullptr if the program has no such uniform
+	const UniformInfo* FindUniform(const char* name) const;
+	//Resolve a uniform into a handle that can be kept to set it without looking up the name
+	template<typename T>
+	inline UniformHandle<T> GetUniform(const char* name) const { return UniformHandle<T>{ GetUniformLocation(name) }; }
+
+	//Getter for the number of reflected uniforms, every array element counted
+	inline size_t GetUniformCount() const { return mUniforms.size(); }
+	//Getter for the reflected uniform blocks
+	inline const std::vector<UniformBlockInfo>& GetUniformBlocks() const { return mUniformBlocks; }
+
 	//Set a boolean uniform variable in the shader
-	void SetBool(const std::string& name, bool value) const;
+	void SetBool(const char* name, bool value) const;
 	//Set an integer uniform variable in the shader
-	void SetInt(const std::string& name, int value) const;
+	void SetInt(const char* name, int value) const;
 	//Set a float uniform variable in the shader
-	void SetFloat(const std::string& name, float value) const;
+	void SetFloat(const char* name, float value) const;
 	//Set a matrix4 uniform variable in the shader
-	void SetMat4(const std::string& name, const glm::mat4& mat) const;
+	void SetMat4(const char* name, const glm::mat4& mat) const;
 	//Set a vector3 uniform variable in the shader
-	void SetVec3(const std::string& name, const glm::vec3& vec) const;
+	void SetVec3(const char* name, const glm::vec3& vec) const;
 	//Set a vector4 uniform variable in the shader
-	void SetVec4(const std::string& name, const glm::vec4& vec) const;
+	void SetVec4(const char* name, const glm::vec4& vec) const;
+
+	//Overloads for uniform names stored in strings
+	inline void SetBool(const std::string& name, bool value) const { SetBool(name.c_str(), value); }
+	inline void SetInt(const std::string& name, int value) const { SetInt(name.c_str(), value); }
+	inline void SetFloat(const std::string& name, float value) const { SetFloat(name.c_str(), value); }
+	inline void SetMat4(const std::string& name, const glm::mat4& mat) const { SetMat4(name.c_str(), mat); }
+	inline void SetVec3(const std::string& name, const glm::vec3& vec) const { SetVec3(name.c_str(), vec); }
+	inline void SetVec4(const std::string& name, const glm::vec4& vec) const { SetVec4(name.c_str(), vec); }
+
+	//Overloads for resolved uniform handles, invalid handles are ignored like unknown names
+	void Set(UniformHandle<bool> uniform, bool value) const;
+	void Set(UniformHandle<int> uniform, int value) const;
+	void Set(UniformHandle<float> uniform, float value) const;
+	void Set(UniformHandle<glm::mat4> uniform, const glm::mat4& mat) const;
+	void Set(UniformHandle<glm::vec3> uniform, const glm::vec3& vec) const;
+	void Set(UniformHandle<glm::vec4> uniform, const glm::vec4& vec) const;
 
 private:
+	//Source files of the program's stages
+	std::vector<ShaderStage> mStages;
+	//Defines injected into every stage
+	ShaderDefines mDefines;
+	//Files included by the stages of the current program
+	std::vector<std::string> mIncludes;
+
+	//Stage shader objects of a deferred build whose status wasn't checked yet, in stage order
+	std::vector<GLuint> mPendingShaders;
+	//Program cache key of the deferred build, 0 if the program cache isn't used
+	uint64_t mPendingCacheKey = 0;
+
+	//Marks an unused slot of the uniform table
+	static constexpr uint32_t EmptySlot = UINT32_MAX;
+
+	//Slot of the open addressing table of uniform names
+	struct UniformSlot
+	{
+		uint64_t hash; //Hash of the uniform name
+		uint32_t index; //Index into the reflected uniforms, EmptySlot if unused
+	};
+
+	//Uniforms reflected at link time, arrays are also reachable by their base name and every element
+	std::vector<UniformInfo> mUniforms;
+	std::vector<std::string> mUniformNames;
+	//Table of uniform name hashes with a power of two size, kept at most half full
+	std::vector<UniformSlot> mUniformSlots;
+	//Uniform blocks reflected at link time
+	std::vector<UniformBlockInfo> mUniformBlocks;
+#ifdef KJK_DEBUG
+	//Hashes of the missing uniform names that were already warned about
+	mutable std::vector<uint64_t> mMissingUniforms;
+#endif
+
 	//Prints out the shader log for a shader object
 	void PrintShaderLog(GLuint shader);
 	//Prints out the program log for a program object
 	void printProgramLog(GLuint program);
 
-	//Load and compile a shader from file
-	GLuint loadAndCompileShader(const GLchar* shaderPath, GLenum type);
+	//Start compiling the source of a shader stage
+	GLuint compileShader(const std::string& code, GLenum type);
+	//Compile all stages from their sources and link them into a new program, returns 0 if that fails
+	GLuint buildProgram(const std::vector<std::string>& sources);
+	//Load the program from the program cache, or start compiling and linking it without waiting for the driver
+	//Returns the program with the stage shader objects to check, which are left empty for cached programs
+	GLuint submitProgram(const std::vector<std::string>& sources, std::vector<GLuint>& shaders, uint64_t& cacheKey);
+	//Check the status of a submitted program and delete its stage shader objects, returns 0 and deletes the program if it failed
+	GLuint finishProgram(GLuint program, std::vector<GLuint>& shaders, uint64_t cacheKey);
+
+	//Query the active uniforms and uniform blocks of the program and fill the uniform table
+	void reflectUniforms();
+	//Add a uniform to the reflected uniforms, the table is built afterwards
+	void addUniform(const std::string& name, const UniformInfo& info);
+	//Hash a uniform name for the uniform table
+	static uint64_t hashName(const char* name);
 };
 
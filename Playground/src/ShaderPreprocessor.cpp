@@ -0,0 +1,151 @@
+#include "ShaderPreprocessor.h"
+
+#include <KJK_Engine/Core/Logger.h>
+
+#include <filesystem>
+#include <string_view>
+
+namespace
+{
+	//Check if a line starts with a directive, ignoring leading whitespace
+	bool isDirective(std::string_view line, std::string_view directive, std::string_view& rest)
+	{
+		size_t start = line.find_first_not_of(" \t");
+		if (start == std::string_view::npos || line.compare(start, directive.size(), directive) != 0)
+			return false;
+
+		rest = line.substr(start + directive.size());
+		return true;
+	}
+}
+
+bool ShaderPreprocessor::Process(const std::string& path, const ShaderDefines& defines, std::string& source, std::vector<std::string>& includes)
+{
+	source.clear();
+
+	//The defines go right after #version, which has to stay the first line
+	std::string header;
+	for (const ShaderDefine& define : defines)
+	{
+		header += "#define ";
+		header += define.name;
+		if (!define.value.empty())
+		{
+			header += ' ';
+			header += define.value;
+		}
+		header += '\n';
+	}
+
+	std::vector<std::string> files{ std::filesystem::path(path).lexically_normal().generic_string() };
+	if (!expandFile(path, header, source, files, includes))
+		return false;
+
+	//Sources without a #version line get the defines in front
+	if (!header.empty())
+		source.insert(0, header + "#line 1 0\n");
+
+	return true;
+}
+
+std::string ShaderPreprocessor::GetPermutationKey(const ShaderDefines& defines)
+{
+	std::vector<std::string> entries;
+	entries.reserve(defines.size());
+	for (const ShaderDefine& define : defines)
+		entries.push_back(define.name + '=' + define.value);
+	std::sort(entries.begin(), entries.end());
+
+	std::string key;
+	for (const std::string& entry : entries)
+	{
+		key += entry;
+		key += '\0';
+	}
+	return key;
+}
+
+bool ShaderPreprocessor::expandFile(const std::string& path, std::string& header, std::string& source, std::vector<std::string>& files, std::vector<std::string>& includes)
+{
+	std::string content;
+	if (!readFile(path, content))
+	{
+		KJK_ERROR("ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: {0}", path);
+		return false;
+	}
+
+	const std::string fileIndex = std::to_string(files.size() - 1);
+	const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+	size_t lineNumber = 0;
+	for (size_t start = 0; start < content.size();)
+	{
+		size_t end = content.find('\n', start);
+		if (end == std::string::npos)
+			end = content.size();
+		std::string_view line(content.data() + start, end - start);
+		start = end + 1;
+		lineNumber++;
+
+		std::string_view rest;
+		if (!header.empty() && isDirective(line, "#version", rest))
+		{
+			//Continue at the next line of the file after the injected defines
+			source.append(line);
+			source += '\n';
+			source += header;
+			source += "#line " + std::to_string(lineNumber + 1) + ' ' + fileIndex + '\n';
+			header.clear();
+			continue;
+		}
+
+		if (!isDirective(line, "#include", rest))
+		{
+			source.append(line);
+			source += '\n';
+			continue;
+		}
+
+		size_t nameStart = rest.find('"');
+		size_t nameEnd = nameStart != std::string_view::npos ? rest.find('"', nameStart + 1) : std::string_view::npos;
+		if (nameEnd == std::string_view::npos)
+		{
+			KJK_ERROR("{0}({1}): #include expects a file name in quotes", path, lineNumber);
+			return false;
+		}
+
+		//Files already in the stage are skipped, an empty line keeps the line numbers
+		std::string includePath = (directory / rest.substr(nameStart + 1, nameEnd - nameStart - 1)).lexically_normal().generic_string();
+		if (std::find(files.begin(), files.end(), includePath) != files.end())
+		{
+			source += '\n';
+			continue;
+		}
+
+		files.push_back(includePath);
+		if (std::find(includes.begin(), includes.end(), includePath) == includes.end())
+			includes.push_back(includePath);
+
+		source += "#line 1 " + std::to_string(files.size() - 1) + '\n';
+		if (!expandFile(includePath, header, source, files, includes))
+		{
+			KJK_ERROR("Included from {0}({1})", path, lineNumber);
+			return false;
+		}
+		source += "#line " + std::to_string(lineNumber + 1) + ' ' + fileIndex + '\n';
+	}
+
+	return true;
+}
+
+bool ShaderPreprocessor::readFile(const std::string& path, std::string& content)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+	content = stream.str();
+	return !file.bad();
+}
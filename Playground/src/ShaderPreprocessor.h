@@ -0,0 +1,34 @@
+#pragma once
+
+//Macro injected into the stage sources of a shader variant
+struct ShaderDefine
+{
+	std::string name; //Macro name
+	std::string value; //Macro value, empty for flags tested with #ifdef
+};
+
+//Set of macros selecting a shader variant
+using ShaderDefines = std::vector<ShaderDefine>;
+
+//Expands #include directives and injects defines into shader stage sources
+//Only touches files, so it can run on any thread
+class ShaderPreprocessor
+{
+public:
+	//Read a stage source with its includes expanded and the defines injected after the #version line
+	//Include paths are relative to the including file and every file is included at most once per stage
+	//#line directives keep the line numbers of compile errors, the source string number is 0 for the stage file and counts up per included file
+	//The included files are added to includes (if not listed yet), returns false if a file can't be read
+	static bool Process(const std::string& path, const ShaderDefines& defines, std::string& source, std::vector<std::string>& includes);
+
+	//Build the permutation key of a set of defines, independent of their order
+	//The sorted name=value entries, each followed by a null character so entries can't run into each other
+	static std::string GetPermutationKey(const ShaderDefines& defines);
+
+private:
+	//Append a file to the output, expanding its includes recursively and inserting the header after the #version line
+	//files lists the files of the stage in the order they were included, the last one is the file being expanded
+	static bool expandFile(const std::string& path, std::string& header, std::string& source, std::vector<std::string>& files, std::vector<std::string>& includes);
+	//Read a whole file into a string
+	static bool readFile(const std::string& path, std::string& content);
+};
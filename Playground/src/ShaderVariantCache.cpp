@@ -0,0 +1,52 @@
+#include "ShaderVariantCache.h"
+
+ShaderVariantCache::ShaderVariantCache(ShaderBuildMode mode)
+	: mMode(mode)
+{
+}
+
+Shader& ShaderVariantCache::Get(const GLchar* vertexPath, const GLchar* fragmentPath, const ShaderDefines& defines)
+{
+	std::string key;
+	if (Shader* shader = find({ vertexPath, fragmentPath }, defines, key))
+		return *shader;
+
+	return add(std::move(key), std::make_unique<Shader>(vertexPath, fragmentPath, mMode, defines));
+}
+
+Shader& ShaderVariantCache::Get(const GLchar* vertexPath, const GLchar* geometryPath, const GLchar* fragmentPath, const ShaderDefines& defines)
+{
+	std::string key;
+	if (Shader* shader = find({ vertexPath, geometryPath, fragmentPath }, defines, key))
+		return *shader;
+
+	return add(std::move(key), std::make_unique<Shader>(vertexPath, geometryPath, fragmentPath, mMode, defines));
+}
+
+Shader* ShaderVariantCache::find(std::initializer_list<const GLchar*> paths, const ShaderDefines& defines, std::string& key)
+{
+	//The stage paths, each followed by a null character, then the permutation key of the defines
+	//An empty entry ends the paths, so a path can't be mistaken for a define
+	key.clear();
+	for (const GLchar* path : paths)
+	{
+		key += path;
+		key += '\0';
+	}
+	key += '\0';
+	key += ShaderPreprocessor::GetPermutationKey(defines);
+
+	auto it = mVariantIndices.find(key);
+	if (it == mVariantIndices.end())
+		return nullptr;
+
+	mHits++;
+	return mVariants[it->second].get();
+}
+
+Shader& ShaderVariantCache::add(std::string key, std::unique_ptr<Shader> shader)
+{
+	mVariantIndices.emplace(std::move(key), mVariants.size());
+	mVariants.push_back(std::move(shader));
+	return *mVariants.back();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Shader.h"
+
+#include <KJK_Engine/Core/Hash.h>
+
+//Owns the variants of shader programs, built on their first request and shared by later requests
+//A variant is a set of stage files compiled with a set of defines, so only the permutations actually used get compiled
+class ShaderVariantCache
+{
+public:
+	//Constructor taking the build mode of the variants
+	ShaderVariantCache(ShaderBuildMode mode = ShaderBuildMode::Immediate);
+
+	//Disable copy semantics, callers keep pointers to the variants
+	ShaderVariantCache(const ShaderVariantCache& other) = delete;
+	ShaderVariantCache& operator=(const ShaderVariantCache& other) = delete;
+
+	//Get the variant of a vertex and fragment shader, building it on the first request
+	Shader& Get(const GLchar* vertexPath, const GLchar* fragmentPath, const ShaderDefines& defines = {});
+	//Get the variant of a vertex, geometry and fragment shader, building it on the first request
+	Shader& Get(const GLchar* vertexPath, const GLchar* geometryPath, const GLchar* fragmentPath, const ShaderDefines& defines = {});
+
+	//Getter for the built variants in the order they were first requested
+	inline const std::vector<std::unique_ptr<Shader>>& GetVariants() const { return mVariants; }
+	//Getter for the number of requests served by an already built variant
+	inline size_t GetHitCount() const { return mHits; }
+private:
+	//Hash of a variant key, the map compares the full keys so colliding hashes can't return the wrong variant
+	struct VariantKeyHash
+	{
+		inline size_t operator()(const std::string& key) const { return static_cast<size_t>(KJK::HashFNV1a(key.data(), key.size())); }
+	};
+
+	ShaderBuildMode mMode;
+
+	//Variants with their index by variant key, pointers stay valid as the variants never move
+	std::vector<std::unique_ptr<Shader>> mVariants;
+	std::unordered_map<std::string, size_t, VariantKeyHash> mVariantIndices;
+	size_t mHits = 0;
+
+	//Find a built variant, returns nullptr and the key to build it under if there is none
+	Shader* find(std::initializer_list<const GLchar*> paths, const ShaderDefines& defines, std::string& key);
+	//Add a built variant under its key
+	Shader& add(std::string key, std::unique_ptr<Shader> shader);
+};
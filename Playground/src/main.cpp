@@ -1,14 +1,24 @@
 //File for testing external library features before implementing them in the engine
 #include <KJK>
+#include <Platform/SDL/SDLWindow.h>
 
 #include "Shader.h"
 #include "Camera.h"
 #include "Model.h"
 #include "CubeModel.h"
 #include "PlaneModel.h"
+#include "AssetReloader.h"
+#include "ShaderVariantCache.h"
 
 #include <SDL3/SDL_main.h>
 
+#include <random>
+
+#ifdef KJK_PLAYGROUND_HEADLESS
+	#include "HeadlessContext.h"
+	#include "BenchmarkReport.h"
+#endif
+
 //Initializes the logging system
 void initLogger();
 //Initializes OpenGl and SDL, then creates a window
@@ -17,12 +27,18 @@ bool init();
 bool initGL();
 //Loads media
 bool loadMedia();
+//Set the uniforms of the shader programs that don't change per frame
+void initializeShaderUniforms();
+//Add the instance matrices to the asteroid meshes
+void setupAsteroidInstancing();
 //Cleans up and closes SDL and all used objects
 void close();
 //Change the shader program
 void changeShader(GLint shaderIndex);
 //Recreate framebuffer objects on window resize
 void recreateFramebuffers();
+//Record the estimated size of the framebuffer attachments
+void trackFramebufferMemory();
 
 //Render example scene
 void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEnabled, glm::mat4 view, glm::mat4 projection, int shadowType = 0);
@@ -33,11 +49,8 @@ void renderSpaceScene(float timeValue, glm::mat4 view, glm::mat4 projection, int
 int SCREEN_WIDTH{ 800 };
 int SCREEN_HEIGHT{ 600 };
 
-//The window to render to
-SDL_Window* gWindow = nullptr;
-
-//Context for OpenGL
-SDL_GLContext gContext;
+//The window to render to, owns the OpenGL context
+KJK::SDLWindow* gWindow = nullptr;
 
 //Framebuffer object ID
 GLuint gFBO{ 0 };
@@ -48,6 +61,10 @@ GLuint gRBO{ 0 };
 //Screen quad VAO and VBO
 GLuint gScreenQuadVAO{ 0 };
 GLuint gScreenQuadVBO{ 0 };
+//Framebuffer the post processed frame is drawn to, 0 is the default framebuffer of the window
+GLuint gPresentFBO{ 0 };
+//Color attachment of the offscreen present framebuffer when running without a window
+GLuint gPresentRBO{ 0 };
 
 //Multisample framebuffer object ID
 GLuint gMultisampleFBO{ 0 };
@@ -72,8 +89,10 @@ GLuint gPointLightShadowMapCubeTexture{ 0 };
 //Shadow map far plane for point light
 float gPointLightShadowFarPlane{ 25.0f };
 
-//Shader program IDs
-std::optional<std::array<Shader, 20>> gShaders;
+//Shader variants built for the programs below
+ShaderVariantCache* gShaderVariants;
+//Shader programs by index, owned by the variant cache
+std::array<Shader*, 20> gShaders{};
 //Current shader index
 GLint gCurrentShaderIndex{ 0 };
 
@@ -131,12 +150,31 @@ CubeModel* gReflectiveCubeModel;
 //Refractive cube object
 CubeModel* gRefractiveCubeModel;
 
+//Reloads the shaders, textures and models edited while running
+AssetReloader* gAssetReloader = nullptr;
+
+#ifdef KJK_PLAYGROUND_HEADLESS
+//Settings of the headless benchmark run
+BenchmarkSettings gBenchmarkSettings;
+#endif
+
 //The main function
 int main(int argc, char* args[])
 {
 	//Final exit code
 	int exitCode{ 0 };
 
+#ifdef KJK_PLAYGROUND_HEADLESS
+	//Fixed resolution and asteroid field for reproducible numbers
+	if (!parseBenchmarkSettings(argc, args, gBenchmarkSettings))
+		return 1;
+	SCREEN_WIDTH = gBenchmarkSettings.width;
+	SCREEN_HEIGHT = gBenchmarkSettings.height;
+	if (gBenchmarkSettings.asteroidCount != 0)
+		gAsteroidInstanceAmount = gBenchmarkSettings.asteroidCount;
+	gBenchmarkSettings.asteroidCount = gAsteroidInstanceAmount;
+#endif
+
 	//Initialize SDL and OpenGL, then create a window
 	if (init() == false)
 	{
@@ -157,18 +195,44 @@ int main(int argc, char* args[])
 			//Main loop flag
 			bool quit = false;
 
-			//Event handler
-			SDL_Event e;
-			SDL_zero(e);
+			//Frame timer measuring high resolution frame times and driving the fixed simulation steps
+			KJK::FrameTimer frameTimer;
 
-			//Time variables
-			float deltaTime{ 0.0f };
-			float lastFrame{ 0.0f };
+			//State cache counters at the end of the previous frame
+			KJK::GLStateCacheStats lastStateCacheStats = KJK::GLStateCache::GetStats();
 
 			//Set the initial mix value for texture blending
 			float mixValue = 0.2f;
-			(*gShaders)[1].Use();
-			(*gShaders)[1].SetFloat("mixValue", mixValue);
+			changeShader(1);
+			(*gShaders[gCurrentShaderIndex]).SetFloat("mixValue", mixValue);
+
+#ifndef KJK_PLAYGROUND_HEADLESS
+			//Reload the assets edited while running, the benchmark always renders the files it started with
+			if (KJK::FileWatcher::Init() && KJK::FileWatcher::WatchDirectory("assets"))
+			{
+				gAssetReloader = new AssetReloader();
+				for (const auto& shader : gShaderVariants->GetVariants())
+					gAssetReloader->AddShader(*shader);
+				for (int i = 0; i < 2; i++)
+					gAssetReloader->AddModel(gCubeModels[i]);
+				for (int i = 0; i < 5; i++)
+					gAssetReloader->AddModel(gGlassPlaneModels[i]);
+				gAssetReloader->AddModel(*gPlaneModel);
+				gAssetReloader->AddModel(*gModel);
+				gAssetReloader->AddModel(*gPlanetModel);
+				gAssetReloader->AddModel(*gAsteroidModel, []() { setupAsteroidInstancing(); });
+
+				//Rebuilt programs start without uniforms, set the ones that aren't set every frame again
+				gAssetReloader->SetShadersReloadedCallback([&mixValue]()
+				{
+					GLint currentShader = gCurrentShaderIndex;
+					initializeShaderUniforms();
+					changeShader(1);
+					(*gShaders[gCurrentShaderIndex]).SetFloat("mixValue", mixValue);
+					changeShader(currentShader);
+				});
+			}
+#endif
 
 			//Mouse Input mode setting
 			bool mouseCaptured = true;
@@ -191,6 +255,9 @@ int main(int argc, char* args[])
 			//SHow depth map setting
 			bool showDepthMap = false;
 
+			//Show the stats overlay setting
+			bool showStats = false;
+
 			//Current selected scene setting
 			int currentScene = 1;
 
@@ -206,188 +273,285 @@ int main(int argc, char* args[])
 				SCENE
 			} inputState{InputState::NONE};
 
-			//While application is running
-			while (!quit)
+			//Per frame data shared between the frame graph tasks
+			float deltaTime{ 0.0f };
+			float renderTimeValue{ 0.0f };
+			//Directional light matrices
+			glm::mat4 lightProjection{ 1.0f };
+			glm::mat4 lightView{ 1.0f };
+			//Point light matrices for each cube map face
+			glm::mat4 pointLightProjection{ 1.0f };
+			std::array<glm::mat4, 6> pointLightViews;
+			std::array<glm::mat4, 6> pointLightProjectionViews;
+			//Camera matrices
+			glm::mat4 view{ 1.0f };
+			glm::mat4 projection{ 1.0f };
+
+			//Flag for logging the frame graph timings after the frame
+			bool logFrameGraph = false;
+			//Trace logging flag
+			bool traceLogging = false;
+
+#ifndef KJK_PLAYGROUND_HEADLESS
+			//Feed ImGui every event even while the overlay is hidden, so it shows with the current mouse, key and window state
+			//Only drawing the overlay depends on its visibility
+			gWindow->SetNativeEventCallback([](const SDL_Event& event)
 			{
-				//Calculate delta time
-				float currentFrame = static_cast<float>(SDL_GetTicks()) / 1000.0f;
-				deltaTime = currentFrame - lastFrame;
-				lastFrame = currentFrame;
+				KJK::ImGuiRenderer::ProcessEvent(event);
+			});
 
-				//Get keyboard state
-				const bool* keyState = SDL_GetKeyboardState(NULL);
+			//Handle the translated input and window events, a window drag or fast mouse motion arrives as one merged event
+			gWindow->SetEventCallback([&](KJK::Event& event)
+			{
+				//Collect the input state for the snapshot of the next frame, the camera reads it from there
+				KJK::Input::OnEvent(event);
 
-				//Handle events on queue
-				while (SDL_PollEvent(&e) != 0)
+				KJK::EventDispatcher dispatcher(event);
+				//User requests quit
+				dispatcher.Dispatch<KJK::WindowCloseEvent>([&quit](KJK::WindowCloseEvent&)
 				{
-					//User requests quit
-					if (e.type == SDL_EVENT_QUIT)
+					quit = true;
+					return true;
+				});
+				//Handle keyboard input
+				dispatcher.Dispatch<KJK::KeyPressedEvent>([&](KJK::KeyPressedEvent& key)
+				{
+					switch (static_cast<SDL_Keycode>(key.GetKeyCode()))
 					{
+					case SDLK_ESCAPE: //Exit the application
 						quit = true;
-					}
-					//Window resize event
-					else if (e.type == SDL_EVENT_WINDOW_RESIZED)
-					{
-						//Adjust the viewport when the window size changes
-						glViewport(0, 0, e.window.data1, e.window.data2);
-
-						//Adjust the screen width and height variables
-						SCREEN_WIDTH = e.window.data1;
-						SCREEN_HEIGHT = e.window.data2;
+						break;
+					case SDLK_1: //Enable mix value control
+						inputState = InputState::MIX;
+						break;
+					case SDLK_2: //Enable FoV control
+						inputState = InputState::FOV;
+						break;
+					case SDLK_3: //Enable scene change control
+						inputState = InputState::SCENE;
+						break;
+					case SDLK_M: //Switch mouse capture mode
+						mouseCaptured = !mouseCaptured;
+						SDL_SetWindowRelativeMouseMode(gWindow->GetSDLWindow(), mouseCaptured);
+						break;
+					case SDLK_P: //Switch object movement setting
+						enableMovement = !enableMovement;
+						break;
+					case SDLK_F: //Toggle flashlight
+						flashlightEnabled = !flashlightEnabled;
 
-						//Recreate framebuffer objects
-						recreateFramebuffers();
-					}
-					//Handle keyboard input
-					else if (e.type == SDL_EVENT_KEY_DOWN)
-					{
-						switch (e.key.key)
+						for (int i : {1, 8, 10})
 						{
-						case SDLK_ESCAPE: //Exit the application
-							quit = true;
-							break;
-						case SDLK_1: //Enable mix value control
-							inputState = InputState::MIX;
-							break;
-						case SDLK_2: //Enable FoV control
-							inputState = InputState::FOV;
-							break;
-						case SDLK_3: //Enable scene change control
-							inputState = InputState::SCENE;
-							break;
-						case SDLK_M: //Switch mouse capture mode
-							mouseCaptured = !mouseCaptured;
-							SDL_SetWindowRelativeMouseMode(gWindow, mouseCaptured);
-							break;
-						case SDLK_P: //Switch object movement setting
-							enableMovement = !enableMovement;
-							break;
-						case SDLK_F: //Toggle flashlight
-							flashlightEnabled = !flashlightEnabled;
-
-							for (int i : {1, 8, 10})
+							changeShader(i);
+							if (flashlightEnabled)
 							{
-								changeShader(i);
-								if (flashlightEnabled)
-								{
-									(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.ambient", gSpotLight.ambient);
-									(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.diffuse", gSpotLight.diffuse);
-									(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.specular", gSpotLight.specular);
-								}
-								else
-								{
-									(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.ambient", glm::vec4(0.0f));
-									(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.diffuse", glm::vec4(0.0f));
-									(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.specular", glm::vec4(0.0f));
-								}
+								(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.ambient", gSpotLight.ambient);
+								(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.diffuse", gSpotLight.diffuse);
+								(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.specular", gSpotLight.specular);
 							}
-							break;
-						case SDLK_O: //Toggle outline effect
-							outlineEffectEnabled = !outlineEffectEnabled;
-							if (outlineEffectEnabled)
+							else
 							{
-								glEnable(GL_STENCIL_TEST);
+								(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.ambient", glm::vec4(0.0f));
+								(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.diffuse", glm::vec4(0.0f));
+								(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.specular", glm::vec4(0.0f));
 							}
-							else
+						}
+						break;
+					case SDLK_O: //Toggle outline effect
+						outlineEffectEnabled = !outlineEffectEnabled;
+						if (outlineEffectEnabled)
+						{
+							KJK::GLStateCache::Enable(GL_STENCIL_TEST);
+						}
+						else
+						{
+							KJK::GLStateCache::Disable(GL_STENCIL_TEST);
+						}
+						break;
+					case SDLK_T: //Toggle postprocessing effect
+						applyPostProcessing = !applyPostProcessing;
+						break;
+					case SDLK_N: //Toggle normal vector display
+						showNormals = !showNormals;
+						break;
+					case SDLK_0:
+						showDepthMap = !showDepthMap;
+						break;
+					case SDLK_G: //Log the frame graph and render pass timings
+						logFrameGraph = true;
+						break;
+					case SDLK_L: //Toggle trace logging
+						traceLogging = !traceLogging;
+						KJK::Logger::SetCoreLevel(traceLogging ? spdlog::level::trace : spdlog::level::info);
+						KJK::Logger::SetClientLevel(traceLogging ? spdlog::level::trace : spdlog::level::info);
+						break;
+					case SDLK_F1: //Toggle the stats overlay
+						showStats = !showStats;
+						break;
+					case SDLK_F2: //Export the recorded frame stats
+						KJK::Stats::ExportCsv("Playground.stats.csv");
+						break;
+					case SDLK_F3: //Log the memory per subsystem
+						KJK::MemoryTracker::LogReport();
+						break;
+					case SDLK_C: //Capture a CPU profile of the next frames
+						KJK::Profiler::RequestCapture("Playground.profile.json", KJK::Profiler::GetFrameIndex() + 1, 120);
+						break;
+					case SDLK_B: //Toggle binary trace recording
+						KJK::BinaryTrace::SetEnabled(!KJK::BinaryTrace::IsEnabled());
+						KJK_INFO("Binary trace recording {0}", KJK::BinaryTrace::IsEnabled() ? "enabled" : "disabled");
+						break;
+					case SDLK_UP: //Increase the appropriate value
+						switch (inputState)
+						{
+						case InputState::MIX: //Increase the mix value
+							mixValue += 0.05f;
+							if (mixValue > 1.0f)
 							{
-								glDisable(GL_STENCIL_TEST);
+								mixValue = 1.0f;
 							}
+							//Apply the new mix value
+							changeShader(1);
+							(*gShaders[gCurrentShaderIndex]).SetFloat("mixValue", mixValue);
 							break;
-						case SDLK_T: //Toggle postprocessing effect
-							applyPostProcessing = !applyPostProcessing;
+						case InputState::FOV: //Increase the FoV
+							gCamera->fov += 5.0f;
+							if (gCamera->fov > 360.0f)
+							{
+								gCamera->fov = 360.0f;
+							}
 							break;
-						case SDLK_N: //Toggle normal vector display
-							showNormals = !showNormals;
+						case InputState::SCENE: //Change scene up
+							currentScene++;
+							if (currentScene > 1)
+								currentScene = 1;
 							break;
-						case SDLK_0:
-							showDepthMap = !showDepthMap;
+						default:
 							break;
-						case SDLK_UP: //Increase the appropriate value
-							switch (inputState)
+						}
+						break;
+					case SDLK_DOWN: //Decrease the appropriate value
+						switch (inputState)
+						{
+						case InputState::MIX:
+							mixValue -= 0.05f;
+							if (mixValue < 0.0f)
 							{
-							case InputState::MIX: //Increase the mix value
-								mixValue += 0.05f;
-								if (mixValue > 1.0f)
-								{
-									mixValue = 1.0f;
-								}
-								//Apply the new mix value
-								changeShader(1);
-								(*gShaders)[gCurrentShaderIndex].SetFloat("mixValue", mixValue);
-								break;
-							case InputState::FOV: //Increase the FoV
-								gCamera->fov += 5.0f;
-								if (gCamera->fov > 360.0f)
-								{
-									gCamera->fov = 360.0f;
-								}
-								break;
-							case InputState::SCENE: //Change scene up
-								currentScene++;
-								if (currentScene > 1)
-									currentScene = 1;
-								break;
-							default:
-								break;
+								mixValue = 0.0f;
 							}
+							//Apply the new mix value
+							changeShader(1);
+							(*gShaders[gCurrentShaderIndex]).SetFloat("mixValue", mixValue);
 							break;
-						case SDLK_DOWN: //Decrease the appropriate value
-							switch (inputState)
+						case InputState::FOV:
+							gCamera->fov -= 5.0f;
+							if (gCamera->fov < 0.0f)
 							{
-							case InputState::MIX:
-								mixValue -= 0.05f;
-								if (mixValue < 0.0f)
-								{
-									mixValue = 0.0f;
-								}
-								//Apply the new mix value
-								changeShader(1);
-								(*gShaders)[gCurrentShaderIndex].SetFloat("mixValue", mixValue);
-								break;
-							case InputState::FOV:
-								gCamera->fov -= 5.0f;
-								if (gCamera->fov < 0.0f)
-								{
-									gCamera->fov = 0.0f;
-								}
-								break;
-							case InputState::SCENE: //Change scene down
-								currentScene--;
-								if (currentScene < 0)
-									currentScene = 0;
-								break;
-							default:
-								break;
+								gCamera->fov = 0.0f;
 							}
 							break;
+						case InputState::SCENE: //Change scene down
+							currentScene--;
+							if (currentScene < 0)
+								currentScene = 0;
+							break;
 						default:
 							break;
 						}
+						break;
+					default:
+						break;
 					}
 
-					//Handle camera mouse and keyboard input
-					gCamera->HandleInput(e, deltaTime, mouseCaptured, nullptr);
+					return true;
+				});
+				dispatcher.Dispatch<KJK::WindowResizeEvent>([](KJK::WindowResizeEvent& resize)
+				{
+					//Adjust the viewport when the window size changes
+					glViewport(0, 0, resize.GetWidth(), resize.GetHeight());
+
+					//Adjust the screen width and height variables
+					SCREEN_WIDTH = resize.GetWidth();
+					SCREEN_HEIGHT = resize.GetHeight();
+
+					//Recreate framebuffer objects
+					recreateFramebuffers();
+					return true;
+				});
+			});
+#endif
+
+#ifdef KJK_PLAYGROUND_HEADLESS
+			//Every scene renders the warmup frames and then the measured frames, starting from the same simulation time
+			BenchmarkReport benchmarkReport;
+			const std::array<std::pair<int, const char*>, 2> benchmarkScenes{ { { 1, "example" }, { 0, "space" } } };
+			size_t benchmarkSceneIndex = 0;
+			unsigned int benchmarkFrame = 0;
+			//Start of the current frame and the CPU time spent on it before waiting for the GPU
+			uint64_t benchmarkFrameStartNs = 0;
+			float benchmarkCpuMs = 0.0f;
+			currentScene = benchmarkScenes[0].first;
+			benchmarkReport.BeginScene(benchmarkScenes[0].second);
+
+			//Add the GPU pass timings once a new frame got resolved
+			uint64_t benchmarkGpuResultFrame = 0;
+			auto collectGpuResults = [&]()
+			{
+				if (KJK::GpuProfiler::GetResultFrameIndex() == benchmarkGpuResultFrame)
+					return;
+				benchmarkGpuResultFrame = KJK::GpuProfiler::GetResultFrameIndex();
+				benchmarkReport.AddGpuResults(benchmarkGpuResultFrame, KJK::GpuProfiler::GetResults());
+			};
+#endif
+
+			//Build the frame graph once, the CPU work of the shadow and main views overlaps on the job system
+			//Tasks issuing OpenGL calls are pinned to the main thread which owns the context
+			KJK::TaskGraph frameGraph;
+
+			//Poll events and handle the user input
+			KJK::TaskGraph::TaskHandle inputTask = frameGraph.AddTask("Input", [&]()
+			{
+#ifndef KJK_PLAYGROUND_HEADLESS
+				//Drain the window events and deliver them to the event callback
+				gWindow->OnUpdate();
+
+				//Publish the input of this frame and move the camera by it
+				const KJK::InputSnapshot& input = KJK::Input::Publish();
+				gCamera->HandleInput(input, deltaTime, mouseCaptured);
+#endif
+			}, KJK::TaskAffinity::MainThread);
+
+			//Advance the simulation
+			KJK::TaskGraph::TaskHandle simulationTask = frameGraph.AddTask("Simulation", [&]()
+			{
+#ifdef KJK_PLAYGROUND_HEADLESS
+				//Advance exactly one fixed step per frame so every run renders the same frames regardless of speed
+				timeValue += frameTimer.GetFixedTimestep();
+				renderTimeValue = timeValue;
+#else
+				//Advance the simulation time in fixed steps
+				while (frameTimer.StepFixed())
+				{
+					if (enableMovement)
+					{
+						timeValue += frameTimer.GetFixedTimestep();
+					}
 				}
+				//Interpolate the rendered time between the last and the next fixed step
+				renderTimeValue = timeValue;
+				if (enableMovement)
+				{
+					renderTimeValue += frameTimer.GetAlpha() * frameTimer.GetFixedTimestep();
+				}
+#endif
+			});
 
-				//Handle camera keystate input
-				gCamera->HandleInput(SDL_Event{}, deltaTime, mouseCaptured, keyState);
-
-				//Resize the viewport to the shadow map size
-				glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
-				//Bind the shadow map framebuffer
-				glBindFramebuffer(GL_FRAMEBUFFER, gShadowMapFBO);
-
-				//Enable depth testing
-				glEnable(GL_DEPTH_TEST);
-				glDepthFunc(GL_LESS);
-				glDepthMask(GL_TRUE);
-
-				//Clear the depth buffer
-				glClear(GL_DEPTH_BUFFER_BIT);
-
+			//Calculate the directional light matrices
+			KJK::TaskGraph::TaskHandle prepareShadowTask = frameGraph.AddTask("PrepareDirectionalShadow", [&]()
+			{
 				//Declare the variable for orthogonal sizing
 				float orthogonalSize = 0;
-				//Render the scene to the shadow map
+				//Pick the shadow map coverage for the scene
 				switch (currentScene)
 				{
 				case 0:
@@ -402,88 +566,135 @@ int main(int argc, char* args[])
 				}
 
 				//Define directional light projection matrix
-				glm::mat4 lightProjection = glm::ortho(-orthogonalSize, orthogonalSize, -orthogonalSize, orthogonalSize, 0.1f, 200.0f);
+				lightProjection = glm::ortho(-orthogonalSize, orthogonalSize, -orthogonalSize, orthogonalSize, 0.1f, 200.0f);
 				//Define directional light view matrix
-				glm::mat4 lightView = glm::lookAt(gDirectionalLight.position, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+				lightView = glm::lookAt(gDirectionalLight.position, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+				//Calculate the light space matrix
+				gLightSpaceMatrix = lightProjection * lightView;
+			});
+
+			//Calculate the point light matrices
+			KJK::TaskGraph::TaskHandle preparePointShadowTask = frameGraph.AddTask("PreparePointShadow", [&]()
+			{
+				//Define a point light projection matrix
+				pointLightProjection = glm::perspective(glm::radians(90.0f), (float)SHADOW_WIDTH / (float)SHADOW_HEIGHT, 0.1f, gPointLightShadowFarPlane);
+				//Define the point light view matrices for each cube map face
+				pointLightViews[0] = glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f));
+				pointLightViews[1] = glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f));
+				pointLightViews[2] = glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3 (0.0f,  1.0f,  0.0f), glm::vec3(0.0f,  0.0f,  1.0f));
+				pointLightViews[3] = glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec3(0.0f,  0.0f, -1.0f));
+				pointLightViews[4] = glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f));
+				pointLightViews[5] = glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f));
+
+				//Calculate and store the point light projection-view matrices
+				for (GLuint i = 0; i < 6; i++)
+				{
+					pointLightProjectionViews[i] = pointLightProjection * pointLightViews[i];
+				}
+			});
+
+			//Calculate the camera matrices
+			KJK::TaskGraph::TaskHandle prepareMainViewTask = frameGraph.AddTask("PrepareMainView", [&]()
+			{
+				//Define a view matrix
+				view = gCamera->GetViewMatrix();
+
+				//Define a projection matrix
+				projection = glm::perspective(glm::radians(gCamera->fov), (float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 100.0f);
+			});
+
+			//Render the directional light shadow map
+			KJK::TaskGraph::TaskHandle shadowPassTask = frameGraph.AddTask("ShadowPass", [&]()
+			{
+				KJK_PROFILE_GPU("ShadowPass");
+
+				//Resize the viewport to the shadow map size
+				glViewport(0, 0, SHADOW_WIDTH, SHADOW_HEIGHT);
+				//Bind the shadow map framebuffer
+				KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gShadowMapFBO);
+
+				//Enable depth testing
+				KJK::GLStateCache::Enable(GL_DEPTH_TEST);
+				KJK::GLStateCache::DepthFunc(GL_LESS);
+				KJK::GLStateCache::DepthMask(true);
+
+				//Clear the depth buffer
+				glClear(GL_DEPTH_BUFFER_BIT);
 
 				//Change to a simple depth shader
 				changeShader(11);
 
 				//Set the light space matrix uniform
-				gLightSpaceMatrix = lightProjection * lightView;
-				(*gShaders)[gCurrentShaderIndex].SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
+				(*gShaders[gCurrentShaderIndex]).SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
 
 				//Update the view and projection matrices in the UBO
 				glBindBuffer(GL_UNIFORM_BUFFER, gMatricesUBO);
 				glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(lightProjection));
 				glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(lightView));
 				glBindBuffer(GL_UNIFORM_BUFFER, 0);
+				KJK_STAT_ADD("Buffer uploads", 2);
+				KJK_STAT_ADD("Upload bytes", 2 * sizeof(glm::mat4));
 
 				//Render the scene to the shadow map
 				switch (currentScene)
 				{
 				case 0:
-					renderSpaceScene(timeValue, lightView, lightProjection, 1);
+					renderSpaceScene(renderTimeValue, lightView, lightProjection, 1);
 					break;
 				case 1:
 					//Enable front face culling to reduce shadow acne
-					glEnable(GL_CULL_FACE);
-					glCullFace(GL_FRONT);
+					KJK::GLStateCache::Enable(GL_CULL_FACE);
+					KJK::GLStateCache::CullFace(GL_FRONT);
 
-					renderExampleScene(timeValue, showNormals, outlineEffectEnabled, lightView, lightProjection, 1);
+					renderExampleScene(renderTimeValue, showNormals, outlineEffectEnabled, lightView, lightProjection, 1);
 					break;
 				default:
-					renderExampleScene(timeValue, showNormals, outlineEffectEnabled, lightView, lightProjection, 1);
+					renderExampleScene(renderTimeValue, showNormals, outlineEffectEnabled, lightView, lightProjection, 1);
 					break;
 				}
+			}, KJK::TaskAffinity::MainThread);
+
+			//Render the point light shadow map
+			KJK::TaskGraph::TaskHandle pointShadowPassTask = frameGraph.AddTask("PointShadowPass", [&]()
+			{
+				KJK_PROFILE_GPU("PointShadowPass");
 
 				//Bind the point light shadow map framebuffer
-				glBindFramebuffer(GL_FRAMEBUFFER, gPointLightShadowMapFBO);
+				KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gPointLightShadowMapFBO);
 
 				//Disable face culling
-				glDisable(GL_CULL_FACE);
+				KJK::GLStateCache::Disable(GL_CULL_FACE);
 
 				//Clear the depth buffer
 				glClear(GL_DEPTH_BUFFER_BIT);
 
-				//Define a point light projection matrix
-				glm::mat4 pointLightProjection = glm::perspective(glm::radians(90.0f), (float)SHADOW_WIDTH / (float)SHADOW_HEIGHT, 0.1f, gPointLightShadowFarPlane);
-				//Define the point light view matrices for each cube map face
-				std::vector<glm::mat4> pointLightViews;
-				pointLightViews.push_back(glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3( 1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
-				pointLightViews.push_back(glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3(-1.0f,  0.0f,  0.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
-				pointLightViews.push_back(glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3 (0.0f,  1.0f,  0.0f), glm::vec3(0.0f,  0.0f,  1.0f)));
-				pointLightViews.push_back(glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3( 0.0f, -1.0f,  0.0f), glm::vec3(0.0f,  0.0f, -1.0f)));
-				pointLightViews.push_back(glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3( 0.0f,  0.0f,  1.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
-				pointLightViews.push_back(glm::lookAt(gPointLights[0].position, gPointLights[0].position + glm::vec3( 0.0f,  0.0f, -1.0f), glm::vec3(0.0f, -1.0f,  0.0f)));
-
 				//Update the projection matrix in the UBO
 				glBindBuffer(GL_UNIFORM_BUFFER, gMatricesUBO);
 				glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(pointLightProjection));
 				glBindBuffer(GL_UNIFORM_BUFFER, 0);
-
-				//Calculate and store the point light projection-view matrices
-				std::vector<glm::mat4> pointLightProjectionViews;
-				for (GLuint i = 0; i < 6; i++)
-				{
-					pointLightProjectionViews.push_back(pointLightProjection * pointLightViews[i]);
-				}
+				KJK_STAT_ADD("Buffer uploads", 1);
+				KJK_STAT_ADD("Upload bytes", sizeof(glm::mat4));
 
 				//Set uniforms for all point light shadow shaders
 				for(int i : {16, 17, 18, 19})
 				{
+					KJK_PROFILE_SCOPE("PointShadowPass::SetUniforms");
+
 					//Set the point light projection matrix uniform
 					changeShader(i);
 
 					//Set the far plane and light position uniforms
-					(*gShaders)[gCurrentShaderIndex].SetFloat("far_plane", gPointLightShadowFarPlane);
-					(*gShaders)[gCurrentShaderIndex].SetVec3("lightPos", gPointLights[0].position);
+					(*gShaders[gCurrentShaderIndex]).SetFloat("far_plane", gPointLightShadowFarPlane);
+					(*gShaders[gCurrentShaderIndex]).SetVec3("lightPos", gPointLights[0].position);
 
 					//Set the point light projection-view matrices uniforms
 					for (GLuint j = 0; j < 6; j++)
 					{
-						std::string uniformName = "shadowMatrices[" + std::to_string(j) + "]";
-						(*gShaders)[gCurrentShaderIndex].SetMat4(uniformName, pointLightProjectionViews[j]);
+						KJK::FrameString uniformName("shadowMatrices[");
+						uniformName += std::to_string(j);
+						uniformName += ']';
+						(*gShaders[gCurrentShaderIndex]).SetMat4(uniformName.c_str(), pointLightProjectionViews[j]);
 					}
 
 					//For the exploding point shader, set the views uniform
@@ -491,8 +702,10 @@ int main(int argc, char* args[])
 					{
 						for (GLuint j = 0; j < 6; j++)
 						{
-							std::string uniformName = "views[" + std::to_string(j) + "]";
-							(*gShaders)[gCurrentShaderIndex].SetMat4(uniformName, pointLightViews[j]);
+							KJK::FrameString uniformName("views[");
+							uniformName += std::to_string(j);
+							uniformName += ']';
+							(*gShaders[gCurrentShaderIndex]).SetMat4(uniformName.c_str(), pointLightViews[j]);
 						}
 					}
 				}
@@ -504,23 +717,29 @@ int main(int argc, char* args[])
 				switch (currentScene)
 				{
 					case 0:
-						renderSpaceScene(timeValue, pointLightViews[0], pointLightProjection, 2);
+						renderSpaceScene(renderTimeValue, pointLightViews[0], pointLightProjection, 2);
 						break;
 					case 1:
-						renderExampleScene(timeValue, showNormals, outlineEffectEnabled, pointLightViews[0], pointLightProjection, 2);
+						renderExampleScene(renderTimeValue, showNormals, outlineEffectEnabled, pointLightViews[0], pointLightProjection, 2);
 						break;
 					default:
-						renderExampleScene(timeValue, showNormals, outlineEffectEnabled, pointLightViews[0], pointLightProjection, 2);
+						renderExampleScene(renderTimeValue, showNormals, outlineEffectEnabled, pointLightViews[0], pointLightProjection, 2);
 						break;
 				}
 
 				//Enable back face culling
-				glCullFace(GL_BACK);
+				KJK::GLStateCache::CullFace(GL_BACK);
+			}, KJK::TaskAffinity::MainThread);
+
+			//Render the scene
+			KJK::TaskGraph::TaskHandle mainPassTask = frameGraph.AddTask("MainPass", [&]()
+			{
+				KJK_PROFILE_GPU("MainPass");
 
 				//Change the viewport to the screen size
 				glViewport(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 				//Use the created framebuffer
-				glBindFramebuffer(GL_FRAMEBUFFER, gMultisampleFBO);
+				KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gMultisampleFBO);
 
 				//Set the clear color
 				glClearColor(0.05f, 0.0f, 0.05f, 1.0f);
@@ -528,97 +747,231 @@ int main(int argc, char* args[])
 				glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
 				//Enable depth testing
-				glEnable(GL_DEPTH_TEST);
+				KJK::GLStateCache::Enable(GL_DEPTH_TEST);
 
 				//Set to polygon wireframe mode
 				//glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-				//Calculate the time value
-				if (enableMovement)
-				{
-					timeValue += deltaTime;
-				}
-				
-				//Define a view matrix
-				glm::mat4 view = gCamera->GetViewMatrix();
-				
-				//Define a projection matrix
-				glm::mat4 projection = glm::mat4(1.0f);
-				projection = glm::perspective(glm::radians(gCamera->fov), (float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 100.0f);
-
 				//Update the view and projection matrices in the UBO
 				glBindBuffer(GL_UNIFORM_BUFFER, gMatricesUBO);
 				glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(projection));
 				glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
 				glBindBuffer(GL_UNIFORM_BUFFER, 0);
+				KJK_STAT_ADD("Buffer uploads", 2);
+				KJK_STAT_ADD("Upload bytes", 2 * sizeof(glm::mat4));
 
 				//Check scene number and render the correct scene
 				switch (currentScene)
 				{
 				case 0:
-					renderSpaceScene(timeValue, view, projection);
+					renderSpaceScene(renderTimeValue, view, projection);
 					break;
 				case 1:
-					renderExampleScene(timeValue, showNormals, outlineEffectEnabled, view, projection);
+					renderExampleScene(renderTimeValue, showNormals, outlineEffectEnabled, view, projection);
 					break;
 				default:
-					renderExampleScene(timeValue, showNormals, outlineEffectEnabled, view, projection);
+					renderExampleScene(renderTimeValue, showNormals, outlineEffectEnabled, view, projection);
 					break;
 				}
+			}, KJK::TaskAffinity::MainThread);
 
+			//Resolve, post process and present the frame
+			KJK::TaskGraph::TaskHandle postProcessTask = frameGraph.AddTask("PostProcess", [&]()
+			{
 				//Blit the multisample framebuffer to the normal framebuffer
-				glBindFramebuffer(GL_READ_FRAMEBUFFER, gMultisampleFBO);
-				glBindFramebuffer(GL_DRAW_FRAMEBUFFER, gFBO);
-				glBlitFramebuffer(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, GL_COLOR_BUFFER_BIT, GL_NEAREST);
-
-				//Bind the default framebuffer to render to the screen
-				glBindFramebuffer(GL_FRAMEBUFFER, 0);
-				//Clear the screen
-				glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-				glClear(GL_COLOR_BUFFER_BIT);
-
-				//Choose the shader for rendering the screen quad
-				if(showDepthMap)
 				{
-					//Use the depth map shader
-					changeShader(12);
+					KJK_PROFILE_GPU("Resolve");
+					KJK::GLStateCache::BindFramebuffer(GL_READ_FRAMEBUFFER, gMultisampleFBO);
+					KJK::GLStateCache::BindFramebuffer(GL_DRAW_FRAMEBUFFER, gFBO);
+					glBlitFramebuffer(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 				}
-				else if (applyPostProcessing)
+
+				//Draw the post processed frame to the screen
 				{
-					//Use the post processing shader
-					changeShader(0);
+					KJK_PROFILE_GPU("PostProcess");
+
+					//Bind the present framebuffer to render to the screen
+					KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gPresentFBO);
+					//Clear the screen
+					glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+					glClear(GL_COLOR_BUFFER_BIT);
+
+					//Choose the shader for rendering the screen quad
+					if(showDepthMap)
+					{
+						//Use the depth map shader
+						changeShader(12);
+					}
+					else if (applyPostProcessing)
+					{
+						//Use the post processing shader
+						changeShader(0);
+					}
+					else
+					{
+						//Use the simple texture shader
+						changeShader(2);
+					}
+
+					//Bind the screen quad VAO
+					KJK::GLStateCache::BindVertexArray(gScreenQuadVAO);
+
+					//Disable depth testing
+					KJK::GLStateCache::Disable(GL_DEPTH_TEST);
+
+					//Bind the appropriate texture for the screen quad
+					if(showDepthMap)
+					{
+						//Bind the shadow map texture
+						KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, gShadowMapTexture);
+					}
+					else
+					{
+						//Bind the framebuffer texture
+						KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, gFBOTexture);
+					}
+
+					//Draw the screen quad
+					glDrawArrays(GL_TRIANGLES, 0, 6);
+					KJK_STAT_ADD("Draw calls", 1);
+					KJK_STAT_ADD("Triangles", 2);
+					KJK_STAT_ADD("Texture binds", 1);
+
+					//Draw the stats overlay on top of the frame
+					if (showStats && KJK::ImGuiRenderer::IsInitialized())
+					{
+						KJK::ImGuiRenderer::BeginFrame();
+						KJK::StatsOverlay::Draw();
+						KJK::ImGuiRenderer::EndFrame();
+					}
 				}
-				else
+
+				//Update screen
 				{
-					//Use the simple texture shader
-					changeShader(2);
+					KJK_PROFILE_SCOPE("PostProcess::SwapWindow");
+#ifdef KJK_PLAYGROUND_HEADLESS
+					//Without a window to present to, wait for the GPU so the frame time covers the rendering
+					benchmarkCpuMs = static_cast<float>((KJK::Clock::GetTimeNs() - benchmarkFrameStartNs) * 1e-6);
+					glFinish();
+#else
+					gWindow->SwapBuffers();
+#endif
 				}
+			}, KJK::TaskAffinity::MainThread);
+
+			//Declare the dependencies between the stages
+			frameGraph.AddDependency(simulationTask, inputTask);
+			frameGraph.AddDependency(prepareShadowTask, inputTask);
+			frameGraph.AddDependency(prepareMainViewTask, inputTask);
+			frameGraph.AddDependency(shadowPassTask, simulationTask);
+			frameGraph.AddDependency(shadowPassTask, prepareShadowTask);
+			frameGraph.AddDependency(pointShadowPassTask, preparePointShadowTask);
+			frameGraph.AddDependency(pointShadowPassTask, shadowPassTask);
+			frameGraph.AddDependency(mainPassTask, prepareMainViewTask);
+			frameGraph.AddDependency(mainPassTask, pointShadowPassTask);
+			frameGraph.AddDependency(postProcessTask, mainPassTask);
+			frameGraph.Compile();
 
-				//Bind the screen quad VAO
-				glBindVertexArray(gScreenQuadVAO);
-
-				//Disable depth testing
-				glDisable(GL_DEPTH_TEST);
-
-				//Bind the appropriate texture for the screen quad
-				glActiveTexture(GL_TEXTURE0);
-				if(showDepthMap)
+			//While application is running
+			while (!quit)
+			{
+				//Calculate delta time
+				deltaTime = frameTimer.BeginFrame();
+
+				//Start or finish the requested profiler captures
+				KJK::Profiler::BeginFrame();
+				KJK::GpuProfiler::BeginFrame();
+				KJK_PROFILE_SCOPE("Frame");
+#ifdef KJK_PLAYGROUND_HEADLESS
+				benchmarkFrameStartNs = KJK::Clock::GetTimeNs();
+				collectGpuResults();
+#endif
+				KJK_STAT_SET("Frame ms", deltaTime * 1000.0);
+
+				//Release the frame memory used two frames ago
+				KJK::FrameAllocator::NextFrame();
+
+				//Swap in the assets reloaded since the last frame
+				if (gAssetReloader != nullptr)
+					gAssetReloader->Update();
+
+				//Run all stages of the frame
+				frameGraph.Execute();
+
+				//Log the per stage timings if requested
+				if (logFrameGraph)
 				{
-					//Bind the shadow map texture
-					glBindTexture(GL_TEXTURE_2D, gShadowMapTexture);
+					logFrameGraph = false;
+					for (const KJK::TaskTiming& timing : frameGraph.GetTimings())
+					{
+						KJK_INFO("{0}: start {1:.3f} ms, duration {2:.3f} ms, thread {3}", timing.Name, timing.StartMs, timing.DurationMs, timing.ThreadIndex);
+					}
+					KJK_INFO("Frame graph total: {0:.3f} ms", frameGraph.GetTotalMs());
+					for (const KJK::GpuPassTiming& timing : KJK::GpuProfiler::GetResults())
+					{
+						KJK_INFO("{0:>{1}}{2}: GPU {3:.3f} ms, CPU {4:.3f} ms", "", timing.Depth * 2, timing.Name, timing.GpuMs, timing.CpuMs);
+					}
+					KJK_INFO("GPU pass timings of frame {0}, {1} frames dropped", KJK::GpuProfiler::GetResultFrameIndex(), KJK::GpuProfiler::GetDroppedFrameCount());
+					KJK_INFO("Frame memory: {0} bytes used, {1} bytes high water mark", KJK::FrameAllocator::GetUsed(), KJK::FrameAllocator::GetHighWaterMark());
 				}
-				else
+
+				//Record the frame timings
 				{
-					//Bind the framebuffer texture
-					glBindTexture(GL_TEXTURE_2D, gFBOTexture);
+					KJK_PROFILE_SCOPE("WaitForFrame");
+					frameTimer.EndFrame();
 				}
 
-				//Draw the screen quad
-				glDrawArrays(GL_TRIANGLES, 0, 6);
+				//Record the frame stats
+				KJK_STAT_SET("Work ms", frameTimer.GetHistory().Get(0).WorkMs);
+				const KJK::GLStateCacheStats& stateCacheStats = KJK::GLStateCache::GetStats();
+				KJK_STAT_ADD("GL state calls", stateCacheStats.Issued - lastStateCacheStats.Issued);
+				KJK_STAT_ADD("GL state calls filtered", stateCacheStats.Filtered - lastStateCacheStats.Filtered);
+				lastStateCacheStats = stateCacheStats;
+				KJK::Stats::EndFrame();
 
-				//Update screen
-				SDL_GL_SwapWindow(gWindow);
+#ifdef KJK_PLAYGROUND_HEADLESS
+				//Record the measured frames and move on to the next scene once all of them ran
+				if (benchmarkFrame >= gBenchmarkSettings.warmupFrames)
+					benchmarkReport.AddFrame(frameTimer.GetHistory().Get(0).WorkMs, benchmarkCpuMs, KJK::GpuProfiler::GetFrameIndex());
+
+				if (++benchmarkFrame == gBenchmarkSettings.warmupFrames + gBenchmarkSettings.frames)
+				{
+					benchmarkFrame = 0;
+					if (++benchmarkSceneIndex == benchmarkScenes.size())
+					{
+						quit = true;
+					}
+					else
+					{
+						currentScene = benchmarkScenes[benchmarkSceneIndex].first;
+						timeValue = 0.0f;
+						benchmarkReport.BeginScene(benchmarkScenes[benchmarkSceneIndex].second);
+					}
+				}
+#endif
 			}
+
+#ifdef KJK_PLAYGROUND_HEADLESS
+			//Resolve the queries of the last frame, which already finished on the GPU
+			KJK::GpuProfiler::BeginFrame();
+			collectGpuResults();
+
+			//Print the report for the build machine and keep a copy if requested
+			gBenchmarkSettings.renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+			gBenchmarkSettings.version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+			std::string report = benchmarkReport.ToJson(gBenchmarkSettings);
+			std::fwrite(report.data(), 1, report.size(), stdout);
+			if (!gBenchmarkSettings.outputPath.empty())
+			{
+				std::ofstream reportFile(gBenchmarkSettings.outputPath, std::ios::trunc);
+				reportFile << report;
+				if (!reportFile)
+				{
+					KJK_ERROR("Failed to write the benchmark report to {0}!", gBenchmarkSettings.outputPath);
+					exitCode = 3;
+				}
+			}
+#endif
 		}
 	}
 
@@ -631,7 +984,18 @@ int main(int argc, char* args[])
 //Initializes the logging system
 static void initLogger()
 {
-	KJK::Logger::Init();
+	//Log asynchronously so console and file output never stalls the render thread
+	KJK::LoggerSettings settings;
+	settings.Async = true;
+	settings.OverflowPolicy = KJK::LogOverflowPolicy::DropOldest;
+#ifdef KJK_PLAYGROUND_HEADLESS
+	//The standard output only carries the benchmark report
+	settings.ConsoleOutput = false;
+	settings.FilePath = "PlaygroundBenchmark.log";
+#else
+	settings.FilePath = "Playground.log";
+#endif
+	KJK::Logger::Init(settings);
 	KJK_INFO("Started the Playground!");
 }
 
@@ -644,69 +1008,60 @@ bool init()
 	//Initialize the logging system
 	initLogger();
 
-	//Initialize SDL
-	if (SDL_Init(SDL_INIT_VIDEO) == NULL)
+	//Open the binary trace file, recording starts when toggled with B
+	KJK::BinaryTrace::Init("Playground.ktrace");
+	KJK::BinaryTrace::SetEnabled(false);
+
+	//Start the job system worker threads
+	KJK::JobSystem::Init();
+
+	//Allocate the per frame memory arenas
+	KJK::FrameAllocator::Init();
+
+#ifdef KJK_PLAYGROUND_HEADLESS
+	//Render offscreen without SDL video, no window or display server is needed
+	if (!createHeadlessContext())
 	{
-		KJK_ERROR("Failed to initialize SDL: {0}", SDL_GetError());
+		KJK_ERROR("Failed to create a headless OpenGL context!");
 		success = false;
 	}
 	else
 	{
-		KJK_INFO("Initialized SDL!");
-
-		//Use OpenGL 4.5 core
-		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 4);
-		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 5);
-		SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
-		SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 8);
-		SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
-		SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 4);
-
-		//Create a window
-		gWindow = SDL_CreateWindow("LearnOpenGL", SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE);
-		if (gWindow == NULL)
+		//Initialize the camera, it stays in place for the whole run
+		gCamera = new Camera(glm::vec3(0.0f, 0.0f, 3.0f));
+
+		if (!initGL())
 		{
-			KJK_ERROR("Failed to create window: {0}", SDL_GetError());
+			KJK_ERROR("Failed to initialize OpenGL!");
 			success = false;
 		}
-		else
-		{
-			KJK_INFO("Created an SDL window!");
-
-			//Create context
-			gContext = SDL_GL_CreateContext(gWindow);
-			if (gContext == NULL)
-			{
-				KJK_ERROR("Failed to create OpenGL context: {0}", SDL_GetError());
-				success = false;
-			}
-			else
-			{
-				KJK_INFO("Created an SDL context!");
+	}
+#else
+	//Create a window with an OpenGL 4.5 core context, paced by the display through adaptive vsync
+	//Late frames are shown right away instead of waiting for the next refresh, drivers without adaptive sync fall back to vsync
+	gWindow = new KJK::SDLWindow(KJK::WindowProps("LearnOpenGL", SCREEN_WIDTH, SCREEN_HEIGHT, KJK::VSyncMode::Adaptive));
+	if (!gWindow->IsValid())
+	{
+		KJK_ERROR("Failed to create the window!");
+		success = false;
+	}
+	else
+	{
+		KJK_INFO("Created the window!");
 
-				//Set the mouse mode to relative
-				SDL_SetWindowRelativeMouseMode(gWindow, true);
+		//Set the mouse mode to relative
+		SDL_SetWindowRelativeMouseMode(gWindow->GetSDLWindow(), true);
 
-				//Initialize the camera
-				gCamera = new Camera(glm::vec3(0.0f, 0.0f, 3.0f));
+		//Initialize the camera
+		gCamera = new Camera(glm::vec3(0.0f, 0.0f, 3.0f));
 
-				//Load OpenGL functions using GLAD
-				if(!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress))
-				{
-					KJK_ERROR("Failed to initialize GLAD! SDL error: {0}", SDL_GetError());
-					success = false;
-				}
-				else
-				{
-					if(!initGL())
-					{
-						KJK_ERROR("Failed to initialize OpenGL!");
-						success = false;
-					}
-				}
-			}
+		if (!initGL())
+		{
+			KJK_ERROR("Failed to initialize OpenGL!");
+			success = false;
 		}
 	}
+#endif
 
 	return success;
 }
@@ -720,41 +1075,79 @@ bool initGL()
 	//Define the viewport dimensions
 	glViewport(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 
+	//Track the OpenGL state from here on, so setting state that is already set is skipped
+	KJK::GLStateCache::Init();
+
 	//Enable depth testing
-	glEnable(GL_DEPTH_TEST);
-	glDepthFunc(GL_LESS);
+	KJK::GLStateCache::Enable(GL_DEPTH_TEST);
+	KJK::GLStateCache::DepthFunc(GL_LESS);
 
 	//Enable stencil testing
-	glEnable(GL_STENCIL_TEST);
-	glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
-	glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+	KJK::GLStateCache::Enable(GL_STENCIL_TEST);
+	KJK::GLStateCache::StencilFunc(GL_NOTEQUAL, 1, 0xFF);
+	KJK::GLStateCache::StencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
 
 	//Enable blending
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glBlendEquation(GL_FUNC_ADD);
+	KJK::GLStateCache::Enable(GL_BLEND);
+	KJK::GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	KJK::GLStateCache::BlendEquation(GL_FUNC_ADD);
 
 	//Enable face culling
-	glEnable(GL_CULL_FACE);
-	glCullFace(GL_BACK);
-	glFrontFace(GL_CCW);
+	KJK::GLStateCache::Enable(GL_CULL_FACE);
+	KJK::GLStateCache::CullFace(GL_BACK);
+	KJK::GLStateCache::FrontFace(GL_CCW);
 
 	//Enable multisampling
-	glEnable(GL_MULTISAMPLE);
+	KJK::GLStateCache::Enable(GL_MULTISAMPLE);
+
+	//Create the timer queries for measuring the render passes
+	KJK::GpuProfiler::Init();
+
+	//Load linked shader programs from earlier runs instead of compiling them again
+	KJK::ProgramCache::Init("cache/programs");
+
+	//Let the driver compile the shaders on its own threads
+#ifdef KJK_PLAYGROUND_HEADLESS
+	Shader::EnableParallelCompile(getHeadlessProcAddress);
+#else
+	Shader::EnableParallelCompile((GLADloadproc)SDL_GL_GetProcAddress);
+#endif
+
+#ifdef KJK_PLAYGROUND_HEADLESS
+	//Without a window the post processed frame goes to an offscreen color buffer instead of the default framebuffer
+	glGenFramebuffers(1, &gPresentFBO);
+	KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gPresentFBO);
+	glGenRenderbuffers(1, &gPresentRBO);
+	glBindRenderbuffer(GL_RENDERBUFFER, gPresentRBO);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, SCREEN_WIDTH, SCREEN_HEIGHT);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, gPresentRBO);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		KJK_ERROR("Present framebuffer is not complete!");
+		success = false;
+	}
+	KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, 0);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Renderbuffer, gPresentRBO, KJK::MemoryCategory::Framebuffers,
+		KJK::MemoryTracker::EstimateTextureSize(SCREEN_WIDTH, SCREEN_HEIGHT, 4, false));
+#else
+	//Set up ImGui for the stats overlay
+	KJK::ImGuiRenderer::Init(gWindow->GetSDLWindow(), gWindow->GetGLContext());
+#endif
 
 	//Generate a framebuffer object
 	glGenFramebuffers(1, &gFBO);
 	//Bind the framebuffer object
-	glBindFramebuffer(GL_FRAMEBUFFER, gFBO);
+	KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gFBO);
 
 	//Create a texture to serve as the framebuffer color attachment
 	glGenTextures(1, &gFBOTexture);
-	glBindTexture(GL_TEXTURE_2D, gFBOTexture);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, gFBOTexture);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCREEN_WIDTH, SCREEN_HEIGHT, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	//Unbind the texture
-	glBindTexture(GL_TEXTURE_2D, 0);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, 0);
 	//Attach the texture to the framebuffer
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gFBOTexture, 0);
 
@@ -778,16 +1171,16 @@ bool initGL()
 	//Generate a multisample framebuffer object
 	glGenFramebuffers(1, &gMultisampleFBO);
 	//Bind the multisample framebuffer object
-	glBindFramebuffer(GL_FRAMEBUFFER, gMultisampleFBO);
+	KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gMultisampleFBO);
 
 	//Create a multisample texture to serve as the framebuffer color attachment
 	glGenTextures(1, &gMultisampleFBOTexture);
-	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, gMultisampleFBOTexture);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D_MULTISAMPLE, gMultisampleFBOTexture);
 	glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, 4, GL_RGB, SCREEN_WIDTH, SCREEN_HEIGHT, GL_TRUE);
 	glTexParameterf(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameterf(GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	//Unbind the multisample texture
-	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D_MULTISAMPLE, 0);
 	//Attach the texture to the multisample framebuffer
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D_MULTISAMPLE, gMultisampleFBOTexture, 0);
 
@@ -811,11 +1204,11 @@ bool initGL()
 	//Generate the shadow map framebuffer
 	glGenFramebuffers(1, &gShadowMapFBO);
 	//Bind the shadow map framebuffer
-	glBindFramebuffer(GL_FRAMEBUFFER, gShadowMapFBO);
+	KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gShadowMapFBO);
 
 	//Create the shadow map texture
 	glGenTextures(1, &gShadowMapTexture);
-	glBindTexture(GL_TEXTURE_2D, gShadowMapTexture);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, gShadowMapTexture);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -841,11 +1234,11 @@ bool initGL()
 	//Create the point light shadow map framebuffer
 	glGenFramebuffers(1, &gPointLightShadowMapFBO);
 	//Bind the point light shadow map framebuffer
-	glBindFramebuffer(GL_FRAMEBUFFER, gPointLightShadowMapFBO);
+	KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, gPointLightShadowMapFBO);
 
 	//Create the point light shadow map cube map texture
 	glGenTextures(1, &gPointLightShadowMapCubeTexture);
-	glBindTexture(GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
 	for (GLuint i = 0; i < 6; ++i)
 	{
 		glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_DEPTH_COMPONENT, SHADOW_WIDTH, SHADOW_HEIGHT, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
@@ -871,12 +1264,14 @@ bool initGL()
 	}
 
 	//Unbind the shadow map framebuffer
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, 0);
+	trackFramebufferMemory();
 
 	//Generate the UBO for matrices
 	glGenBuffers(1, &gMatricesUBO);
 	glBindBuffer(GL_UNIFORM_BUFFER, gMatricesUBO);
 	glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), NULL, GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, gMatricesUBO, KJK::MemoryCategory::Buffers, 2 * sizeof(glm::mat4));
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
 	//Bind the UBO to binding point 0
 	glBindBufferRange(GL_UNIFORM_BUFFER, 0, gMatricesUBO, 0, 2 * sizeof(glm::mat4));
@@ -884,7 +1279,7 @@ bool initGL()
 	//Setup the screen quad VAO and VBO
 	glGenVertexArrays(1, &gScreenQuadVAO);
 	glGenBuffers(1, &gScreenQuadVBO);
-	glBindVertexArray(gScreenQuadVAO);
+	KJK::GLStateCache::BindVertexArray(gScreenQuadVAO);
 	glBindBuffer(GL_ARRAY_BUFFER, gScreenQuadVBO);
 	float screenQuadVertices[] = {
 		//Positions   //TexCoords
@@ -896,11 +1291,12 @@ bool initGL()
 		 1.0f,  1.0f, 1.0f, 1.0f
 	};
 	glBufferData(GL_ARRAY_BUFFER, sizeof(screenQuadVertices), &screenQuadVertices, GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, gScreenQuadVBO, KJK::MemoryCategory::Buffers, sizeof(screenQuadVertices));
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
 	glEnableVertexAttribArray(1);
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-	glBindVertexArray(0);
+	KJK::GLStateCache::BindVertexArray(0);
 
 	//Define the directional light properties
 	gDirectionalLight.position = glm::vec3(-20.0f, 40.0f, -10.0f);
@@ -931,30 +1327,42 @@ bool loadMedia()
 	//Loading success flag
 	bool success = true;
 
-	//Create the shaders
-	gShaders.emplace(std::array<Shader, 20>
+	//Submit the shaders, the driver compiles them while the models load and they're checked when first used
+	//Instancing and alpha testing are permutations of the same files, selected by defines
+	//Submitting and finishing are timed to compare cold starts with warm starts from the program cache
+	uint64_t shaderLoadStartNs = KJK::Clock::GetTimeNs();
+	gShaderVariants = new ShaderVariantCache(ShaderBuildMode::Deferred);
+	const ShaderDefines instanced{ { "INSTANCED", "" } };
+	const ShaderDefines alphaTest{ { "ALPHA_TEST", "" } };
+	gShaders =
 	{
-		Shader("assets/shaders/FrameBufferShader.vert", "assets/shaders/FrameBufferShader.frag"),
-		Shader("assets/shaders/shader.vert", "assets/shaders/shader2.frag"),
-		Shader("assets/shaders/FrameBufferShader.vert", "assets/shaders/BasicShader.frag"),
-		Shader("assets/shaders/shader.vert", "assets/shaders/DistanceShader.frag"),
-		Shader("assets/shaders/shader.vert", "assets/shaders/BorderShader.frag"),
-		Shader("assets/shaders/Cubemap.vert", "assets/shaders/Cubemap.frag"),
-		Shader("assets/shaders/shader.vert", "assets/shaders/ReflectiveShader.frag"),
-		Shader("assets/shaders/shader.vert", "assets/shaders/RefractiveShader.frag"),
-		Shader("assets/shaders/shaderExplode.vert", "assets/shaders/explode.geom", "assets/shaders/shader2.frag"),
-		Shader("assets/shaders/NormalVectorShader.vert", "assets/shaders/NormalVectorShader.geom", "assets/shaders/NormalVectorShader.frag"),
-		Shader("assets/shaders/InstanceShader.vert", "assets/shaders/InstanceShader.frag"),
-		Shader("assets/shaders/simpleDepthShader.vert", "assets/shaders/simpleDepthShader.frag"),
-		Shader("assets/shaders/FrameBufferShader.vert", "assets/shaders/DepthMapShader.frag"),
-		Shader("assets/shaders/instancedDepthShader.vert", "assets/shaders/simpleDepthShader.frag"),
-		Shader("assets/shaders/simpleDepthShader.vert", "assets/shaders/transparentDepthShader.frag"),
-		Shader("assets/shaders/explodingDepthShader.vert", "assets/shaders/explodingDepthShader.geom", "assets/shaders/simpleDepthShader.frag"),
-		Shader("assets/shaders/simplePointDepthShader.vert", "assets/shaders/simplePointDepthShader.geom", "assets/shaders/simplePointDepthShader.frag"),
-		Shader("assets/shaders/simplePointDepthShader.vert", "assets/shaders/simplePointDepthShader.geom", "assets/shaders/transparentPointDepthShader.frag"),
-		Shader("assets/shaders/explodingPointDepthShader.vert", "assets/shaders/explodingPointDepthShader.geom", "assets/shaders/simplePointDepthShader.frag"),
-		Shader("assets/shaders/instancedPointDepthShader.vert", "assets/shaders/simplePointDepthShader.geom", "assets/shaders/simpleDepthShader.frag"),
-	});
+		&gShaderVariants->Get("assets/shaders/FrameBufferShader.vert", "assets/shaders/FrameBufferShader.frag"),
+		&gShaderVariants->Get("assets/shaders/shader.vert", "assets/shaders/shader2.frag"),
+		&gShaderVariants->Get("assets/shaders/FrameBufferShader.vert", "assets/shaders/BasicShader.frag"),
+		&gShaderVariants->Get("assets/shaders/shader.vert", "assets/shaders/DistanceShader.frag"),
+		&gShaderVariants->Get("assets/shaders/shader.vert", "assets/shaders/BorderShader.frag"),
+		&gShaderVariants->Get("assets/shaders/Cubemap.vert", "assets/shaders/Cubemap.frag"),
+		&gShaderVariants->Get("assets/shaders/shader.vert", "assets/shaders/ReflectiveShader.frag"),
+		&gShaderVariants->Get("assets/shaders/shader.vert", "assets/shaders/RefractiveShader.frag"),
+		&gShaderVariants->Get("assets/shaders/shaderExplode.vert", "assets/shaders/explode.geom", "assets/shaders/shader2.frag"),
+		&gShaderVariants->Get("assets/shaders/NormalVectorShader.vert", "assets/shaders/NormalVectorShader.geom", "assets/shaders/NormalVectorShader.frag"),
+		&gShaderVariants->Get("assets/shaders/shader.vert", "assets/shaders/InstanceShader.frag", instanced),
+		&gShaderVariants->Get("assets/shaders/simpleDepthShader.vert", "assets/shaders/simpleDepthShader.frag"),
+		&gShaderVariants->Get("assets/shaders/FrameBufferShader.vert", "assets/shaders/DepthMapShader.frag"),
+		&gShaderVariants->Get("assets/shaders/simpleDepthShader.vert", "assets/shaders/simpleDepthShader.frag", instanced),
+		&gShaderVariants->Get("assets/shaders/simpleDepthShader.vert", "assets/shaders/simpleDepthShader.frag", alphaTest),
+		&gShaderVariants->Get("assets/shaders/explodingDepthShader.vert", "assets/shaders/explodingDepthShader.geom", "assets/shaders/simpleDepthShader.frag"),
+		&gShaderVariants->Get("assets/shaders/simplePointDepthShader.vert", "assets/shaders/simplePointDepthShader.geom", "assets/shaders/simplePointDepthShader.frag"),
+		&gShaderVariants->Get("assets/shaders/simplePointDepthShader.vert", "assets/shaders/simplePointDepthShader.geom", "assets/shaders/simplePointDepthShader.frag", alphaTest),
+		&gShaderVariants->Get("assets/shaders/explodingPointDepthShader.vert", "assets/shaders/explodingPointDepthShader.geom", "assets/shaders/simplePointDepthShader.frag"),
+		&gShaderVariants->Get("assets/shaders/simplePointDepthShader.vert", "assets/shaders/simplePointDepthShader.geom", "assets/shaders/simpleDepthShader.frag", instanced),
+	};
+	double shaderLoadMs = KJK::Clock::NsToSeconds(KJK::Clock::GetTimeNs() - shaderLoadStartNs) * 1000.0;
+
+	const KJK::ProgramCacheStats& programCacheStats = KJK::ProgramCache::GetStats();
+	const char* startType = programCacheStats.Hits == 0 ? "cold" : (programCacheStats.Misses + programCacheStats.Rejected == 0 ? "warm" : "partially warm");
+	KJK_INFO("Submitted {0} shader programs in {1:.2f} ms, {2} start: {3} from the program cache, {4} compiled, {5} cached binaries rejected",
+		gShaderVariants->GetVariants().size(), shaderLoadMs, startType, programCacheStats.Hits, programCacheStats.Misses + programCacheStats.Rejected, programCacheStats.Rejected);
 
 	//Load two cube models
 	gCubeModels = new CubeModel[2]
@@ -1052,38 +1460,46 @@ bool loadMedia()
 
 	//Create the array to store their positions
 	gAsteroidModelMatrices = new glm::mat4[gAsteroidInstanceAmount];
+#ifdef KJK_PLAYGROUND_HEADLESS
+	//Fixed seed so every benchmark run renders the same asteroid field
+	uint32_t seed = gBenchmarkSettings.asteroidSeed;
+#else
 	//Initialize a random seed
-	srand(SDL_GetTicks());
+	uint32_t seed = static_cast<uint32_t>(SDL_GetTicks());
+#endif
 	//Declare the model variables
 	float radius = 60.0f;
 	float offset = 10.0f;
 	
-	//Iterate over each instance to set their unique translations, scale and rotations
-	for (GLuint i = 0; i < gAsteroidInstanceAmount; i++)
+	//Iterate over each instance in parallel to set their unique translations, scale and rotations
+	KJK::JobSystem::ParallelFor(gAsteroidInstanceAmount, 256, [seed, radius, offset](uint32_t i)
 	{
+		//Seed a generator per instance so the result doesn't depend on the thread running it
+		std::minstd_rand generator(seed ^ (i * 2654435761u));
+
 		//Initialize the model matrix
 		glm::mat4 model = glm::mat4(1.0f);
 
 		//Calculate random displacement along a circle
 		float angle = (float)i / (float)gAsteroidInstanceAmount * 360.f;
-		float displacement = (rand() % (int)(2 * offset * 100)) / 100.0f - offset;
+		float displacement = (generator() % (int)(2 * offset * 100)) / 100.0f - offset;
 		float x = sin(angle) * radius + displacement;
-		displacement = (rand() % (int)(2 * offset * 100)) / 100.0f - offset;
+		displacement = (generator() % (int)(2 * offset * 100)) / 100.0f - offset;
 		float y = displacement * 0.4f;
-		displacement = (rand() % (int)(2 * offset * 100)) / 100.0f - offset;
+		displacement = (generator() % (int)(2 * offset * 100)) / 100.0f - offset;
 		float z = cos(angle) * radius + displacement;
 		//Apply translation
 		model = glm::translate(model, glm::vec3(x, y, z));
 
 		//Calculate a random scale
-		float scale = (rand() % 20) / 100.0f + 0.05f;
+		float scale = (generator() % 20) / 100.0f + 0.05f;
 		//Apply the scale
 		model = glm::scale(model, glm::vec3(scale));
 
 		//Calculate a random rotation
-		float rotX = (rand() % 360);
-		float rotY = (rand() % 360);
-		float rotZ = (rand() % 360);
+		float rotX = (generator() % 360);
+		float rotY = (generator() % 360);
+		float rotZ = (generator() % 360);
 		//Apply the rotation
 		model = glm::rotate(model, rotX, glm::vec3(1.0f, 0.0f, 0.0f));
 		model = glm::rotate(model, rotY, glm::vec3(0.0f, 1.0f, 0.0f));
@@ -1091,43 +1507,46 @@ bool loadMedia()
 
 		//Add to the list of matrices
 		gAsteroidModelMatrices[i] = model;
-	}
+	});
 
 	//Generate a vertex buffer object for the asteroid instance matrices
 	glGenBuffers(1, &gAsteroidInstanceVBO);
 	glBindBuffer(GL_ARRAY_BUFFER, gAsteroidInstanceVBO);
 	//Fill the buffer with the model matrices
 	glBufferData(GL_ARRAY_BUFFER, gAsteroidInstanceAmount * sizeof(glm::mat4), &gAsteroidModelMatrices[0], GL_STATIC_DRAW);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Buffer, gAsteroidInstanceVBO, KJK::MemoryCategory::Buffers, gAsteroidInstanceAmount * sizeof(glm::mat4));
 
-	//Configure the vertex attributes for each asteroid mesh
-	for (GLuint i = 0; i < gAsteroidModel->GetMeshes().size(); i++)
-	{
-		//Get a vertex array object id for the model mesh
-		GLuint vao = gAsteroidModel->GetMeshes()[i].GetVAO();
-		//Bind the vertex array
-		glBindVertexArray(vao);
-
-		//Update the vertex attributes with the information about the model matrices
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)0);
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(1 * sizeof(glm::vec4)));
-		glEnableVertexAttribArray(5);
-		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(2 * sizeof(glm::vec4)));
-		glEnableVertexAttribArray(6);
-		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(3 * sizeof(glm::vec4)));
+	//Add the instance matrices to the asteroid meshes
+	setupAsteroidInstancing();
 
-		//Tell OpenGl when to update the context of the vertex attribute
-		glVertexAttribDivisor(3, 1);
-		glVertexAttribDivisor(4, 1);
-		glVertexAttribDivisor(5, 1);
-		glVertexAttribDivisor(6, 1);
+	//Programs still compiling here make their first use wait for the driver
+	const auto& shaderVariants = gShaderVariants->GetVariants();
+	size_t readyShaders = std::count_if(shaderVariants.begin(), shaderVariants.end(), [](const auto& shader) { return shader->IsReady(); });
+	KJK_INFO("{0} of {1} shader programs finished compiling while loading the models", readyShaders, shaderVariants.size());
 
-		//Unbind the vertex array
-		glBindVertexArray(0);
+	//Wait for the rest here instead of at their first use, so the compile and link time is part of the shader load time
+	uint64_t shaderFinishStartNs = KJK::Clock::GetTimeNs();
+	for (const auto& shader : shaderVariants)
+	{
+		if (shader->IsPending())
+			shader->Finish();
 	}
+	double shaderFinishMs = KJK::Clock::NsToSeconds(KJK::Clock::GetTimeNs() - shaderFinishStartNs) * 1000.0;
+	KJK_INFO("Finished the shader programs in {0:.2f} ms, {1:.2f} ms of shader loading in total with {2:.2f} ms submitting, {3} start",
+		shaderFinishMs, shaderLoadMs + shaderFinishMs, shaderLoadMs, startType);
+
+	//Set the uniforms that don't change per frame
+	initializeShaderUniforms();
 
+	KJK_INFO("Loaded media!");
+
+	//Return the success flag
+	return success;
+}
 
+//Set the uniforms of the shader programs that don't change per frame
+void initializeShaderUniforms()
+{
 	//Iterate over the 1st and 8th shader programs
 	for (GLint i : {1, 8, 10})
 	{
@@ -1135,63 +1554,98 @@ bool loadMedia()
 		changeShader(i);
 
 		//Set the texture scale uniform
-		(*gShaders)[gCurrentShaderIndex].SetFloat("textureScale", 1.0f);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("textureScale", 1.0f);
 
 		//Set color uniforms for the spotlight
-		(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.ambient", glm::vec4(0.0f));
-		(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.diffuse", glm::vec4(0.0f));
-		(*gShaders)[gCurrentShaderIndex].SetVec4("spotLight.specular", glm::vec4(0.0f));
+		(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.ambient", glm::vec4(0.0f));
+		(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.diffuse", glm::vec4(0.0f));
+		(*gShaders[gCurrentShaderIndex]).SetVec4("spotLight.specular", glm::vec4(0.0f));
 		//Set spotlight cutoff angles
-		(*gShaders)[gCurrentShaderIndex].SetFloat("spotLight.cutOff", glm::cos(glm::radians(12.5f)));
-		(*gShaders)[gCurrentShaderIndex].SetFloat("spotLight.outerCutOff", glm::cos(glm::radians(20.0f)));
+		(*gShaders[gCurrentShaderIndex]).SetFloat("spotLight.cutOff", glm::cos(glm::radians(12.5f)));
+		(*gShaders[gCurrentShaderIndex]).SetFloat("spotLight.outerCutOff", glm::cos(glm::radians(20.0f)));
 		//Set spotlight attenuation factors
-		(*gShaders)[gCurrentShaderIndex].SetFloat("spotLight.constant", 1.0f);
-		(*gShaders)[gCurrentShaderIndex].SetFloat("spotLight.linear", 0.07f);
-		(*gShaders)[gCurrentShaderIndex].SetFloat("spotLight.quadratic", 0.017f);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("spotLight.constant", 1.0f);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("spotLight.linear", 0.07f);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("spotLight.quadratic", 0.017f);
 
 		//Set color uniforms for the directional light
-		(*gShaders)[gCurrentShaderIndex].SetVec3("dirLight.direction", glm::vec3(0.0f) - gDirectionalLight.position);
-		(*gShaders)[gCurrentShaderIndex].SetVec4("dirLight.ambient", gDirectionalLight.ambient);
-		(*gShaders)[gCurrentShaderIndex].SetVec4("dirLight.diffuse", gDirectionalLight.diffuse);
-		(*gShaders)[gCurrentShaderIndex].SetVec4("dirLight.specular", gDirectionalLight.specular);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("dirLight.direction", glm::vec3(0.0f) - gDirectionalLight.position);
+		(*gShaders[gCurrentShaderIndex]).SetVec4("dirLight.ambient", gDirectionalLight.ambient);
+		(*gShaders[gCurrentShaderIndex]).SetVec4("dirLight.diffuse", gDirectionalLight.diffuse);
+		(*gShaders[gCurrentShaderIndex]).SetVec4("dirLight.specular", gDirectionalLight.specular);
 
 		//Set color uniforms for the point light
-		(*gShaders)[gCurrentShaderIndex].SetVec3("pointLights[0].position", gPointLights[0].position);
-		(*gShaders)[gCurrentShaderIndex].SetVec4("pointLights[0].ambient", gPointLights[0].ambient);
-		(*gShaders)[gCurrentShaderIndex].SetVec4("pointLights[0].diffuse", gPointLights[0].diffuse);
-		(*gShaders)[gCurrentShaderIndex].SetVec4("pointLights[0].specular", gPointLights[0].specular);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("pointLights[0].position", gPointLights[0].position);
+		(*gShaders[gCurrentShaderIndex]).SetVec4("pointLights[0].ambient", gPointLights[0].ambient);
+		(*gShaders[gCurrentShaderIndex]).SetVec4("pointLights[0].diffuse", gPointLights[0].diffuse);
+		(*gShaders[gCurrentShaderIndex]).SetVec4("pointLights[0].specular", gPointLights[0].specular);
 		//Set point light attenuation factors
-		(*gShaders)[gCurrentShaderIndex].SetFloat("pointLights[0].constant", 1.0f);
-		(*gShaders)[gCurrentShaderIndex].SetFloat("pointLights[0].linear", 0.14f);
-		(*gShaders)[gCurrentShaderIndex].SetFloat("pointLights[0].quadratic", 0.07f);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("pointLights[0].constant", 1.0f);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("pointLights[0].linear", 0.14f);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("pointLights[0].quadratic", 0.07f);
 
 		//Set point light world position uniform
-		(*gShaders)[gCurrentShaderIndex].SetVec3("pointLightsWorld[0].position", gPointLights[0].position);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("pointLightsWorld[0].position", gPointLights[0].position);
 
 		//Set material shininess
-		(*gShaders)[gCurrentShaderIndex].SetFloat("material.shininess", 32.0f);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("material.shininess", 32.0f);
 
 		//Set the far plane distance for point light shadow mapping
-		(*gShaders)[gCurrentShaderIndex].SetFloat("far_plane", gPointLightShadowFarPlane);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("far_plane", gPointLightShadowFarPlane);
 	}
 
 	//Change to the framebuffer shader and set the texture uniform
 	changeShader(0);
-	(*gShaders)[gCurrentShaderIndex].SetInt("screenTexture", 0);
+	(*gShaders[gCurrentShaderIndex]).SetInt("screenTexture", 0);
 
 	//Change to the depth map shader and set the depth map texture uniform
 	changeShader(12);
-	(*gShaders)[gCurrentShaderIndex].SetInt("depthMap", 0);
+	(*gShaders[gCurrentShaderIndex]).SetInt("depthMap", 0);
+}
 
-	KJK_INFO("Loaded media!");
+//Add the instance matrices to the asteroid meshes
+void setupAsteroidInstancing()
+{
+	//The attribute pointers refer to the bound buffer
+	glBindBuffer(GL_ARRAY_BUFFER, gAsteroidInstanceVBO);
 
-	//Return the success flag
-	return success;
+	//Configure the vertex attributes for each asteroid mesh
+	for (GLuint i = 0; i < gAsteroidModel->GetMeshes().size(); i++)
+	{
+		//Get a vertex array object id for the model mesh
+		GLuint vao = gAsteroidModel->GetMeshes()[i].GetVAO();
+		//Bind the vertex array
+		KJK::GLStateCache::BindVertexArray(vao);
+
+		//Update the vertex attributes with the information about the model matrices
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)0);
+		glEnableVertexAttribArray(4);
+		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(1 * sizeof(glm::vec4)));
+		glEnableVertexAttribArray(5);
+		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(2 * sizeof(glm::vec4)));
+		glEnableVertexAttribArray(6);
+		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(3 * sizeof(glm::vec4)));
+
+		//Tell OpenGl when to update the context of the vertex attribute
+		glVertexAttribDivisor(3, 1);
+		glVertexAttribDivisor(4, 1);
+		glVertexAttribDivisor(5, 1);
+		glVertexAttribDivisor(6, 1);
+
+		//Unbind the vertex array
+		KJK::GLStateCache::BindVertexArray(0);
+	}
 }
 
 //Cleans up and closes SDL and all used objects
 void close()
 {
+	//Wait for the running reloads before deleting the assets
+	delete gAssetReloader;
+	gAssetReloader = nullptr;
+	KJK::FileWatcher::Shutdown();
+
 	//Delete the camera
 	delete gCamera;
 
@@ -1220,65 +1674,120 @@ void close()
 	//Delete the refractive cube model
 	delete gRefractiveCubeModel;
 
+	//Delete the shader programs while the context still exists
+	gShaders.fill(nullptr);
+	delete gShaderVariants;
+	gShaderVariants = nullptr;
+
 	//Delete the screen quad VAO and VBO
-	glDeleteVertexArrays(1, &gScreenQuadVAO);
+	KJK::GLStateCache::DeleteVertexArray(gScreenQuadVAO);
 	glDeleteBuffers(1, &gScreenQuadVBO);
 
 	//Delete the renderbuffer objects
 	glDeleteRenderbuffers(1, &gRBO);
 	glDeleteRenderbuffers(1, &gMultisampleRBO);
+	glDeleteRenderbuffers(1, &gPresentRBO);
 
 	//Delete the textures used for the framebuffers
-	glDeleteTextures(1, &gFBOTexture);
-	glDeleteTextures(1, &gMultisampleFBOTexture);
+	KJK::GLStateCache::DeleteTexture(gFBOTexture);
+	KJK::GLStateCache::DeleteTexture(gMultisampleFBOTexture);
 
 	//Delete the framebuffer objects
-	glDeleteFramebuffers(1, &gFBO);
-	glDeleteFramebuffers(1, &gMultisampleFBO);
+	KJK::GLStateCache::DeleteFramebuffer(gFBO);
+	KJK::GLStateCache::DeleteFramebuffer(gMultisampleFBO);
+	KJK::GLStateCache::DeleteFramebuffer(gPresentFBO);
 
 	//Delete the asteroid instance VBO
 	glDeleteBuffers(1, &gAsteroidInstanceVBO);
 
 	//Delete the shadow map texture and framebuffer
-	glDeleteTextures(1, &gShadowMapTexture);
-	glDeleteFramebuffers(1, &gShadowMapFBO);
+	KJK::GLStateCache::DeleteTexture(gShadowMapTexture);
+	KJK::GLStateCache::DeleteFramebuffer(gShadowMapFBO);
 
 	//Delete the cube shadow map texture and framebuffer
-	glDeleteTextures(1, &gPointLightShadowMapCubeTexture);
-	glDeleteFramebuffers(1, &gPointLightShadowMapFBO);
+	KJK::GLStateCache::DeleteTexture(gPointLightShadowMapCubeTexture);
+	KJK::GLStateCache::DeleteFramebuffer(gPointLightShadowMapFBO);
 
 	//Delete the UBO for matrices
 	glDeleteBuffers(1, &gMatricesUBO);
 
-	//Destroy window
-	if (gWindow != nullptr)
-	{
-		SDL_DestroyWindow(gWindow);
-		gWindow = nullptr;
-	}
+	//Forget the deleted objects in the memory tracker
+	for (GLuint buffer : { gScreenQuadVBO, gAsteroidInstanceVBO, gMatricesUBO })
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Buffer, buffer);
+	for (GLuint texture : { gFBOTexture, gMultisampleFBOTexture, gShadowMapTexture, gPointLightShadowMapCubeTexture })
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Texture, texture);
+	for (GLuint renderbuffer : { gRBO, gMultisampleRBO, gPresentRBO })
+		KJK::MemoryTracker::ReleaseGpuResource(KJK::GpuResourceType::Renderbuffer, renderbuffer);
+
+	//Delete the render pass timer queries
+	KJK::GpuProfiler::Shutdown();
+
+	//Stop storing program binaries
+	KJK::ProgramCache::Shutdown();
+
+	//Forget the tracked state of the context
+	KJK::GLStateCache::Shutdown();
+
+	//Destroy the ImGui backends
+	KJK::ImGuiRenderer::Shutdown();
+
+#ifdef KJK_PLAYGROUND_HEADLESS
+	//Destroy the offscreen OpenGL context
+	destroyHeadlessContext();
+#endif
+
+	//Destroy the window and its OpenGL context
+	delete gWindow;
+	gWindow = nullptr;
 
 	//Quit SDL subsystems
 	SDL_Quit();
 
+	//Stop the job system worker threads
+	KJK::JobSystem::Shutdown();
+
+	//Release the per frame memory arenas
+	KJK::FrameAllocator::Shutdown();
+
+	//Write out an unfinished profiler capture and release the profiler buffers
+	KJK::Profiler::Shutdown();
+
+	//Log the frame stats percentiles of the session
+	KJK::Stats::Shutdown();
+
+	//Log the memory per subsystem and the GPU resources that leaked
+	KJK::MemoryTracker::Shutdown();
+
 	KJK_INFO("Exited the application!");
+
+	//Write out the remaining binary trace records
+	KJK::BinaryTrace::Shutdown();
+
+	//Write out the remaining log messages
+	KJK::Logger::Shutdown();
 }
 
 //Change the shader program
 void changeShader(GLint index)
 {
-	if(gShaders.has_value() && index >= 0 && index < static_cast<GLint>(gShaders->size()))
+	if(index >= 0 && index < static_cast<GLint>(gShaders.size()) && gShaders[index] != nullptr)
 	{
 		gCurrentShaderIndex = index;
-		(*gShaders)[gCurrentShaderIndex].Use();
+
+		//Deferred builds are checked the first time their program is used
+		Shader& shader = *gShaders[gCurrentShaderIndex];
+		if (shader.IsPending())
+			shader.Finish();
+		shader.Use();
 	}
 }
 
 void recreateFramebuffers()
 {
 	//Recreate the framebuffer texture
-	glBindTexture(GL_TEXTURE_2D, gFBOTexture);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, gFBOTexture);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, SCREEN_WIDTH, SCREEN_HEIGHT, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
-	glBindTexture(GL_TEXTURE_2D, 0);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D, 0);
 
 	//Recreate the renderbuffer storage
 	glBindRenderbuffer(GL_RENDERBUFFER, gRBO);
@@ -1286,9 +1795,9 @@ void recreateFramebuffers()
 	glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
 	//Recreate the multisample framebuffer texture
-	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, gMultisampleFBOTexture);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D_MULTISAMPLE, gMultisampleFBOTexture);
 	glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, 4, GL_RGB, SCREEN_WIDTH, SCREEN_HEIGHT, GL_TRUE);
-	glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+	KJK::GLStateCache::BindTexture(0, GL_TEXTURE_2D_MULTISAMPLE, 0);
 
 	//Recreate the multisample renderbuffer storage
 	glBindRenderbuffer(GL_RENDERBUFFER, gMultisampleRBO);
@@ -1296,86 +1805,103 @@ void recreateFramebuffers()
 	glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
 	//Unbind any framebuffer
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	KJK::GLStateCache::BindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	//The screen sized attachments changed size
+	trackFramebufferMemory();
+}
+
+void trackFramebufferMemory()
+{
+	//Drivers pad RGB and 24 bit depth formats to 4 bytes per pixel
+	size_t screenBytes = KJK::MemoryTracker::EstimateTextureSize(SCREEN_WIDTH, SCREEN_HEIGHT, 4, false);
+	size_t multisampleBytes = KJK::MemoryTracker::EstimateTextureSize(SCREEN_WIDTH, SCREEN_HEIGHT, 4, false, 1, 4);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Texture, gFBOTexture, KJK::MemoryCategory::Framebuffers, screenBytes);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Renderbuffer, gRBO, KJK::MemoryCategory::Framebuffers, screenBytes);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Texture, gMultisampleFBOTexture, KJK::MemoryCategory::Framebuffers, multisampleBytes);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Renderbuffer, gMultisampleRBO, KJK::MemoryCategory::Framebuffers, multisampleBytes);
+
+	//Directional and point light shadow maps
+	size_t shadowBytes = KJK::MemoryTracker::EstimateTextureSize(SHADOW_WIDTH, SHADOW_HEIGHT, 4, false);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Texture, gShadowMapTexture, KJK::MemoryCategory::Framebuffers, shadowBytes);
+	KJK::MemoryTracker::TrackGpuResource(KJK::GpuResourceType::Texture, gPointLightShadowMapCubeTexture, KJK::MemoryCategory::Framebuffers, shadowBytes * 6);
 }
 
 //Render an example scene that showcases many OpenGL techniques.
 void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEnabled, glm::mat4 view, glm::mat4 projection, int shadowType)
 {
+	KJK_PROFILE_FUNCTION();
+
 	if(shadowType == 0)
 	{
 		//Enable the shader for the model
 		changeShader(1);
 		
 		//Bind the shadow map texture
-		glActiveTexture(GL_TEXTURE25);
-		glBindTexture(GL_TEXTURE_2D, gShadowMapTexture);
+		KJK::GLStateCache::BindTexture(25, GL_TEXTURE_2D, gShadowMapTexture);
 		//Load the shadow map texture uniform
-		(*gShaders)[gCurrentShaderIndex].SetInt("shadowMap", 25);
+		(*gShaders[gCurrentShaderIndex]).SetInt("shadowMap", 25);
 		//Load the light space matrix uniform
-		(*gShaders)[gCurrentShaderIndex].SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
 
 		//Bind the point light shadow map cube texture
-		glActiveTexture(GL_TEXTURE26);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
+		KJK::GLStateCache::BindTexture(26, GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
 		//Load the point light shadow map texture uniform
-		(*gShaders)[gCurrentShaderIndex].SetInt("shadowMapPoint", 26);
+		(*gShaders[gCurrentShaderIndex]).SetInt("shadowMapPoint", 26);
 
 		//Set the far plane distance uniform
-		(*gShaders)[gCurrentShaderIndex].SetFloat("far_plane", gPointLightShadowFarPlane);
+		(*gShaders[gCurrentShaderIndex]).SetFloat("far_plane", gPointLightShadowFarPlane);
 
 		//Update the spotlight position and direction uniforms
-		(*gShaders)[gCurrentShaderIndex].SetVec3("spotLight.position", gCamera->position);
-		(*gShaders)[gCurrentShaderIndex].SetVec3("spotLight.direction", gCamera->direction);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("spotLight.position", gCamera->position);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("spotLight.direction", gCamera->direction);
 
 		//Disable writing to the stencil buffer
-		glStencilMask(0x00);
+		KJK::GLStateCache::StencilMask(0x00);
 	}
 
 	//Render the plane
-	gPlaneModel->Draw((*gShaders)[gCurrentShaderIndex]);
+	gPlaneModel->Draw((*gShaders[gCurrentShaderIndex]));
 
 	if (shadowType == 0)
 	{
 		//Setup the stencil buffer operations for writing
-		glStencilFunc(GL_ALWAYS, 1, 0xFF);
-		glStencilMask(0xFF);
+		KJK::GLStateCache::StencilFunc(GL_ALWAYS, 1, 0xFF);
+		KJK::GLStateCache::StencilMask(0xFF);
 	}
 
 	//Render the cubes
 	for (int i = 0; i < 2; ++i)
 	{
-		gCubeModels[i].Draw((*gShaders)[gCurrentShaderIndex]);
+		gCubeModels[i].Draw((*gShaders[gCurrentShaderIndex]));
 	}
 
 	//Disable face culling
-	glDisable(GL_CULL_FACE);
+	KJK::GLStateCache::Disable(GL_CULL_FACE);
 
 	if (shadowType == 0)
 	{
 		//Disable writing to the stencil buffer
-		glStencilMask(0x00);
+		KJK::GLStateCache::StencilMask(0x00);
 
 		//Change the shader to use the explosion geometry effect
 		changeShader(8);
 
 		//Bind the shadow map texture
-		glActiveTexture(GL_TEXTURE25);
-		glBindTexture(GL_TEXTURE_2D, gShadowMapTexture);
+		KJK::GLStateCache::BindTexture(25, GL_TEXTURE_2D, gShadowMapTexture);
 		//Load the shadow map texture uniform
-		(*gShaders)[gCurrentShaderIndex].SetInt("shadowMap", 25);
+		(*gShaders[gCurrentShaderIndex]).SetInt("shadowMap", 25);
 		//Load the light space matrix uniform
-		(*gShaders)[gCurrentShaderIndex].SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
 
 		//Bind the point light shadow map cube texture
-		glActiveTexture(GL_TEXTURE26);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
+		KJK::GLStateCache::BindTexture(26, GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
 		//Load the point light shadow map texture uniform
-		(*gShaders)[gCurrentShaderIndex].SetInt("shadowMapPoint", 26);
+		(*gShaders[gCurrentShaderIndex]).SetInt("shadowMapPoint", 26);
 
 		//Update the spotlight position and direction uniforms
-		(*gShaders)[gCurrentShaderIndex].SetVec3("spotLight.position", gCamera->position);
-		(*gShaders)[gCurrentShaderIndex].SetVec3("spotLight.direction", gCamera->direction);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("spotLight.position", gCamera->position);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("spotLight.direction", gCamera->direction);
 	}
 	else if (shadowType == 1)
 	{
@@ -1383,7 +1909,7 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 		changeShader(15);
 
 		//Set the light space matrix uniform
-		(*gShaders)[gCurrentShaderIndex].SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
 	}
 	else if (shadowType == 2)
 	{
@@ -1392,7 +1918,7 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 	}
 
 	//Set the time uniform
-	(*gShaders)[gCurrentShaderIndex].SetFloat("time", timeValue / 4.0f);
+	(*gShaders[gCurrentShaderIndex]).SetFloat("time", timeValue / 4.0f);
 
 	//Set the model matrix for the detailed model
 	glm::mat4 model = glm::mat4(1.0f);
@@ -1401,9 +1927,9 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 	//Scale the model down
 	model = glm::scale(model, glm::vec3(0.2f));
 	//Set the model matrix uniform
-	(*gShaders)[gCurrentShaderIndex].SetMat4("model", model);
+	(*gShaders[gCurrentShaderIndex]).SetMat4("model", model);
 	//Render the detailed model
-	gModel->Draw((*gShaders)[gCurrentShaderIndex]);
+	gModel->Draw((*gShaders[gCurrentShaderIndex]));
 
 	if (shadowType == 0)
 	{
@@ -1413,9 +1939,9 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 			changeShader(9);
 
 			//Set the model matrix uniform
-			(*gShaders)[gCurrentShaderIndex].SetMat4("model", model);
+			(*gShaders[gCurrentShaderIndex]).SetMat4("model", model);
 			//Render the detailed model
-			gModel->Draw((*gShaders)[gCurrentShaderIndex]);
+			gModel->Draw((*gShaders[gCurrentShaderIndex]));
 		}
 
 		//Change the shader for the reflective cube
@@ -1433,10 +1959,10 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 	}
 
 	//Re-enable face culling
-	glEnable(GL_CULL_FACE);
+	KJK::GLStateCache::Enable(GL_CULL_FACE);
 
 	//Render the reflective cube
-	gReflectiveCubeModel->Draw((*gShaders)[gCurrentShaderIndex]);
+	gReflectiveCubeModel->Draw((*gShaders[gCurrentShaderIndex]));
 
 	if (shadowType == 0)
 	{
@@ -1445,31 +1971,31 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 	}
 
 	//Render the refractive cube
-	gRefractiveCubeModel->Draw((*gShaders)[gCurrentShaderIndex]);
+	gRefractiveCubeModel->Draw((*gShaders[gCurrentShaderIndex]));
 
 	//Disable face culling
-	glDisable(GL_CULL_FACE);
+	KJK::GLStateCache::Disable(GL_CULL_FACE);
 
 	if (shadowType == 0)
 	{
 		//Change the depth function to allow skybox depth values to pass
-		glDepthFunc(GL_LEQUAL);
+		KJK::GLStateCache::DepthFunc(GL_LEQUAL);
 		//Disable writing to the depth buffer
-		glDepthMask(GL_FALSE);
+		KJK::GLStateCache::DepthMask(false);
 
 		//Use the skybox shader
 		changeShader(5);
 
 		//Set the view and projection matrices for the skybox
 		glm::mat4 skyboxView = glm::mat4(glm::mat3(view)); //Remove translation from the view matrix
-		(*gShaders)[gCurrentShaderIndex].SetMat4("view", skyboxView);
-		(*gShaders)[gCurrentShaderIndex].SetMat4("projection", projection);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("view", skyboxView);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("projection", projection);
 
 		//Render the skybox cube
-		gSkyboxCube->Draw((*gShaders)[gCurrentShaderIndex]);
+		gSkyboxCube->Draw((*gShaders[gCurrentShaderIndex]));
 
 		//Reset the depth function
-		glDepthFunc(GL_LESS);
+		KJK::GLStateCache::DepthFunc(GL_LESS);
 
 		//Use the main shader
 		changeShader(1);
@@ -1480,7 +2006,7 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 		changeShader(14);
 
 		//Set the light space matrix uniform
-		(*gShaders)[gCurrentShaderIndex].SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
 	}
 	else if (shadowType == 2)
 	{
@@ -1488,8 +2014,8 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 		changeShader(17);
 	}
 
-	//Create a sorted map of the glass planes based on distance from the camera
-	std::map<float, PlaneModel*> sorted;
+	//Create a sorted map of the glass planes based on distance from the camera, kept in frame memory
+	KJK::FrameMap<float, PlaneModel*> sorted;
 	for (GLuint i = 0; i < 5; ++i)
 	{
 		float distance = glm::length(gCamera->position - gGlassPlaneModels[i].getPosition());
@@ -1499,27 +2025,27 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 	//Render the glass planes in back-to-front order
 	for (auto it = sorted.rbegin(); it != sorted.rend(); ++it)
 	{
-		it->second->Draw((*gShaders)[gCurrentShaderIndex]);
+		it->second->Draw((*gShaders[gCurrentShaderIndex]));
 	}
 
 	//Re-enable face culling
-	glEnable(GL_CULL_FACE);
+	KJK::GLStateCache::Enable(GL_CULL_FACE);
 
 	if (shadowType == 0)
 	{
 		//Re-enable writing to the depth buffer
-		glDepthMask(GL_TRUE);
+		KJK::GLStateCache::DepthMask(true);
 
 		//Draw an outline effect around the cubes
 		if (outlineEffectEnabled)
 		{
 			//Setup the stencil buffer operations for the outline effect
-			glStencilFunc(GL_NOTEQUAL, 1, 0xFF);
+			KJK::GLStateCache::StencilFunc(GL_NOTEQUAL, 1, 0xFF);
 			//Disable writing to the stencil buffer
-			glStencilMask(0x00);
+			KJK::GLStateCache::StencilMask(0x00);
 
 			//Disable the depth buffer operations
-			glDisable(GL_DEPTH_TEST);
+			KJK::GLStateCache::Disable(GL_DEPTH_TEST);
 
 			//Use the border shader
 			changeShader(4);
@@ -1534,18 +2060,18 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 				gCubeModels[i].setScale(originalScale * 1.1f);
 
 				//Draw the cube
-				gCubeModels[i].Draw((*gShaders)[gCurrentShaderIndex]);
+				gCubeModels[i].Draw((*gShaders[gCurrentShaderIndex]));
 
 				//Restore the original scale
 				gCubeModels[i].setScale(originalScale);
 			}
 
 			//Re-enable depth buffer writing
-			glEnable(GL_DEPTH_TEST);
+			KJK::GLStateCache::Enable(GL_DEPTH_TEST);
 
 			//Reset the stencil buffer settings
-			glStencilMask(0xFF);
-			glStencilFunc(GL_ALWAYS, 1, 0xFF);
+			KJK::GLStateCache::StencilMask(0xFF);
+			KJK::GLStateCache::StencilFunc(GL_ALWAYS, 1, 0xFF);
 
 			//Change the shader back to the main shader
 			changeShader(1);
@@ -1555,32 +2081,32 @@ void renderExampleScene(float timeValue, bool showNormals, bool outlineEffectEna
 
 void renderSpaceScene(float timeValue, glm::mat4 view, glm::mat4 projection, int shadowType)
 {
+	KJK_PROFILE_FUNCTION();
+
 	if (shadowType == 0)
 	{
 		//Enable the default shader
 		changeShader(1);
 
 		//Ensure the stencil buffer is configured to always pass
-		glStencilFunc(GL_ALWAYS, 1, 0xFF);
-		glStencilMask(0xFF);
+		KJK::GLStateCache::StencilFunc(GL_ALWAYS, 1, 0xFF);
+		KJK::GLStateCache::StencilMask(0xFF);
 
 		//Bind the shadow map texture
-		glActiveTexture(GL_TEXTURE25);
-		glBindTexture(GL_TEXTURE_2D, gShadowMapTexture);
+		KJK::GLStateCache::BindTexture(25, GL_TEXTURE_2D, gShadowMapTexture);
 		//Load the shadow map texture uniform
-		(*gShaders)[gCurrentShaderIndex].SetInt("shadowMap", 25);
+		(*gShaders[gCurrentShaderIndex]).SetInt("shadowMap", 25);
 		//Load the light space matrix uniform
-		(*gShaders)[gCurrentShaderIndex].SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
 
 		//Bind the point light shadow map cube texture
-		glActiveTexture(GL_TEXTURE26);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
+		KJK::GLStateCache::BindTexture(26, GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
 		//Load the point light shadow map texture uniform
-		(*gShaders)[gCurrentShaderIndex].SetInt("shadowMapPoint", 26);
+		(*gShaders[gCurrentShaderIndex]).SetInt("shadowMapPoint", 26);
 
 		//Update the spotlight position and direction uniforms
-		(*gShaders)[gCurrentShaderIndex].SetVec3("spotLight.position", gCamera->position);
-		(*gShaders)[gCurrentShaderIndex].SetVec3("spotLight.direction", gCamera->direction);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("spotLight.position", gCamera->position);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("spotLight.direction", gCamera->direction);
 	}
 
 	//Declare the model matrix for the planet
@@ -1590,10 +2116,10 @@ void renderSpaceScene(float timeValue, glm::mat4 view, glm::mat4 projection, int
 	model = glm::scale(model, glm::vec3(4.0f));
 
 	//Set the model matrix uniform
-	(*gShaders)[gCurrentShaderIndex].SetMat4("model", model);
+	(*gShaders[gCurrentShaderIndex]).SetMat4("model", model);
 
 	//Render the planet model
-	gPlanetModel->Draw((*gShaders)[gCurrentShaderIndex]);
+	gPlanetModel->Draw((*gShaders[gCurrentShaderIndex]));
 
 	if (shadowType == 0)
 	{
@@ -1601,22 +2127,20 @@ void renderSpaceScene(float timeValue, glm::mat4 view, glm::mat4 projection, int
 		changeShader(10);
 
 		//Update the spotlight position and direction uniforms for instance shader
-		(*gShaders)[gCurrentShaderIndex].SetVec3("spotLight.position", gCamera->position);
-		(*gShaders)[gCurrentShaderIndex].SetVec3("spotLight.direction", gCamera->direction);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("spotLight.position", gCamera->position);
+		(*gShaders[gCurrentShaderIndex]).SetVec3("spotLight.direction", gCamera->direction);
 
 		//Bind the shadow map texture
-		glActiveTexture(GL_TEXTURE25);
-		glBindTexture(GL_TEXTURE_2D, gShadowMapTexture);
+		KJK::GLStateCache::BindTexture(25, GL_TEXTURE_2D, gShadowMapTexture);
 		//Load the shadow map texture uniform
-		(*gShaders)[gCurrentShaderIndex].SetInt("shadowMap", 25);
+		(*gShaders[gCurrentShaderIndex]).SetInt("shadowMap", 25);
 		//Load the light space matrix uniform
-		(*gShaders)[gCurrentShaderIndex].SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
 
 		//Bind the point light shadow map cube texture
-		glActiveTexture(GL_TEXTURE26);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
+		KJK::GLStateCache::BindTexture(26, GL_TEXTURE_CUBE_MAP, gPointLightShadowMapCubeTexture);
 		//Load the point light shadow map texture uniform
-		(*gShaders)[gCurrentShaderIndex].SetInt("shadowMapPoint", 26);
+		(*gShaders[gCurrentShaderIndex]).SetInt("shadowMapPoint", 26);
 	}
 	else if (shadowType == 1)
 	{
@@ -1624,7 +2148,7 @@ void renderSpaceScene(float timeValue, glm::mat4 view, glm::mat4 projection, int
 		changeShader(13);
 
 		//Set the light space matrix uniform
-		(*gShaders)[gCurrentShaderIndex].SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
+		(*gShaders[gCurrentShaderIndex]).SetMat4("lightSpaceMatrix", gLightSpaceMatrix);
 	}
 	else if (shadowType == 2)
 	{
@@ -1641,26 +2165,24 @@ void renderSpaceScene(float timeValue, glm::mat4 view, glm::mat4 projection, int
 		const auto& textures = gAsteroidModel->GetMeshes()[i].textures;
 		for (unsigned int j = 0; j < textures.size(); j++)
 		{
-			glActiveTexture(GL_TEXTURE0 + j);
-			std::string number;
-			std::string name = textures[j].type;
+			const std::string& name = textures[j].type;
+			KJK::FrameString uniformName(name.data(), name.size());
 			if (name == "texture_diffuse")
-				number = std::to_string(diffuseNr++);
+				uniformName += std::to_string(diffuseNr++);
 			else if (name == "texture_specular")
-				number = std::to_string(specularNr++);
+				uniformName += std::to_string(specularNr++);
 
-			(*gShaders)[gCurrentShaderIndex].SetInt((name + number).c_str(), j);
-			glBindTexture(GL_TEXTURE_2D, textures[j].id);
+			(*gShaders[gCurrentShaderIndex]).SetInt(uniformName.c_str(), j);
+			KJK::GLStateCache::BindTexture(j, GL_TEXTURE_2D, textures[j].id);
+			KJK_STAT_ADD("Texture binds", 1);
 		}
-		glActiveTexture(GL_TEXTURE0);
 
 		//Bind the rock mesh VAO
-		glBindVertexArray(gAsteroidModel->GetMeshes()[i].GetVAO());
+		KJK::GLStateCache::BindVertexArray(gAsteroidModel->GetMeshes()[i].GetVAO());
 
 		//Draw the asteroid model
 		glDrawElementsInstanced(GL_TRIANGLES, gAsteroidModel->GetMeshes()[i].indices.size(), GL_UNSIGNED_INT, 0, gAsteroidInstanceAmount);
+		KJK_STAT_ADD("Draw calls", 1);
+		KJK_STAT_ADD("Triangles", gAsteroidModel->GetMeshes()[i].indices.size() / 3 * gAsteroidInstanceAmount);
 	}
-
-	//Unbind the VAO
-	glBindVertexArray(0);
 }
@@ -0,0 +1,195 @@
+#include <KJK_Engine/Core/BinaryTrace.h>
+
+#include <fmt/args.h>
+#include <fmt/format.h>
+
+//Format of a call site read from the trace file
+struct TraceFormat
+{
+	std::string ArgTypes;
+	std::string Format;
+	std::string File;
+	uint32_t Line = 0;
+};
+
+//Record read from the trace file, the payload points into the record block it came from
+struct TraceRecord
+{
+	uint64_t TimestampNs;
+	uint32_t FormatId;
+	uint32_t ThreadIndex;
+	const std::byte* Payload;
+	uint32_t PayloadSize;
+};
+
+//Helpers for reading the trace file
+static bool ReadU32(std::istream& stream, uint32_t& value)
+{
+	return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+static bool ReadU64(std::istream& stream, uint64_t& value)
+{
+	return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+static bool ReadString(std::istream& stream, std::string& value)
+{
+	uint32_t length;
+	if (!ReadU32(stream, length))
+		return false;
+
+	value.resize(length);
+	return static_cast<bool>(stream.read(value.data(), length));
+}
+
+//Read a raw argument from the payload
+template<typename T>
+static T ReadArg(const std::byte*& payload)
+{
+	T value;
+	std::memcpy(&value, payload, sizeof(T));
+	payload += sizeof(T);
+	return value;
+}
+
+//Format a record with the format string of its call site
+static std::string FormatRecord(const TraceFormat& format, const TraceRecord& record)
+{
+	fmt::dynamic_format_arg_store<fmt::format_context> args;
+	const std::byte* payload = record.Payload;
+	const std::byte* payloadEnd = record.Payload + record.PayloadSize;
+
+	for (char type : format.ArgTypes)
+	{
+		//Every argument takes at least one byte, stop on truncated records
+		if (payload >= payloadEnd)
+			break;
+
+		switch (type)
+		{
+		case KJK::BinaryTraceFormat::SignedArg: args.push_back(ReadArg<int64_t>(payload)); break;
+		case KJK::BinaryTraceFormat::UnsignedArg: args.push_back(ReadArg<uint64_t>(payload)); break;
+		case KJK::BinaryTraceFormat::FloatArg: args.push_back(ReadArg<float>(payload)); break;
+		case KJK::BinaryTraceFormat::DoubleArg: args.push_back(ReadArg<double>(payload)); break;
+		case KJK::BinaryTraceFormat::BoolArg: args.push_back(ReadArg<uint8_t>(payload) != 0); break;
+		case KJK::BinaryTraceFormat::CharArg: args.push_back(ReadArg<char>(payload)); break;
+		case KJK::BinaryTraceFormat::PointerArg: args.push_back(fmt::format("0x{:x}", ReadArg<uint64_t>(payload))); break;
+		default: return fmt::format("<unknown argument type '{}'> {}", type, format.Format);
+		}
+	}
+
+	try
+	{
+		return fmt::vformat(format.Format, args);
+	}
+	catch (const fmt::format_error& error)
+	{
+		return fmt::format("<{}> {}", error.what(), format.Format);
+	}
+}
+
+//Decode a binary trace file written by KJK::BinaryTrace into text, ordered by time
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: TraceDecoderApp <trace file> [output file]" << std::endl;
+		return 1;
+	}
+
+	std::ifstream input(argv[1], std::ios::binary);
+	if (!input)
+	{
+		std::cerr << "Failed to open the trace file " << argv[1] << std::endl;
+		return 1;
+	}
+
+	//Check the file header
+	char magic[sizeof(KJK::BinaryTraceFormat::Magic)];
+	uint32_t version = 0;
+	if (!input.read(magic, sizeof(magic)) || std::memcmp(magic, KJK::BinaryTraceFormat::Magic, sizeof(magic)) != 0 || !ReadU32(input, version) || version != KJK::BinaryTraceFormat::Version)
+	{
+		std::cerr << argv[1] << " is not a supported binary trace file" << std::endl;
+		return 1;
+	}
+
+	//Read all blocks, record blocks stay in memory until the records are formatted
+	std::unordered_map<uint32_t, TraceFormat> formats;
+	std::vector<std::unique_ptr<std::byte[]>> blocks;
+	std::vector<TraceRecord> records;
+	uint32_t blockType;
+	while (ReadU32(input, blockType))
+	{
+		if (blockType == KJK::BinaryTraceFormat::FormatBlock)
+		{
+			uint32_t id;
+			TraceFormat format;
+			if (!ReadU32(input, id) || !ReadString(input, format.ArgTypes) || !ReadString(input, format.Format) || !ReadString(input, format.File) || !ReadU32(input, format.Line))
+				break;
+
+			formats[id] = std::move(format);
+		}
+		else if (blockType == KJK::BinaryTraceFormat::RecordBlock)
+		{
+			uint32_t threadIndex;
+			uint64_t size;
+			if (!ReadU32(input, threadIndex) || !ReadU64(input, size))
+				break;
+
+			auto block = std::make_unique<std::byte[]>(size);
+			if (!input.read(reinterpret_cast<char*>(block.get()), size))
+				break;
+
+			//Split the block into records
+			size_t offset = 0;
+			while (offset + sizeof(KJK::BinaryTraceFormat::RecordHeader) <= size)
+			{
+				KJK::BinaryTraceFormat::RecordHeader header;
+				std::memcpy(&header, block.get() + offset, sizeof(header));
+				offset += sizeof(header);
+				if (offset + header.PayloadSize > size)
+					break;
+
+				records.push_back({ header.TimestampNs, header.FormatId, threadIndex, block.get() + offset, header.PayloadSize });
+				offset += header.PayloadSize;
+			}
+
+			blocks.push_back(std::move(block));
+		}
+		else
+		{
+			std::cerr << "Unknown block type " << blockType << ", the trace file is corrupted" << std::endl;
+			break;
+		}
+	}
+
+	//Merge the records of all threads by time
+	std::stable_sort(records.begin(), records.end(), [](const TraceRecord& a, const TraceRecord& b)
+	{
+		return a.TimestampNs < b.TimestampNs;
+	});
+
+	std::ofstream outputFile;
+	if (argc > 2)
+		outputFile.open(argv[2]);
+	std::ostream& output = argc > 2 ? outputFile : std::cout;
+
+	uint64_t startNs = records.empty() ? 0 : records.front().TimestampNs;
+	for (const TraceRecord& record : records)
+	{
+		auto format = formats.find(record.FormatId);
+		double timeMs = static_cast<double>(record.TimestampNs - startNs) / 1000000.0;
+
+		if (format == formats.end())
+		{
+			output << fmt::format("[{:.6f} ms][thread {}] <unknown format {}>\n", timeMs, record.ThreadIndex, record.FormatId);
+			continue;
+		}
+
+		output << fmt::format("[{:.6f} ms][thread {}] {} [{}:{}]\n", timeMs, record.ThreadIndex, FormatRecord(format->second, record), format->second.File, format->second.Line);
+	}
+
+	std::cerr << "Decoded " << records.size() << " records" << std::endl;
+	return 0;
+}